@@ -0,0 +1,179 @@
+// MicroBench.cpp
+#include "MicroBench.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using Clock = std::chrono::steady_clock;
+
+static double timeRun(const MicroBench::Body& body, int64_t n) {
+    auto t0 = Clock::now();
+    body(n);
+    auto t1 = Clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+std::vector<BenchResult> MicroBench::run(const std::string& filter) const
+{
+    std::vector<BenchResult> out;
+    std::printf("%-40s %12s %12s %12s %12s\n", "benchmark", "iters", "ns/op(med)", "min", "max");
+
+    for (const Entry& e : benches_) {
+        if (!filter.empty() && e.name.find(filter) == std::string::npos) continue;
+
+        // 1) 워밍업 겸 n 결정: 1회 측정이 minTime의 1/10을 넘을 때까지 n을 키움
+        int64_t n = 1;
+        double sec = timeRun(e.body, n);
+        while (sec < minTimeSec_ * 0.1 && n < (int64_t(1) << 40)) {
+            double scale = sec > 0.0 ? std::min(10.0, std::max(2.0, minTimeSec_ * 0.15 / sec)) : 10.0;
+            n = (int64_t)(n * scale) + 1;
+            sec = timeRun(e.body, n);
+        }
+        // minTime 한 번에 맞게 n 보정
+        n = std::max<int64_t>(1, (int64_t)(n * (minTimeSec_ / std::max(sec, 1e-9))));
+
+        // 2) 반복 측정
+        std::vector<double> ns;
+        for (int r = 0; r < repetitions_; ++r)
+            ns.push_back(timeRun(e.body, n) * 1e9 / (double)n);
+        std::sort(ns.begin(), ns.end());
+
+        BenchResult res;
+        res.name = e.name;
+        res.iters = n;
+        res.nsMedian = ns[ns.size() / 2];
+        res.nsMin = ns.front();
+        res.nsMax = ns.back();
+        std::printf("%-40s %12lld %12.1f %12.1f %12.1f\n", res.name.c_str(), (long long)res.iters,
+            res.nsMedian, res.nsMin, res.nsMax);
+        std::fflush(stdout);
+        out.push_back(res);
+    }
+    return out;
+}
+
+bool MicroBench::saveJson(const std::string& path, const std::vector<BenchResult>& results)
+{
+    cv::FileStorage fs(path, cv::FileStorage::WRITE | cv::FileStorage::FORMAT_JSON);
+    if (!fs.isOpened()) return false;
+    fs << "opencv" << CV_VERSION;
+    fs << "threads" << cv::getNumThreads();
+    fs << "benchmarks" << "[";
+    for (const BenchResult& r : results) {
+        fs << "{" << "name" << r.name
+            << "iters" << (double)r.iters        // FileStorage 정수는 32비트라 double로 저장
+            << "ns_median" << r.nsMedian
+            << "ns_min" << r.nsMin
+            << "ns_max" << r.nsMax << "}";
+    }
+    fs << "]";
+    return true;
+}
+
+bool MicroBench::loadJson(const std::string& path, std::vector<BenchResult>& results)
+{
+    cv::FileStorage fs(path, cv::FileStorage::READ | cv::FileStorage::FORMAT_JSON);
+    if (!fs.isOpened()) return false;
+    cv::FileNode arr = fs["benchmarks"];
+    if (!arr.isSeq()) return false;
+
+    results.clear();
+    for (cv::FileNodeIterator it = arr.begin(); it != arr.end(); ++it) {
+        cv::FileNode node = *it;
+        BenchResult r;
+        r.name = (std::string)node["name"];
+        r.iters = (int64_t)(double)node["iters"];
+        r.nsMedian = (double)node["ns_median"];
+        r.nsMin = (double)node["ns_min"];
+        r.nsMax = (double)node["ns_max"];
+        if (!r.name.empty()) results.push_back(r);
+    }
+    return true;
+}
+
+int MicroBench::compare(const std::vector<BenchResult>& baseline,
+    const std::vector<BenchResult>& current, double threshold, const std::string& filter, int* missing)
+{
+    int regressions = 0;
+    std::printf("\n%-40s %12s %12s %9s\n", "benchmark", "base ns", "now ns", "change");
+    for (const BenchResult& cur : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(),
+            [&](const BenchResult& b) { return b.name == cur.name; });
+        if (it == baseline.end() || it->nsMedian <= 0.0) {
+            std::printf("%-40s %12s %12.1f %9s\n", cur.name.c_str(), "-", cur.nsMedian, "new");
+            continue;
+        }
+        double change = cur.nsMedian / it->nsMedian - 1.0;
+        bool bad = change > threshold;
+        if (bad) ++regressions;
+        std::printf("%-40s %12.1f %12.1f %+8.1f%%%s\n", cur.name.c_str(), it->nsMedian, cur.nsMedian,
+            change * 100.0, bad ? "  REGRESSION" : "");
+    }
+
+    // 기준선에만 있는 벤치: 조용히 넘어가면 이름만 바꿔도 게이트를 통과함
+    int gone = 0;
+    for (const BenchResult& base : baseline) {
+        if (!filter.empty() && base.name.find(filter) == std::string::npos) continue;
+        auto it = std::find_if(current.begin(), current.end(),
+            [&](const BenchResult& c) { return c.name == base.name; });
+        if (it != current.end()) continue;
+        ++gone;
+        std::printf("%-40s %12.1f %12s %9s\n", base.name.c_str(), base.nsMedian, "-", "missing");
+    }
+    if (missing) *missing = gone;
+    return regressions;
+}
+
+bool MicroBench::parseArgs(int argc, char** argv, const ExtraArg& extra)
+{
+    for (int i = 1; i < argc; ++i) {
+        auto next = [&](void) -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        if (!std::strcmp(argv[i], "--filter")) filter_ = next();
+        else if (!std::strcmp(argv[i], "--min-time")) minTimeSec_ = std::atof(next());
+        else if (!std::strcmp(argv[i], "--reps")) repetitions_ = std::max(1, std::atoi(next()));
+        else if (!std::strcmp(argv[i], "--save-baseline")) savePath_ = next();
+        else if (!std::strcmp(argv[i], "--baseline")) basePath_ = next();
+        else if (!std::strcmp(argv[i], "--threshold")) threshold_ = std::atof(next());
+        else {
+            const BenchArg r = extra ? extra(argv[i], next) : BenchArg::Unknown;
+            if (r == BenchArg::Failed) return false;
+            if (r == BenchArg::Unknown) {
+                std::fprintf(stderr, "unknown option %s\n", argv[i]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int MicroBench::runMain(const char* unit, std::vector<BenchResult>* out) const
+{
+    std::vector<BenchResult> results = run(filter_);
+    if (out) *out = results;
+
+    if (!savePath_.empty()) {
+        if (!saveJson(savePath_, results)) {
+            std::fprintf(stderr, "cannot write baseline %s\n", savePath_.c_str());
+            return 2;
+        }
+        std::printf("\nbaseline saved: %s\n", savePath_.c_str());
+    }
+    if (!basePath_.empty()) {
+        std::vector<BenchResult> baseline;
+        if (!loadJson(basePath_, baseline)) {
+            std::fprintf(stderr, "cannot read baseline %s\n", basePath_.c_str());
+            return 2;
+        }
+        int missing = 0;
+        int bad = compare(baseline, results, threshold_, filter_, &missing);
+        std::printf("\n%d %s slower than baseline by more than %.0f%%\n", bad, unit, threshold_ * 100.0);
+        // --filter로 일부만 돌렸으면 빠진 항목은 보고만 (필터에 걸린 이름이라도 실패로 세지 않음)
+        if (missing > 0)
+            std::printf("%d %s in baseline but not run%s\n", missing, unit, filter_.empty() ? "" : " (ignored: --filter)");
+        if (filter_.empty()) bad += missing;
+        return bad > 0 ? 1 : 0;
+    }
+    return 0;
+}
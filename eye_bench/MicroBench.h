@@ -0,0 +1,81 @@
+// MicroBench.h
+// 작은 마이크로벤치 하네스 (Google Benchmark 방식: 본문이 n회 루프를 직접 돌고, n은 최소 측정 시간에 맞춰 자동 결정)
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 컴파일러가 결과를 안 쓰는 계산을 지우지 못하게 막음
+template <class T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    // 포인터 자체가 volatile이어야 저장을 못 지움 (volatile const void*는 가리키는 쪽만 volatile)
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+struct BenchResult {
+    std::string name;
+    int64_t iters = 0;       // 반복 1회당 n
+    double nsMedian = 0.0;   // 반복들의 ns/op 중앙값 (비교 기준)
+    double nsMin = 0.0;
+    double nsMax = 0.0;
+};
+
+// 도구별 추가 옵션 처리 결과 (MicroBench::parseArgs의 extra 콜백)
+enum class BenchArg { Handled, Unknown, Failed };
+
+/**
+ * @class MicroBench
+ * @brief 단계별 벤치를 등록해 돌리고, JSON 기준선으로 저장/비교합니다.
+ * 각 벤치는 minTime에 맞춰 n을 정한 뒤 repetitions번 측정해 ns/op 중앙값을 씁니다.
+ * 벤치 도구의 main은 parseArgs -> add... -> runMain 순서로 씁니다.
+ */
+class MicroBench {
+public:
+    using Body = std::function<void(int64_t n)>;
+    // opt = 옵션 이름, next() = 다음 인자 (없으면 "")
+    using ExtraArg = std::function<BenchArg(const char* opt, const std::function<const char*()>& next)>;
+
+    MicroBench(double minTimeSec = 0.1, int repetitions = 5)
+        : minTimeSec_(minTimeSec), repetitions_(repetitions) {}
+
+    void add(const std::string& name, Body body) { benches_.push_back({ name, std::move(body) }); }
+
+    // filter가 비어 있지 않으면 이름에 filter가 들어간 벤치만 실행. 진행 상황은 stdout
+    std::vector<BenchResult> run(const std::string& filter = std::string()) const;
+
+    // 공통 옵션: --filter str --min-time sec --reps N --save-baseline f --baseline f --threshold x
+    // 그 밖의 옵션은 extra에 넘김. 모르는 옵션이나 extra 실패면 false (main은 종료 코드 2)
+    bool parseArgs(int argc, char** argv, const ExtraArg& extra = ExtraArg());
+    // run(filter) + --save-baseline 저장 + --baseline 비교. 반환값은 main의 종료 코드:
+    // 0 = 통과, 1 = 기준선보다 threshold 넘게 느려졌거나 기준선에 있는데 이번에 없는 벤치 있음,
+    // 2 = 기준선 파일 읽기/쓰기 실패
+    // results가 있으면 측정 결과를 복사해 줌 (도구별 요약 출력용)
+    int runMain(const char* unit = "benchmark(s)", std::vector<BenchResult>* results = nullptr) const;
+
+    // {"benchmarks": [{name, iters, ns_median, ns_min, ns_max}, ...]} 형식 (cv::FileStorage JSON)
+    static bool saveJson(const std::string& path, const std::vector<BenchResult>& results);
+    static bool loadJson(const std::string& path, std::vector<BenchResult>& results);
+
+    // 기준선 대비 중앙값이 (1 + threshold)배를 넘으면 회귀. 표를 출력하고 회귀 개수 반환
+    // 기준선에만 있는 벤치(이름 변경/삭제)는 missing 행으로 출력하고 missing에 개수를 넣음.
+    // filter가 있으면 거기 안 걸리는 기준선 항목은 원래 안 돌린 것이라 무시
+    static int compare(const std::vector<BenchResult>& baseline,
+        const std::vector<BenchResult>& current, double threshold,
+        const std::string& filter = std::string(), int* missing = nullptr);
+
+private:
+    struct Entry { std::string name; Body body; };
+
+    double minTimeSec_;
+    int repetitions_;
+    std::string filter_, savePath_, basePath_;
+    double threshold_ = 0.15;
+    std::vector<Entry> benches_;
+};
@@ -0,0 +1,167 @@
+// SyntheticEye.cpp
+#include "SyntheticEye.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace cv;
+
+static const int SS = 8;   // 슈퍼샘플링 배율
+static const int kIris = 92, kPupil = 22;   // 홍채/동공 밝기
+
+// ROI 좌표(픽셀 중심 = 정수) -> 캔버스 좌표. INTER_AREA 축소에서 출력 픽셀 j는 캔버스 [j*SS, j*SS+SS) 평균이라
+// 그 중심은 (j + 0.5) * SS - 0.5. 그냥 v * SS로 그리면 결과가 (SS - 1) / (2 * SS) px 왼쪽/위로 밀림
+static float toCanvas(float v) { return (v + 0.5f) * SS - 0.5f; }
+static Point2f toCanvas(const Point2f& p) { return Point2f(toCanvas(p.x), toCanvas(p.y)); }
+
+// 눈꺼풀 가장자리 y (ROI 좌표). 가운데가 가장 열려 있고 눈꼬리로 갈수록 닫힘
+static float upperLidY(const SyntheticEyeParams& p, float x) {
+    float u = (x - p.size.width * 0.5f) / (p.size.width * 0.5f);
+    return p.size.height * (p.upperLid + 0.30f * u * u);
+}
+static float lowerLidY(const SyntheticEyeParams& p, float x) {
+    float u = (x - p.size.width * 0.5f) / (p.size.width * 0.5f);
+    return p.size.height * (1.f - p.lowerLid - 0.25f * u * u);
+}
+
+Mat renderSyntheticEye(const SyntheticEyeParams& p)
+{
+    const int W = p.size.width, H = p.size.height;
+    RNG rng(p.seed);
+
+    // 1) 8배 캔버스: 피부 -> 흰자 -> 홍채 -> 동공 -> 반사점
+    Mat big(H * SS, W * SS, CV_8UC1, Scalar(165));
+    ellipse(big, RotatedRect(toCanvas(Point2f((W - 1) * 0.5f, (H - 1) * 0.5f)), Size2f(W * 0.98f * SS, H * 0.9f * SS), 0.f),
+        Scalar(212), FILLED, LINE_AA);
+
+    const Point2f c = toCanvas(p.pupil);
+    ellipse(big, RotatedRect(c, Size2f(2.f * p.irisR * SS, 2.f * p.irisR * p.squash * SS), 0.f),
+        Scalar(kIris), FILLED, LINE_AA);
+    ellipse(big, RotatedRect(c, Size2f(2.f * p.pupilR * SS, 2.f * p.pupilR * p.squash * SS), 0.f),
+        Scalar(kPupil), FILLED, LINE_AA);
+
+    for (int i = 0; i < p.glints; ++i) {
+        // 반사점은 동공 가장자리/홍채 안쪽 위쪽에 작게
+        float ang = (float)rng.uniform(-2.6, -0.5);
+        float d = p.pupilR * (float)rng.uniform(0.5, 1.4);
+        Point2f g = toCanvas(p.pupil + Point2f(std::cos(ang) * d, std::sin(ang) * d));
+        float gr = std::max(0.8f, p.pupilR * 0.25f);
+        ellipse(big, RotatedRect(g, Size2f(2.f * gr * SS, 2.f * gr * SS), 0.f), Scalar(250), FILLED, LINE_AA);
+    }
+
+    // 2) 눈꺼풀: 위/아래 곡선 바깥을 피부색으로 덮음 (곡선은 ROI 왼쪽 끝 -0.5 ~ 오른쪽 끝 W - 0.5)
+    const int N = 33;
+    std::vector<Point> up, lo;
+    up.push_back(Point(0, 0));
+    lo.push_back(Point(0, H * SS));
+    for (int i = 0; i < N; ++i) {
+        float x = W * (float)i / (N - 1) - 0.5f;
+        up.push_back(Point(cvRound(toCanvas(x)), cvRound(toCanvas(upperLidY(p, x)))));
+        lo.push_back(Point(cvRound(toCanvas(x)), cvRound(toCanvas(lowerLidY(p, x)))));
+    }
+    up.push_back(Point(W * SS, 0));
+    lo.push_back(Point(W * SS, H * SS));
+    std::vector<std::vector<Point>> lids = { up, lo };
+    fillPoly(big, lids, Scalar(150), LINE_AA);
+
+    // 3) 속눈썹: 위 눈꺼풀 가장자리에서 위/바깥으로
+    for (int i = 0; i < p.lashes; ++i) {
+        float x = (float)rng.uniform(W * 0.1, W * 0.9);
+        float y = upperLidY(p, x);
+        float len = H * (float)rng.uniform(0.10, 0.22);
+        float lean = (x - W * 0.5f) / (W * 0.5f) * 0.6f + (float)rng.uniform(-0.2, 0.2);
+        Point a(cvRound(toCanvas(x)), cvRound(toCanvas(y)));
+        Point b(cvRound(toCanvas(x + lean * len)), cvRound(toCanvas(y - len)));
+        line(big, a, b, Scalar(35), std::max(1, SS / 2), LINE_AA);
+    }
+
+    // 4) 축소 (면적 평균 -> 가장자리 서브픽셀 정보 보존)
+    Mat eye;
+    resize(big, eye, p.size, 0, 0, INTER_AREA);
+
+    // 5) 조명 기울기 + 흐림 + 노이즈
+    Mat f; eye.convertTo(f, CV_32F);
+    if (p.gradient != 0.f) {
+        const float gx = std::cos(p.gradientAngle), gy = std::sin(p.gradientAngle);
+        const float norm = std::max(1.f, std::abs(gx) * W + std::abs(gy) * H);
+        for (int y = 0; y < H; ++y) {
+            float* row = f.ptr<float>(y);
+            for (int x = 0; x < W; ++x)
+                row[x] += p.gradient * ((x - W * 0.5f) * gx + (y - H * 0.5f) * gy) / norm;
+        }
+    }
+    if (p.blurSigma > 0.f) GaussianBlur(f, f, Size(0, 0), p.blurSigma);
+    if (p.noiseSigma > 0.f) {
+        Mat n(f.size(), CV_32F);
+        rng.fill(n, RNG::NORMAL, 0.0, p.noiseSigma);
+        f += n;
+    }
+
+    Mat out; f.convertTo(out, CV_8U);   // saturate
+    return out;
+}
+
+std::vector<SyntheticEyeParams> makeSyntheticEyeSet(int count, Size size, uint64_t seed)
+{
+    RNG rng(seed);
+    std::vector<SyntheticEyeParams> set;
+    set.reserve(count);
+    const float W = (float)size.width, H = (float)size.height;
+
+    for (int i = 0; i < count; ++i) {
+        SyntheticEyeParams p;
+        p.size = size;
+        p.pupilR = (float)rng.uniform(0.06, 0.10) * W;
+        p.irisR = p.pupilR * (float)rng.uniform(1.9, 2.5);
+        p.squash = (float)rng.uniform(0.80, 1.0);
+        p.upperLid = (float)rng.uniform(0.12, 0.32);
+        p.lowerLid = (float)rng.uniform(0.08, 0.20);
+        // 동공이 눈꺼풀에 다 가려지지 않는 범위에서 서브픽셀 위치
+        p.pupil.x = (float)rng.uniform(0.30, 0.70) * W;
+        float yMin = std::max(H * p.upperLid + p.pupilR * 0.5f, H * 0.35f);
+        float yMax = std::min(H * (1.f - p.lowerLid) - p.pupilR * 0.5f, H * 0.65f);
+        p.pupil.y = yMin < yMax ? (float)rng.uniform((double)yMin, (double)yMax) : H * 0.5f;
+        p.lashes = rng.uniform(0, 16);
+        p.glints = rng.uniform(0, 3);
+        p.noiseSigma = (float)rng.uniform(1.0, 8.0);
+        p.blurSigma = (float)rng.uniform(0.0, 1.5);
+        p.gradient = (float)rng.uniform(-50.0, 50.0);
+        p.gradientAngle = (float)rng.uniform(0.0, CV_PI);
+        p.seed = seed * 1000003ull + (uint64_t)i;
+        set.push_back(p);
+    }
+    return set;
+}
+
+float syntheticEyeGroundTruthError(Size size)
+{
+    // 노이즈/흐림/조명/속눈썹/반사 없는 깨끗한 원을 서브픽셀 위치 4x4곳에 그려 정답과 비교
+    float worst = 0.f;
+    for (int iy = 0; iy < 4; ++iy)
+        for (int ix = 0; ix < 4; ++ix) {
+            SyntheticEyeParams p;
+            p.size = size;
+            p.pupilR = 0.08f * size.width;
+            p.irisR = p.pupilR * 2.f;
+            p.squash = 1.f;
+            p.upperLid = 0.12f;
+            p.lowerLid = 0.08f;
+            p.pupil = Point2f(std::floor(size.width * 0.5f) + ix * 0.25f, std::floor(size.height * 0.5f) + iy * 0.25f);
+            p.lashes = p.glints = 0;
+            p.noiseSigma = p.blurSigma = p.gradient = 0.f;
+            Mat eye = renderSyntheticEye(p);
+
+            // 밝기 중심: 홍채보다 어두운 만큼 가중 (가장자리 픽셀은 덮인 면적에 비례)
+            double sw = 0, sx = 0, sy = 0;
+            for (int y = 0; y < eye.rows; ++y) {
+                const uchar* row = eye.ptr<uchar>(y);
+                for (int x = 0; x < eye.cols; ++x) {
+                    int w = kIris - row[x];
+                    if (w <= 0) continue;
+                    sw += w; sx += (double)w * x; sy += (double)w * y;
+                }
+            }
+            if (sw <= 0) return 1e9f;
+            worst = std::max(worst, (float)norm(Point2f((float)(sx / sw), (float)(sy / sw)) - p.pupil));
+        }
+    return worst;
+}
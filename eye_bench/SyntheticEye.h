@@ -0,0 +1,32 @@
+// SyntheticEye.h
+// 정답(동공 중심)을 아는 합성 눈 ROI 생성기 - 동공 추정기 정확도 비교용
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+struct SyntheticEyeParams {
+    cv::Size size = cv::Size(64, 40);   // ROI 크기 (px)
+    cv::Point2f pupil = cv::Point2f(32.f, 20.f);  // 동공 중심 (sub-pixel, ROI 좌표: 픽셀 (0,0)의 중심 = 0) = 정답
+    float pupilR = 5.f;                 // 동공 반지름 (px)
+    float irisR = 11.f;                 // 홍채 반지름 (px)
+    float squash = 0.92f;               // 세로/가로 비 (시선 각도에 따른 타원화)
+    float upperLid = 0.22f;             // 위 눈꺼풀 가장자리 높이 (ROI 높이 비율)
+    float lowerLid = 0.15f;             // 아래 눈꺼풀이 가리는 비율
+    int lashes = 10;                    // 속눈썹 개수
+    int glints = 1;                     // 각막 반사점 개수
+    float noiseSigma = 4.f;             // 가우시안 노이즈 (그레이 레벨)
+    float blurSigma = 0.7f;             // 초점 흐림 (px, 0이면 없음)
+    float gradient = 30.f;              // 조명 기울기 (ROI 양끝 밝기 차)
+    float gradientAngle = 0.f;          // 조명 기울기 방향 (rad)
+    uint64_t seed = 1;                  // 노이즈/속눈썹 난수 시드
+};
+
+// 파라미터대로 CV_8UC1 눈 ROI 렌더 (8배 슈퍼샘플링 후 축소 -> 서브픽셀 위치 반영)
+cv::Mat renderSyntheticEye(const SyntheticEyeParams& p);
+
+// 결정적(같은 seed -> 같은 결과) 랜덤 세트: 위치/크기/눈꺼풀/반사/노이즈/흐림/조명을 고르게 섞음
+std::vector<SyntheticEyeParams> makeSyntheticEyeSet(int count, cv::Size size, uint64_t seed);
+
+// 정답 좌표계 자가 검사: 깨끗한 원을 밝기 중심으로 다시 찾은 최대 오차 (px). 0.05 미만이어야 정상
+float syntheticEyeGroundTruthError(cv::Size size);
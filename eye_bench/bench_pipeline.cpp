@@ -0,0 +1,140 @@
+// bench_pipeline.cpp
+// GazePipeline 템플릿(정책 고정, 인라인) vs RuntimeGazePipeline(std::function 타입 소거) 프레임당 비용 비교
+// 합성 프레임(bench_stages와 같은 눈 위치) + FixedEyes, 출력은 끔. 두 쪽 다 같은 정책 조합이라 차이 = 간접 호출 비용
+// 사용법:
+//   bench_pipeline [--filter str] [--min-time sec] [--reps N] [--image frame.png]
+//                  [--save-baseline base.json] [--baseline base.json [--threshold 0.15]]
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "MicroBench.h"
+#include "SyntheticEye.h"
+#include "GazePipeline.h"
+
+using namespace cv;
+
+static const Rect kLeftEye(240, 180, 64, 40);
+static const Rect kRightEye(336, 180, 64, 40);
+
+static Mat makeFrame(const std::string& imagePath) {
+    if (!imagePath.empty()) {
+        Mat img = imread(imagePath, IMREAD_GRAYSCALE);
+        if (!img.empty()) return img;
+        std::fprintf(stderr, "cannot read %s, using synthetic frame\n", imagePath.c_str());
+    }
+    Mat frame(480, 640, CV_8UC1);
+    RNG rng(7);
+    rng.fill(frame, RNG::UNIFORM, 60, 200);
+    GaussianBlur(frame, frame, Size(0, 0), 6.0);
+    SyntheticEyeParams p;
+    p.size = kLeftEye.size();
+    renderSyntheticEye(p).copyTo(frame(kLeftEye));
+    p.pupil.x = 30.f; p.seed = 2;
+    renderSyntheticEye(p).copyTo(frame(kRightEye));
+    return frame;
+}
+
+// 9점 캘리브 흉내: (nx, ny) -> 1920x1080 (bench_stages::makeSamples와 같은 모델, 노이즈 없음)
+static Poly2 makePoly2() {
+    std::vector<Sample> S;
+    for (int j = -1; j <= 1; ++j)
+        for (int i = -1; i <= 1; ++i) {
+            Sample s;
+            s.nx = 0.5f * i; s.ny = 0.4f * j;
+            s.sx = 960.f + 1500.f * s.nx + 200.f * s.nx * s.nx;
+            s.sy = 540.f + 1100.f * s.ny + 150.f * s.nx * s.ny;
+            S.push_back(s);
+        }
+    Poly2 m;
+    m.fit(S);
+    return m;
+}
+
+static Calib2DMapper makeCalib() {
+    Calib2DMapper m;
+    Calib1D* axes[] = { &m.calib.X, &m.calib.Y };
+    for (Calib1D* c : axes) {
+        c->hasC = c->hasN = c->hasP = true;
+        c->N = -0.4f; c->C = 0.02f; c->P = 0.45f;
+    }
+    return m;
+}
+
+// 동공 추정 대신 고정 값 (골격 비용만 재는 용도)
+struct NoPupil {
+    static constexpr bool enabled = true;
+    bool estimate(const Mat&, const Rect&, float& nx, float& ny, float& c) { nx = 0.1f; ny = -0.05f; c = 1.f; return true; }
+};
+
+// 같은 프레임을 캡처 간격 33ms로 n번 흘림
+template <class Pipeline>
+static void runFrames(Pipeline& p, const Mat& frame, int64_t n) {
+    FrameTime t = PipelineClock::now();
+    GazeFrame f;
+    for (int64_t i = 0; i < n; ++i) {
+        t += std::chrono::microseconds(33333);
+        bool got = p.process(frame, t, f);
+        doNotOptimize(got); doNotOptimize(f.sx);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string imagePath;
+    MicroBench bench;
+    const bool argsOk = bench.parseArgs(argc, argv, [&](const char* opt, const std::function<const char*()>& next) {
+        if (std::strcmp(opt, "--image")) return BenchArg::Unknown;
+        imagePath = next();
+        return BenchArg::Handled;
+    });
+    if (!argsOk) return 2;
+
+    cv::setNumThreads(1);
+
+    const Mat frame = makeFrame(imagePath);
+    const FixedEyes eyes{ kLeftEye, kRightEye };
+    const Poly2 poly = makePoly2();
+    const Calib2DMapper calib = makeCalib();
+
+    // 조합 1: darkCentroid + EMA + Poly2
+    bench.add("static/darkCentroid+ema+poly2", [&](int64_t n) {
+        GazePipeline<FixedEyes, DarkCentroidPupil<>, EmaFilter, Poly2Mapper, NullOutput> p(eyes, {}, {}, Poly2Mapper{ poly });
+        runFrames(p, frame, n);
+    });
+    bench.add("runtime/darkCentroid+ema+poly2", [&](int64_t n) {
+        GazePipelineConfig cfg;
+        cfg.output = "none";
+        RuntimeGazePipeline p;
+        makeRuntimePipeline(cfg, anyDetector(eyes), poly, calib, p);
+        runFrames(p, frame, n);
+    });
+
+    // 조합 2: coarse findPupil + 필터 없음 + Calib2D (꺼진 필터 단계가 템플릿 쪽에선 코드 자체가 없음)
+    bench.add("static/findPupil+coarse+none+calib2d", [&](int64_t n) {
+        GazePipeline<FixedEyes, FindPupilPupil<true>, NoFilter, Calib2DMapper, NullOutput> p(eyes, {}, {}, calib);
+        runFrames(p, frame, n);
+    });
+    bench.add("runtime/findPupil+coarse+none+calib2d", [&](int64_t n) {
+        GazePipelineConfig cfg;
+        cfg.pupil = "findPupil+coarse"; cfg.filter = "none"; cfg.mapper = "calib2d"; cfg.output = "none";
+        RuntimeGazePipeline p;
+        makeRuntimePipeline(cfg, anyDetector(eyes), poly, calib, p);
+        runFrames(p, frame, n);
+    });
+
+    // 동공 단계를 뺀 골격만 (검출/융합/필터/매핑 + 간접 호출): 단계 호출 오버헤드가 보이는 곳
+    bench.add("static/skeleton", [&](int64_t n) {
+        GazePipeline<FixedEyes, NoPupil, EmaFilter, Poly2Mapper, NullOutput> p(eyes, {}, {}, Poly2Mapper{ poly });
+        runFrames(p, frame, n);
+    });
+    bench.add("runtime/skeleton", [&](int64_t n) {
+        RuntimeGazePipeline p(anyDetector(eyes), anyPupil(NoPupil()), anyFilter(EmaFilter()), anyMapper(Poly2Mapper{ poly }), AnyOutput());
+        runFrames(p, frame, n);
+    });
+
+    return bench.runMain("pipeline(s)");
+}
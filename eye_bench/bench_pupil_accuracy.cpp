@@ -0,0 +1,182 @@
+// bench_pupil_accuracy.cpp
+// 합성 눈 ROI(정답 동공 중심을 앎)로 동공 추정기들의 정확도/속도 비교
+//   darkCentroidNorm      (eye_cursor/PupilEstimator)
+//   darkCentroidNormFixed (eye_cursor/PupilEstimatorFixed, 정수 SIMD)
+//   +coarse               (eye_tracking/CoarsePupil 창 안에서만 위 추정기)
+//   findPupil             (eye_tracking/PupilFinder)
+//   findPupilPreprocessed (eye_preprocess/preprocess)
+// 사용법: bench_pupil_accuracy [--count N] [--seed S] [--repeat R] [--csv out.csv] [--dump dir]
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "SyntheticEye.h"
+#include "PupilEstimator.h"
+#include "PupilFinder.h"
+#include "preprocess.h"
+
+using namespace cv;
+
+// 추정기 공통 형태: 성공 시 ROI 픽셀 좌표 중심
+typedef std::function<bool(const Mat&, Point2f&)> Estimator;
+
+struct Method {
+    const char* name;
+    Estimator run;
+};
+
+struct Result {
+    int n = 0, found = 0;
+    std::vector<float> err;    // 검출된 것만 (px)
+    double ns = 0.0;           // ROI당 평균 처리 시간
+};
+
+static float percentile(std::vector<float> v, float q) {
+    if (v.empty()) return 0.f;
+    size_t k = std::min(v.size() - 1, (size_t)(q * (v.size() - 1) + 0.5f));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+static std::vector<Method> makeMethods() {
+    std::vector<Method> m;
+    m.push_back({ "darkCentroidNorm", [](const Mat& eye, Point2f& c) {
+        float nx, ny;
+        if (!darkCentroidNorm(eye, nx, ny)) return false;
+        // 정규화 좌표 -> ROI 픽셀 (PupilEstimator.cpp의 역변환)
+        c.x = nx * std::max(1.f, eye.cols * 0.5f) + (eye.cols - 1) * 0.5f;
+        c.y = ny * std::max(1.f, eye.rows * 0.5f) + (eye.rows - 1) * 0.5f;
+        return true;
+    } });
+    m.push_back({ "darkCentroidNormFixed", [](const Mat& eye, Point2f& c) {
+        float nx, ny;
+        if (!darkCentroidNormFixed(eye, nx, ny)) return false;
+        c.x = nx * std::max(1.f, eye.cols * 0.5f) + (eye.cols - 1) * 0.5f;
+        c.y = ny * std::max(1.f, eye.rows * 0.5f) + (eye.rows - 1) * 0.5f;
+        return true;
+    } });
+    m.push_back({ "findPupil", [](const Mat& eye, Point2f& c) {
+        Point p; float r;
+        if (!findPupil(eye, p, r)) return false;
+        c = Point2f((float)p.x, (float)p.y);
+        return true;
+    } });
+    m.push_back({ "darkCentroidNorm+coarse", [](const Mat& eye, Point2f& c) {
+        float nx, ny;
+        if (!darkCentroidNormCoarse(PupilImpl::Float, false, eye, nx, ny)) return false;
+        c.x = nx * std::max(1.f, eye.cols * 0.5f) + (eye.cols - 1) * 0.5f;
+        c.y = ny * std::max(1.f, eye.rows * 0.5f) + (eye.rows - 1) * 0.5f;
+        return true;
+    } });
+    m.push_back({ "findPupil+coarse", [](const Mat& eye, Point2f& c) {
+        Point p; float r;
+        if (!findPupilCoarse(eye, false, p, r)) return false;
+        c = Point2f((float)p.x, (float)p.y);
+        return true;
+    } });
+    m.push_back({ "findPupilPreprocessed", [](const Mat& eye, Point2f& c) {
+        Point p; float r;
+        if (!findPupilPreprocessed(eye, p, r)) return false;
+        c = Point2f((float)p.x, (float)p.y);
+        return true;
+    } });
+    return m;
+}
+
+int main(int argc, char** argv)
+{
+    int count = 300, repeat = 3;
+    uint64_t seed = 12345;
+    std::string csvPath, dumpDir;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--count") && i + 1 < argc) count = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--csv") && i + 1 < argc) csvPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--dump") && i + 1 < argc) dumpDir = argv[++i];
+        else {
+            std::fprintf(stderr, "usage: %s [--count N] [--seed S] [--repeat R] [--csv out.csv] [--dump dir]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // 실제 파이프라인에서 나오는 눈 ROI 크기대 (작은 웹캠 얼굴 ~ 가까운 얼굴)
+    const Size sizes[] = { Size(40, 24), Size(64, 40), Size(96, 60) };
+    std::vector<Method> methods = makeMethods();
+    cv::setNumThreads(1);   // 타이밍은 단일 스레드 기준
+
+    // 렌더러가 정답 위치에 동공을 그리는지 먼저 확인 (어긋나면 모든 방법에 같은 고정 오차가 더해짐)
+    for (const Size& sz : sizes) {
+        float gtErr = syntheticEyeGroundTruthError(sz);
+        if (gtErr >= 0.05f) {
+            std::fprintf(stderr, "synthetic ground truth off by %.3f px at %dx%d (limit 0.05)\n", gtErr, sz.width, sz.height);
+            return 1;
+        }
+    }
+
+    FILE* csv = nullptr;
+    if (!csvPath.empty()) {
+        csv = std::fopen(csvPath.c_str(), "w");
+        if (!csv) { std::fprintf(stderr, "cannot open %s\n", csvPath.c_str()); return 1; }
+        std::fprintf(csv, "size,method,n,detect_rate,mean_px,median_px,p95_px,ns_per_roi\n");
+    }
+
+    std::printf("synthetic eyes: %d per size, seed=%llu, repeat=%d\n\n", count, (unsigned long long)seed, repeat);
+    std::printf("%-8s %-24s %7s %8s %8s %8s %10s\n", "size", "method", "detect", "mean", "median", "p95", "us/roi");
+
+    for (const Size& sz : sizes) {
+        std::vector<SyntheticEyeParams> set = makeSyntheticEyeSet(count, sz, seed);
+        std::vector<Mat> eyes;
+        eyes.reserve(set.size());
+        for (size_t i = 0; i < set.size(); ++i) {
+            eyes.push_back(renderSyntheticEye(set[i]));
+            if (!dumpDir.empty() && i < 20) {
+                char name[256];
+                std::snprintf(name, sizeof(name), "%s/eye_%dx%d_%02d.png", dumpDir.c_str(), sz.width, sz.height, (int)i);
+                imwrite(name, eyes.back());
+            }
+        }
+
+        for (const Method& m : methods) {
+            Result res;
+            res.n = (int)eyes.size();
+            for (size_t i = 0; i < eyes.size(); ++i) {
+                Point2f c;
+                if (!m.run(eyes[i], c)) continue;
+                ++res.found;
+                res.err.push_back((float)norm(c - set[i].pupil));
+            }
+
+            // 타이밍은 정확도 측정과 분리 (첫 패스의 캐시/할당 워밍업 제외)
+            auto t0 = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeat; ++r)
+                for (const Mat& e : eyes) { Point2f c; m.run(e, c); }
+            auto t1 = std::chrono::steady_clock::now();
+            res.ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)repeat * eyes.size());
+
+            float mean = 0.f;
+            for (float e : res.err) mean += e;
+            if (!res.err.empty()) mean /= (float)res.err.size();
+            float med = percentile(res.err, 0.5f), p95 = percentile(res.err, 0.95f);
+            float rate = res.n ? (float)res.found / res.n : 0.f;
+
+            char szName[32];
+            std::snprintf(szName, sizeof(szName), "%dx%d", sz.width, sz.height);
+            std::printf("%-8s %-24s %6.1f%% %8.2f %8.2f %8.2f %10.1f\n",
+                szName, m.name, rate * 100.f, mean, med, p95, res.ns / 1000.0);
+            if (csv) std::fprintf(csv, "%s,%s,%d,%.4f,%.3f,%.3f,%.3f,%.0f\n",
+                szName, m.name, res.n, rate, mean, med, p95, res.ns);
+        }
+        std::printf("\n");
+    }
+
+    if (csv) std::fclose(csv);
+    std::printf("errors are pupil-center distance in ROI pixels (detected samples only)\n");
+    return 0;
+}
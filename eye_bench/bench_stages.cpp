@@ -0,0 +1,304 @@
+// bench_stages.cpp
+// 파이프라인 단계별 마이크로벤치 + JSON 기준선 회귀 검사
+//   얼굴/눈 detectMultiScale(DetectorProfile 파라미터), 띠 분할 얼굴 검출(TiledDetector, 1/2/4/코어 수 띠),
+//   darkCentroidNorm(Fixed/Coarse), coarsePupilWindow,
+//   preprocessEye, findPupil, Poly2::fit / Poly2::map, Calib1D::map, BlinkDetector::checkBlink
+// 사용법:
+//   bench_stages [--filter str] [--min-time sec] [--reps N] [--image frame.png]
+//                [--face-xml path] [--eye-xml path] [--profile profile.yml] [--detectors detectors.yml]
+//                [--save-baseline base.json] [--baseline base.json [--threshold 0.15]]
+// --baseline을 주면 중앙값 ns/op가 기준선보다 threshold 넘게 느려진 단계가 하나라도 있으면 종료 코드 1
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MicroBench.h"
+#include "SyntheticEye.h"
+#include "GazeModel.h"
+#include "PupilEstimator.h"
+#include "PupilFinder.h"
+#include "CoarsePupil.h"
+#include "preprocess.h"
+#include "Calib.h"
+#include "BlinkDetector.h"
+#include "DetectorProfile.h"
+#include "DetectorRegistry.h"
+#include "TiledDetector.h"
+
+using namespace cv;
+
+// 입력 세트 크기 (캐시에 다 들어가면서 분기 예측이 한 입력에 고정되지 않을 만큼)
+static const int kEyeSet = 16;
+static const int kPointSet = 256;
+
+// 얼굴 검출용 고정 프레임: --image가 없으면 노이즈 배경 + 합성 눈 두 개 (결정적)
+static Mat makeFrame(const std::string& imagePath) {
+    if (!imagePath.empty()) {
+        Mat img = imread(imagePath, IMREAD_GRAYSCALE);
+        if (!img.empty()) return img;
+        std::fprintf(stderr, "cannot read %s, using synthetic frame\n", imagePath.c_str());
+    }
+    Mat frame(480, 640, CV_8UC1);
+    RNG rng(7);
+    rng.fill(frame, RNG::UNIFORM, 60, 200);
+    GaussianBlur(frame, frame, Size(0, 0), 6.0);
+    ellipse(frame, RotatedRect(Point2f(320.f, 250.f), Size2f(220.f, 290.f), 0.f), Scalar(170), FILLED, LINE_AA);
+    SyntheticEyeParams p;
+    p.size = Size(64, 40);
+    renderSyntheticEye(p).copyTo(frame(Rect(240, 180, 64, 40)));
+    p.pupil.x = 30.f; p.seed = 2;
+    renderSyntheticEye(p).copyTo(frame(Rect(336, 180, 64, 40)));
+    return frame;
+}
+
+static std::vector<Mat> makeEyes(Size size) {
+    std::vector<SyntheticEyeParams> set = makeSyntheticEyeSet(kEyeSet, size, 777);
+    std::vector<Mat> eyes;
+    for (const SyntheticEyeParams& p : set) eyes.push_back(renderSyntheticEye(p));
+    return eyes;
+}
+
+// 9점 캘리브와 비슷한 (nx, ny) -> 화면 좌표 샘플 (2차 왜곡 + 노이즈)
+static std::vector<Sample> makeSamples(int count) {
+    RNG rng(99);
+    std::vector<Sample> S;
+    for (int i = 0; i < count; ++i) {
+        float nx = (float)rng.uniform(-0.6, 0.6), ny = (float)rng.uniform(-0.5, 0.5);
+        Sample s;
+        s.nx = nx; s.ny = ny;
+        s.sx = 960.f + 1500.f * nx + 200.f * nx * nx + (float)rng.gaussian(8.0);
+        s.sy = 540.f + 1100.f * ny + 150.f * nx * ny + (float)rng.gaussian(8.0);
+        S.push_back(s);
+    }
+    return S;
+}
+
+static std::string sizeName(Size s) {
+    return std::to_string(s.width) + "x" + std::to_string(s.height);
+}
+
+// face.tiled/<크기>/t<띠 수> 결과를 같은 크기의 t1 대비 속도로 요약 (코어 수만큼 빨라지는지 확인용)
+static void printTileScaling(const std::vector<BenchResult>& results) {
+    bool header = false;
+    for (const BenchResult& base : results) {
+        const std::string prefix = "face.tiled/";
+        if (base.name.compare(0, prefix.size(), prefix) || base.name.size() < 3
+            || base.name.compare(base.name.size() - 3, 3, "/t1")) continue;
+        const std::string group = base.name.substr(0, base.name.size() - 1);   // ".../t"
+        if (!header) {
+            std::printf("\ntiled face detection speedup vs 1 stripe (%u hardware threads):\n",
+                std::thread::hardware_concurrency());
+            header = true;
+        }
+        std::printf("  %s", group.substr(prefix.size(), group.size() - prefix.size() - 2).c_str());
+        for (const BenchResult& r : results)
+            if (r.name.compare(0, group.size(), group) == 0 && r.nsMedian > 0.0)
+                std::printf("  t%s %.2fx", r.name.c_str() + group.size(), base.nsMedian / r.nsMedian);
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string imagePath;
+    std::string faceXml = "haarcascade_frontalface_default.xml";
+    std::string eyeXml = "haarcascade_eye_tree_eyeglasses.xml";
+    DetectorProfile profile;
+    DetectorRegistry registry;
+    bool haveRegistry = false;
+    MicroBench bench;
+    const bool argsOk = bench.parseArgs(argc, argv, [&](const char* opt, const std::function<const char*()>& next) {
+        if (!std::strcmp(opt, "--image")) imagePath = next();
+        else if (!std::strcmp(opt, "--face-xml")) faceXml = next();
+        else if (!std::strcmp(opt, "--eye-xml")) eyeXml = next();
+        else if (!std::strcmp(opt, "--profile")) { if (!profile.load(next())) return BenchArg::Failed; }
+        else if (!std::strcmp(opt, "--detectors")) { if (!registry.load(next())) return BenchArg::Failed; haveRegistry = true; }
+        else return BenchArg::Unknown;
+        return BenchArg::Handled;
+    });
+    if (!argsOk) return 2;
+
+    cv::setNumThreads(1);   // 단계 자체 비용만 재기 위해 OpenCV 내부 병렬화 끔
+
+    // --- 캐스케이드 (CameraPipeline과 같은 프로파일, 기본값 = 배포 기본 파라미터) ---
+    CascadeClassifier faceC, eyeC;
+    const bool haveFace = faceC.load(faceXml), haveEye = eyeC.load(eyeXml);
+    if (!haveFace) std::fprintf(stderr, "skip face cascade: cannot load %s\n", faceXml.c_str());
+    if (!haveEye) std::fprintf(stderr, "skip eye cascade: cannot load %s\n", eyeXml.c_str());
+
+    const Mat frame480 = makeFrame(imagePath);
+    Mat frame240; resize(frame480, frame240, Size(320, 240), 0, 0, INTER_AREA);
+    if (haveFace) {
+        const Mat* frames[] = { &frame240, &frame480 };
+        for (const Mat* f : frames) {
+            bench.add("face.detectMultiScale/" + sizeName(f->size()), [&faceC, &profile, f](int64_t n) {
+                std::vector<Rect> faces;
+                for (int64_t i = 0; i < n; ++i) {
+                    profile.face.detect(faceC, *f, faces);
+                    doNotOptimize(faces.size());
+                }
+            });
+        }
+    }
+    if (haveFace) {
+        // 띠 분할 병렬 검출: 띠 수 1/2/4/코어 수 (띠 1개 = 감싸는 비용만). 최대 얼굴 높이는 레지스트리와 같은 규칙(프로파일 maxSize)
+        // 추적 해상도(1280x720)에서 효과가 크므로 그 크기도 같이
+        Mat frame720; resize(frame480, frame720, Size(1280, 720), 0, 0, INTER_LINEAR);
+        std::vector<int> tileCounts = { 1, 2, 4, (int)std::max(1u, std::thread::hardware_concurrency()) };
+        std::sort(tileCounts.begin(), tileCounts.end());
+        tileCounts.erase(std::unique(tileCounts.begin(), tileCounts.end()), tileCounts.end());
+        for (const Mat& f : { frame480, frame720 }) {
+            for (int tiles : tileCounts) {
+                std::shared_ptr<TiledDetector> det = TiledDetector::create("face-tiled",
+                    [&]() { return std::unique_ptr<ObjectDetector>(CascadeDetector::create("face", faceXml, profile.face, false)); },
+                    tiles, profile.face.maxSize.height);
+                if (!det) continue;
+                bench.add("face.tiled/" + sizeName(f.size()) + "/t" + std::to_string(tiles), [det, f](int64_t n) {
+                    std::vector<Rect> faces;
+                    for (int64_t i = 0; i < n; ++i) {
+                        det->detect(f, faces);
+                        doNotOptimize(faces.size());
+                    }
+                });
+            }
+        }
+    }
+    if (haveEye) {
+        // 얼굴 윗부분 60% ROI 크기대 (얼굴 폭 160 / 240 px)
+        for (int w : { 160, 240 }) {
+            Rect top(320 - w / 2, 250 - w / 2, w, (int)(w * 0.6));
+            top &= Rect(0, 0, frame480.cols, frame480.rows);
+            Mat roi = frame480(top);
+            bench.add("eye.detectMultiScale/" + sizeName(roi.size()), [&eyeC, &profile, roi](int64_t n) {
+                std::vector<Rect> eyes;
+                for (int64_t i = 0; i < n; ++i) {
+                    profile.eye.detect(eyeC, roi, eyes);
+                    doNotOptimize(eyes.size());
+                }
+            });
+        }
+    }
+
+    // --- 설정 파일의 검출기 전부 (Haar/LBP/YuNet 비교용, 얼굴은 프레임, 눈은 얼굴 윗부분) ---
+    if (haveRegistry) {
+        Rect top(240, 105, 160, 96);
+        for (const DetectorSpec& s : registry.specs()) {
+            std::shared_ptr<ObjectDetector> det = registry.create(s.name, profile);
+            if (!det) continue;
+            std::vector<Mat> inputs;
+            if (s.role == "face") inputs = { frame240, frame480 };
+            else inputs = { frame480(top) };
+            for (const Mat& in : inputs) {
+                bench.add("detector." + s.name + "/" + sizeName(in.size()), [det, in](int64_t n) {
+                    std::vector<Rect> found;
+                    for (int64_t i = 0; i < n; ++i) {
+                        det->detect(in, found);
+                        doNotOptimize(found.size());
+                    }
+                });
+            }
+        }
+    }
+
+    // --- 눈 ROI 단계 (여러 ROI 크기) ---
+    for (Size sz : { Size(40, 24), Size(64, 40), Size(96, 60) }) {
+        std::vector<Mat> eyes = makeEyes(sz);
+        bench.add("darkCentroidNorm/" + sizeName(sz), [eyes](int64_t n) {
+            float nx, ny, conf;
+            for (int64_t i = 0; i < n; ++i) {
+                bool ok = darkCentroidNorm(eyes[i % kEyeSet], nx, ny, &conf);
+                doNotOptimize(ok); doNotOptimize(nx);
+            }
+        });
+        bench.add("darkCentroidNormFixed/" + sizeName(sz), [eyes](int64_t n) {
+            float nx, ny, conf;
+            for (int64_t i = 0; i < n; ++i) {
+                bool ok = darkCentroidNormFixed(eyes[i % kEyeSet], nx, ny, &conf);
+                doNotOptimize(ok); doNotOptimize(nx);
+            }
+        });
+        bench.add("coarsePupilWindow/" + sizeName(sz), [eyes](int64_t n) {
+            Rect win;
+            for (int64_t i = 0; i < n; ++i) {
+                bool ok = coarsePupilWindow(eyes[i % kEyeSet], win);
+                doNotOptimize(ok); doNotOptimize(win.x);
+            }
+        });
+        bench.add("darkCentroidNormCoarse/" + sizeName(sz), [eyes](int64_t n) {
+            float nx, ny, conf;
+            for (int64_t i = 0; i < n; ++i) {
+                bool ok = darkCentroidNormCoarse(PupilImpl::Float, false, eyes[i % kEyeSet], nx, ny, &conf);
+                doNotOptimize(ok); doNotOptimize(nx);
+            }
+        });
+        bench.add("preprocessEye/" + sizeName(sz), [eyes](int64_t n) {
+            for (int64_t i = 0; i < n; ++i) {
+                Mat proc = preprocessEye(eyes[i % kEyeSet]);
+                doNotOptimize(proc.data);
+            }
+        });
+        bench.add("findPupil/" + sizeName(sz), [eyes](int64_t n) {
+            Point p; float r;
+            for (int64_t i = 0; i < n; ++i) {
+                bool ok = findPupil(eyes[i % kEyeSet], p, r);
+                doNotOptimize(ok); doNotOptimize(p.x);
+            }
+        });
+    }
+
+    // --- 매핑/필터 단계 ---
+    for (int count : { 9, 45 }) {
+        std::vector<Sample> S = makeSamples(count);
+        bench.add("Poly2::fit/" + std::to_string(count), [S](int64_t n) {
+            for (int64_t i = 0; i < n; ++i) {
+                Poly2 m;
+                bool ok = m.fit(S);
+                doNotOptimize(ok);
+            }
+        });
+    }
+    {
+        std::vector<Sample> S = makeSamples(kPointSet);
+        Poly2 model; model.fit(makeSamples(45));
+        bench.add("Poly2::map", [S, model](int64_t n) {
+            float sx, sy;
+            for (int64_t i = 0; i < n; ++i) {
+                const Sample& s = S[i % kPointSet];
+                bool ok = model.map(s.nx, s.ny, sx, sy);
+                doNotOptimize(ok); doNotOptimize(sx); doNotOptimize(sy);
+            }
+        });
+
+        Calib1D c;
+        c.hasC = c.hasN = c.hasP = true;
+        c.N = -0.4f; c.C = 0.02f; c.P = 0.45f;
+        bench.add("Calib1D::map", [S, c](int64_t n) {
+            for (int64_t i = 0; i < n; ++i) {
+                float v = c.map(S[i % kPointSet].nx);
+                doNotOptimize(v);
+            }
+        });
+    }
+    bench.add("BlinkDetector::checkBlink", [](int64_t n) {
+        // 30fps 캡처 시각, 10프레임 중 6프레임 미검출 패턴 (짧은 깜빡임과 긴 깜빡임이 섞임)
+        BlinkDetector blink;
+        BlinkDetector::Clock::time_point t{};
+        for (int64_t i = 0; i < n; ++i) {
+            t += std::chrono::microseconds(33333);
+            blink.checkBlink((i % 10) < 4, t);
+            bool b = blink.isBlinking();
+            if (b) blink.reset();
+            doNotOptimize(b);
+        }
+    });
+
+    std::vector<BenchResult> results;
+    const int rc = bench.runMain("stage(s)", &results);
+    printTileScaling(results);
+    return rc;
+}
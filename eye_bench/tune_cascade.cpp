@@ -0,0 +1,264 @@
+// tune_cascade.cpp
+// 녹화 영상으로 Haar 검출 파라미터 자동 튜닝 -> DetectorProfile 파일
+//  1) 기준 검출: 느리지만 촘촘한 설정(scale 1.05)으로 프레임마다 얼굴/눈 정답 박스를 만듦
+//  2) 후보 격자(scaleFactor x minNeighbors x minSize x maxSize)를 스레드 여러 개로 평가해
+//     기준 대비 재현율(recall)을 구함 (스레드마다 분류기 따로 로드)
+//  3) 재현율 목표를 넘는 후보만 단일 스레드로 다시 시간 측정해 가장 빠른 것을 고름
+// 사용법: tune_cascade <clip.mp4> [--out profile.yml] [--recall 0.95] [--frames 300] [--step 1]
+//                      [--camera "모델명"] [--threads N] [--face-xml path] [--eye-xml path]
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DetectorProfile.h"
+
+using namespace cv;
+using Clock = std::chrono::steady_clock;
+
+struct Candidate {
+    CascadeParams p;
+    double recall = 0.0;
+    double msPerFrame = 0.0;   // 2단계 단일 스레드 측정값 (1단계는 참고용)
+};
+
+// 기준 정답: 프레임별 가장 큰 얼굴 + 그 얼굴 윗부분에서 찾은 눈들 (프레임 좌표)
+struct Reference {
+    bool face = false;
+    Rect faceBox;
+    Rect top;                  // 눈 검색 ROI (얼굴 위 60%)
+    std::vector<Rect> eyes;    // top 기준 좌표
+};
+
+static double iou(const Rect& a, const Rect& b) {
+    double inter = (double)(a & b).area();
+    double uni = (double)a.area() + (double)b.area() - inter;
+    return uni > 0.0 ? inter / uni : 0.0;
+}
+
+static bool anyMatch(const Rect& ref, const std::vector<Rect>& found, double minIou) {
+    for (const Rect& r : found) if (iou(ref, r) >= minIou) return true;
+    return false;
+}
+
+static Rect faceTop(const Rect& f, const Size& frame) {
+    return Rect(f.x, f.y, f.width, (int)(f.height * 0.6)) & Rect(0, 0, frame.width, frame.height);
+}
+
+// 후보 목록을 threads개 스레드로 나눠 평가 (원자 인덱스 작업 큐, 스레드별 분류기)
+template <class Fn>
+static bool parallelEval(const std::string& xml, std::vector<Candidate>& cands, int threads, Fn eval) {
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> loadFail{ false };
+    std::atomic<size_t> done{ 0 };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            CascadeClassifier c;
+            if (!c.load(xml)) { loadFail = true; return; }
+            for (size_t i = next++; i < cands.size(); i = next++) {
+                eval(c, cands[i]);
+                size_t d = ++done;
+                if (d % 10 == 0 || d == cands.size())
+                    std::fprintf(stderr, "\r  %zu / %zu", d, cands.size());
+            }
+        });
+    }
+    for (std::thread& th : pool) th.join();
+    std::fprintf(stderr, "\n");
+    return !loadFail;
+}
+
+// 재현율 목표를 넘는 후보 중 (단일 스레드 재측정) 가장 빠른 것. 없으면 재현율 최고
+template <class TimeFn>
+static Candidate pickFastest(std::vector<Candidate>& cands, double target, TimeFn timeIt) {
+    std::sort(cands.begin(), cands.end(), [](const Candidate& a, const Candidate& b) {
+        return a.msPerFrame < b.msPerFrame; });
+
+    std::vector<Candidate*> ok;
+    for (Candidate& c : cands) if (c.recall >= target) ok.push_back(&c);
+    if (ok.empty()) {
+        Candidate best = *std::max_element(cands.begin(), cands.end(),
+            [](const Candidate& a, const Candidate& b) { return a.recall < b.recall; });
+        std::fprintf(stderr, "  no candidate reaches recall %.2f, using best recall %.3f\n", target, best.recall);
+        return best;
+    }
+    // 1단계 시간은 스레드 경합이 섞여 있으므로 앞쪽 후보만 다시 잼
+    if (ok.size() > 12) ok.resize(12);
+    for (Candidate* c : ok) c->msPerFrame = timeIt(*c);
+    return **std::min_element(ok.begin(), ok.end(), [](const Candidate* a, const Candidate* b) {
+        return a->msPerFrame < b->msPerFrame; });
+}
+
+static void printParams(const char* what, const Candidate& c) {
+    std::printf("%s: scale %.2f, minNeighbors %d, min %dx%d, max %dx%d -> recall %.3f, %.2f ms/frame\n",
+        what, c.p.scaleFactor, c.p.minNeighbors, c.p.minSize.width, c.p.minSize.height,
+        c.p.maxSize.width, c.p.maxSize.height, c.recall, c.msPerFrame);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <clip> [--out profile.yml] [--recall 0.95] [--frames 300] [--step 1]\n"
+            "          [--camera name] [--threads N] [--face-xml path] [--eye-xml path]\n", argv[0]);
+        return 1;
+    }
+    std::string clip = argv[1], outPath = "detector_profile.yml", cameraName;
+    std::string faceXml = "haarcascade_frontalface_default.xml";
+    std::string eyeXml = "haarcascade_eye_tree_eyeglasses.xml";
+    double target = 0.95;
+    int maxFrames = 300, step = 1;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i < argc; ++i) {
+        auto next = [&](void) -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        if (!std::strcmp(argv[i], "--out")) outPath = next();
+        else if (!std::strcmp(argv[i], "--recall")) target = std::atof(next());
+        else if (!std::strcmp(argv[i], "--frames")) maxFrames = std::max(1, std::atoi(next()));
+        else if (!std::strcmp(argv[i], "--step")) step = std::max(1, std::atoi(next()));
+        else if (!std::strcmp(argv[i], "--camera")) cameraName = next();
+        else if (!std::strcmp(argv[i], "--threads")) threads = std::max(1, std::atoi(next()));
+        else if (!std::strcmp(argv[i], "--face-xml")) faceXml = next();
+        else if (!std::strcmp(argv[i], "--eye-xml")) eyeXml = next();
+        else { std::fprintf(stderr, "unknown option %s\n", argv[i]); return 1; }
+    }
+    cv::setNumThreads(1);   // 병렬화는 후보 단위로만 (detectMultiScale 내부 병렬 끔)
+
+    // --- 클립 읽기 (파이프라인과 같은 전처리: 좌우 반전 + 그레이) ---
+    VideoCapture cap(clip);
+    if (!cap.isOpened()) { std::fprintf(stderr, "cannot open %s\n", clip.c_str()); return 1; }
+    std::vector<Mat> frames;
+    Mat frame, gray;
+    for (int idx = 0; (int)frames.size() < maxFrames && cap.read(frame); ++idx) {
+        if (idx % step) continue;
+        flip(frame, frame, 1);
+        cvtColor(frame, gray, COLOR_BGR2GRAY);
+        frames.push_back(gray.clone());
+    }
+    if (frames.empty()) { std::fprintf(stderr, "no frames in %s\n", clip.c_str()); return 1; }
+    std::printf("%zu frames %dx%d, %d threads, recall target %.2f\n",
+        frames.size(), frames[0].cols, frames[0].rows, threads, target);
+
+    // --- 1) 기준 정답 ---
+    CascadeClassifier refFace, refEye;
+    if (!refFace.load(faceXml) || !refEye.load(eyeXml)) { std::fprintf(stderr, "Load cascade failed. Check paths.\n"); return 1; }
+    const CascadeParams refFaceP{ 1.05, 3, Size(40, 40), Size() };
+    const CascadeParams refEyeP{ 1.05, 2, Size(16, 16), Size() };
+    std::vector<Reference> ref(frames.size());
+    int faceFrames = 0, eyeCount = 0;
+    int minFace = INT_MAX, maxFace = 0, minEye = INT_MAX, maxEye = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        std::vector<Rect> faces;
+        refFaceP.detect(refFace, frames[i], faces);
+        if (faces.empty()) continue;
+        Reference& r = ref[i];
+        r.face = true;
+        r.faceBox = *std::max_element(faces.begin(), faces.end(),
+            [](const Rect& a, const Rect& b) { return a.area() < b.area(); });
+        r.top = faceTop(r.faceBox, frames[i].size());
+        refEyeP.detect(refEye, frames[i](r.top), r.eyes);
+        ++faceFrames; eyeCount += (int)r.eyes.size();
+        minFace = std::min(minFace, r.faceBox.width); maxFace = std::max(maxFace, r.faceBox.width);
+        for (const Rect& e : r.eyes) { minEye = std::min(minEye, e.width); maxEye = std::max(maxEye, e.width); }
+    }
+    if (faceFrames == 0) { std::fprintf(stderr, "reference found no faces; record a clip with the user in view\n"); return 1; }
+    std::printf("reference: faces in %d frames (%d..%d px), %d eyes (%d..%d px)\n",
+        faceFrames, minFace, maxFace, eyeCount, eyeCount ? minEye : 0, maxEye);
+
+    // --- 2) 얼굴 후보 ---
+    std::vector<Candidate> faceCands;
+    for (double sf : { 1.05, 1.1, 1.15, 1.2, 1.3 })
+        for (int mn : { 2, 3, 4, 5, 6 })
+            for (double minK : { 0.5, 0.7, 0.9 })
+                for (double maxK : { 0.0, 1.3 }) {
+                    Candidate c;
+                    c.p.scaleFactor = sf; c.p.minNeighbors = mn;
+                    int lo = std::max(24, (int)(minFace * minK));
+                    c.p.minSize = Size(lo, lo);
+                    if (maxK > 0.0) { int mx = (int)(maxFace * maxK); c.p.maxSize = Size(mx, mx); }
+                    faceCands.push_back(c);
+                }
+
+    auto evalFace = [&](CascadeClassifier& c, Candidate& cand) {
+        int hit = 0;
+        std::vector<Rect> found;
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < frames.size(); ++i) {
+            cand.p.detect(c, frames[i], found);
+            if (ref[i].face && anyMatch(ref[i].faceBox, found, 0.5)) ++hit;
+        }
+        cand.msPerFrame = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / frames.size();
+        cand.recall = (double)hit / faceFrames;
+    };
+    std::printf("face: %zu candidates\n", faceCands.size());
+    if (!parallelEval(faceXml, faceCands, threads, evalFace)) { std::fprintf(stderr, "Load cascade failed. Check paths.\n"); return 1; }
+
+    CascadeClassifier timeFace; timeFace.load(faceXml);
+    Candidate bestFace = pickFastest(faceCands, target, [&](const Candidate& cand) {
+        std::vector<Rect> found;
+        auto t0 = Clock::now();
+        for (const Mat& f : frames) cand.p.detect(timeFace, f, found);
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / frames.size();
+    });
+    printParams("face", bestFace);
+
+    // --- 3) 눈 후보 (기준 얼굴 ROI 위에서만 평가 -> 얼굴 튜닝과 독립) ---
+    DetectorProfile profile;
+    profile.name = "tuned";
+    profile.camera = cameraName.empty() ? clip : cameraName;
+    profile.face = bestFace.p;
+
+    if (eyeCount == 0) {
+        std::fprintf(stderr, "reference found no eyes; keeping default eye parameters\n");
+    }
+    else {
+        std::vector<Candidate> eyeCands;
+        for (double sf : { 1.05, 1.1, 1.15, 1.2 })
+            for (int mn : { 1, 2, 3, 4, 5 })
+                for (double minK : { 0.6, 0.8 })
+                    for (double maxK : { 0.0, 1.3 }) {
+                        Candidate c;
+                        c.p.scaleFactor = sf; c.p.minNeighbors = mn;
+                        int lo = std::max(12, (int)(minEye * minK));
+                        c.p.minSize = Size(lo, lo);
+                        if (maxK > 0.0) { int mx = (int)(maxEye * maxK); c.p.maxSize = Size(mx, mx); }
+                        eyeCands.push_back(c);
+                    }
+
+        auto evalEye = [&](CascadeClassifier& c, Candidate& cand) {
+            int hit = 0;
+            std::vector<Rect> found;
+            auto t0 = Clock::now();
+            for (size_t i = 0; i < frames.size(); ++i) {
+                if (!ref[i].face) continue;
+                cand.p.detect(c, frames[i](ref[i].top), found);
+                for (const Rect& e : ref[i].eyes) if (anyMatch(e, found, 0.4)) ++hit;
+            }
+            cand.msPerFrame = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / faceFrames;
+            cand.recall = (double)hit / eyeCount;
+        };
+        std::printf("eye: %zu candidates\n", eyeCands.size());
+        if (!parallelEval(eyeXml, eyeCands, threads, evalEye)) { std::fprintf(stderr, "Load cascade failed. Check paths.\n"); return 1; }
+
+        CascadeClassifier timeEye; timeEye.load(eyeXml);
+        Candidate bestEye = pickFastest(eyeCands, target, [&](const Candidate& cand) {
+            std::vector<Rect> found;
+            auto t0 = Clock::now();
+            for (size_t i = 0; i < frames.size(); ++i)
+                if (ref[i].face) cand.p.detect(timeEye, frames[i](ref[i].top), found);
+            return std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / faceFrames;
+        });
+        printParams("eye ", bestEye);
+        profile.eye = bestEye.p;
+    }
+
+    if (!profile.save(outPath)) return 1;
+    std::printf("profile saved: %s (use --profile %s)\n", outPath.c_str(), outPath.c_str());
+    return 0;
+}
@@ -0,0 +1,170 @@
+// tune_pupil_cache.cpp
+// PupilCache 임계값(maxDiff) 튜닝: 응시/도약이 섞인 합성 눈 시퀀스에서 임계값별 적중률과 캐시가 만든 오차를 표로
+//   오차 = 캐시를 쓴 출력 vs 매 프레임 계산한 출력 (px), 정답 오차 = 출력 vs 렌더한 실제 동공 중심 (px)
+// 사용법: tune_pupil_cache [--frames N] [--seed S] [--size WxH] [--pupil float|fixed] [--coarse]
+//                         [--max-age N] [--thresholds 0.5,1,2,...] [--csv out.csv]
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "SyntheticEye.h"
+#include "PupilCache.h"
+#include "PupilEstimator.h"
+
+using namespace cv;
+using Clock = std::chrono::steady_clock;
+
+struct Frame {
+    Mat eye;
+    Point2f truth;      // 렌더한 동공 중심 (ROI px)
+    PupilResult fresh;  // 매 프레임 계산
+    double ns = 0.0;    // 그 계산 시간
+};
+
+static float percentile(std::vector<float> v, float q) {
+    if (v.empty()) return 0.f;
+    size_t k = std::min(v.size() - 1, (size_t)(q * (v.size() - 1) + 0.5f));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+static float average(const std::vector<float>& v) {
+    double s = 0.0;
+    for (float x : v) s += x;
+    return v.empty() ? 0.f : (float)(s / v.size());
+}
+
+// 정규화 좌표 -> ROI px (PupilEstimator.cpp의 역변환)
+static Point2f toPx(const PupilResult& r, Size s) {
+    return Point2f(r.nx * std::max(1.f, s.width * 0.5f) + (s.width - 1) * 0.5f,
+        r.ny * std::max(1.f, s.height * 0.5f) + (s.height - 1) * 0.5f);
+}
+
+// 30fps 시퀀스: 응시 10~60프레임(미세 떨림 0.15px) -> 도약 -> 응시 ..., 조명은 천천히 변함, 노이즈는 매 프레임 새로
+static std::vector<Frame> makeSequence(int count, Size size, uint64_t seed) {
+    RNG rng(seed);
+    SyntheticEyeParams base = makeSyntheticEyeSet(1, size, seed)[0];
+    base.lashes = 0;   // 프레임마다 다시 뿌려지면 응시 중에도 바뀌어 보임 (실제 속눈썹은 고정)
+    std::vector<Frame> seq;
+    Point2f fix = base.pupil;
+    int left = 0;
+    for (int i = 0; i < count; ++i) {
+        if (left-- <= 0) {
+            left = rng.uniform(10, 60);
+            fix = Point2f(size.width * (float)rng.uniform(0.3, 0.7), size.height * (float)rng.uniform(0.4, 0.6));
+        }
+        SyntheticEyeParams p = base;
+        p.pupil = fix + Point2f((float)rng.gaussian(0.15), (float)rng.gaussian(0.15));
+        p.gradientAngle = base.gradientAngle + 0.002f * i;
+        p.seed = seed + 1 + i;
+        Frame f;
+        f.eye = renderSyntheticEye(p);
+        f.truth = p.pupil;
+        seq.push_back(f);
+    }
+    return seq;
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 3000, maxAge = PupilCacheOptions().maxAge;
+    uint64_t seed = 4242;
+    Size size(64, 40);
+    PupilImpl impl = PupilImpl::Float;
+    bool coarse = false;
+    std::vector<float> thresholds = { 0.5f, 1.f, 1.5f, 2.f, 2.5f, 3.f, 4.f, 6.f };
+    std::string csvPath;
+    for (int i = 1; i < argc; ++i) {
+        auto next = [&](void) -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        if (!std::strcmp(argv[i], "--frames")) frames = std::max(1, std::atoi(next()));
+        else if (!std::strcmp(argv[i], "--seed")) seed = std::strtoull(next(), nullptr, 10);
+        else if (!std::strcmp(argv[i], "--size")) std::sscanf(next(), "%dx%d", &size.width, &size.height);
+        else if (!std::strcmp(argv[i], "--pupil")) impl = std::string(next()) == "fixed" ? PupilImpl::Fixed : PupilImpl::Float;
+        else if (!std::strcmp(argv[i], "--coarse")) coarse = true;
+        else if (!std::strcmp(argv[i], "--max-age")) maxAge = std::max(1, std::atoi(next()));
+        else if (!std::strcmp(argv[i], "--csv")) csvPath = next();
+        else if (!std::strcmp(argv[i], "--thresholds")) {
+            thresholds.clear();
+            for (const char* s = next(); *s; ) {
+                thresholds.push_back((float)std::atof(s));
+                const char* c = std::strchr(s, ',');
+                if (!c) break;
+                s = c + 1;
+            }
+        }
+        else {
+            std::fprintf(stderr, "usage: %s [--frames N] [--seed S] [--size WxH] [--pupil float|fixed] [--coarse]"
+                " [--max-age N] [--thresholds a,b,..] [--csv out.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+    cv::setNumThreads(1);
+
+    std::vector<Frame> seq = makeSequence(frames, size, seed);
+    std::vector<float> gtFresh;
+    double nsFresh = 0.0;
+    for (Frame& f : seq) {
+        const Clock::time_point t0 = Clock::now();
+        f.fresh.ok = coarse ? darkCentroidNormCoarse(impl, false, f.eye, f.fresh.nx, f.fresh.ny, &f.fresh.conf)
+            : darkCentroidNorm(impl, f.eye, f.fresh.nx, f.fresh.ny, &f.fresh.conf);
+        f.ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        nsFresh += f.ns;
+        if (f.fresh.ok) {
+            const Point2f d = toPx(f.fresh, size) - f.truth;
+            gtFresh.push_back(std::hypot(d.x, d.y));
+        }
+    }
+    nsFresh /= seq.size();
+
+    FILE* csv = nullptr;
+    if (!csvPath.empty()) {
+        csv = std::fopen(csvPath.c_str(), "w");
+        if (!csv) { std::fprintf(stderr, "cannot open %s\n", csvPath.c_str()); return 1; }
+        std::fprintf(csv, "max_diff,hit_rate,mean_px,p95_px,max_px,flips,gt_mean_px,us_per_frame,speedup\n");
+    }
+
+    std::printf("sequence: %d frames %dx%d, seed=%llu, %s%s, max-age %d\n", frames, size.width, size.height,
+        (unsigned long long)seed, impl == PupilImpl::Fixed ? "fixed" : "float", coarse ? "+coarse" : "", maxAge);
+    std::printf("no cache: %.2f us/frame, truth error mean %.3f px\n\n", nsFresh / 1000.0, average(gtFresh));
+    std::printf("%8s %7s %9s %9s %9s %6s %9s %10s %8s\n",
+        "maxDiff", "hit", "mean px", "p95 px", "max px", "flips", "truth px", "us/frame", "speedup");
+
+    for (float th : thresholds) {
+        PupilCacheOptions opt;
+        opt.maxDiff = th;
+        opt.maxAge = maxAge;
+        opt.auditEvery = 0;   // 매 프레임 계산값을 이미 알고 있으므로 감사 대신 전부 비교
+        PupilCache cache(opt);
+        std::vector<float> err, gt;
+        int flips = 0;
+        double ns = 0.0;
+        for (const Frame& f : seq) {
+            const Clock::time_point t0 = Clock::now();
+            PupilResult r;
+            const bool hit = cache.lookup(f.eye, r);
+            ns += (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+            if (!hit) { r = f.fresh; ns += f.ns; cache.store(r); }
+            if (r.ok != f.fresh.ok) { ++flips; continue; }
+            if (!r.ok) continue;
+            const Point2f d = toPx(r, size) - toPx(f.fresh, size), g = toPx(r, size) - f.truth;
+            err.push_back(std::hypot(d.x, d.y));
+            gt.push_back(std::hypot(g.x, g.y));
+        }
+        ns /= seq.size();
+        const PupilCacheStats& s = cache.stats();
+        const float meanE = average(err), gtMean = average(gt);
+        const float maxE = err.empty() ? 0.f : *std::max_element(err.begin(), err.end());
+        std::printf("%8.2f %6.1f%% %9.3f %9.3f %9.3f %6d %9.3f %10.2f %7.2fx\n",
+            th, s.hitRate() * 100.f, meanE, percentile(err, 0.95f), maxE, flips, gtMean, ns / 1000.0, nsFresh / std::max(1.0, ns));
+        if (csv) std::fprintf(csv, "%.3f,%.4f,%.4f,%.4f,%.4f,%d,%.4f,%.3f,%.3f\n",
+            th, s.hitRate(), meanE, percentile(err, 0.95f), maxE, flips, gtMean, ns / 1000.0, nsFresh / std::max(1.0, ns));
+    }
+    if (csv) std::fclose(csv);
+    return 0;
+}
@@ -0,0 +1,158 @@
+// validate_pupil_fixed.cpp
+// darkCentroidNormFixed(정수 SIMD)가 darkCentroidNorm(float)과 같은 답을 내는지 검사 + 속도 비교
+// 합성 눈 세트(SyntheticEye) + 선택적으로 실제 눈 ROI 이미지들. 타깃 보드(ARM)에서 그대로 돌려 CI 게이트로 사용
+// 각 세트를 FacePreprocessor(Equalize) 평활 뷰로도 만들어 ...Prepared 두 경로도 비교 (ARM 커서 파이프라인이 실제로 쓰는 경로)
+// 사용법: validate_pupil_fixed [--count N] [--seed S] [--repeat R] [--tol 0.02] [--agree 0.98] [eye.png ...]
+// 기준: 검출 여부 일치율 >= agree, 둘 다 검출한 ROI의 max |Δnx|, |Δny| <= tol (정규화 단위). 넘으면 종료 코드 1
+#include <opencv2/opencv.hpp>
+#include <opencv2/core/hal/intrin.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "SyntheticEye.h"
+#include "FacePreprocessor.h"
+#include "PupilEstimator.h"
+
+using namespace cv;
+
+typedef bool (*Estimator)(const Mat&, float&, float&, float*);
+
+// float / 고정소수점 짝
+struct EstimatorPair {
+    Estimator f, q;
+};
+static const EstimatorPair kRaw = { darkCentroidNorm, darkCentroidNormFixed };
+static const EstimatorPair kPrepared = { darkCentroidNormPrepared, darkCentroidNormFixedPrepared };
+
+struct Diff {
+    int n = 0, both = 0, agree = 0;
+    float maxDx = 0.f, maxDy = 0.f;
+    double sumDx = 0.0, sumDy = 0.0;
+    int worst = -1;                 // max(|Δnx|, |Δny|)가 가장 큰 입력
+    float worstD = 0.f;
+};
+
+static Diff compare(const EstimatorPair& est, const std::vector<Mat>& eyes) {
+    Diff d;
+    for (size_t i = 0; i < eyes.size(); ++i) {
+        float fx = 0.f, fy = 0.f, qx = 0.f, qy = 0.f;
+        const bool fo = est.f(eyes[i], fx, fy, nullptr);
+        const bool qo = est.q(eyes[i], qx, qy, nullptr);
+        ++d.n;
+        if (fo == qo) ++d.agree;
+        if (!fo || !qo) continue;
+        ++d.both;
+        const float dx = std::fabs(fx - qx), dy = std::fabs(fy - qy);
+        d.maxDx = std::max(d.maxDx, dx); d.maxDy = std::max(d.maxDy, dy);
+        d.sumDx += dx; d.sumDy += dy;
+        if (std::max(dx, dy) > d.worstD) { d.worstD = std::max(dx, dy); d.worst = (int)i; }
+    }
+    return d;
+}
+
+// ROI당 평균 ns
+template <typename F>
+static double timeNs(const std::vector<Mat>& eyes, int repeat, F f) {
+    for (const Mat& e : eyes) f(e);   // 워밍업
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; ++r)
+        for (const Mat& e : eyes) f(e);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)repeat * std::max<size_t>(1, eyes.size()));
+}
+
+static bool report(const char* name, const EstimatorPair& est, const std::vector<Mat>& eyes, int repeat, float tol, float agreeMin) {
+    Diff d = compare(est, eyes);
+    const float agree = d.n ? (float)d.agree / d.n : 1.f;
+    double fNs = timeNs(eyes, repeat, [&](const Mat& e) { float x, y, c; return est.f(e, x, y, &c); });
+    double qNs = timeNs(eyes, repeat, [&](const Mat& e) { float x, y, c; return est.q(e, x, y, &c); });
+    const bool pass = agree >= agreeMin && d.maxDx <= tol && d.maxDy <= tol;
+
+    std::printf("%-12s %5d %7.1f%% %6d %8.4f %8.4f %8.4f %8.4f %9.1f %9.1f %6.2fx  %s\n",
+        name, d.n, agree * 100.f, d.both,
+        d.both ? d.sumDx / d.both : 0.0, d.maxDx, d.both ? d.sumDy / d.both : 0.0, d.maxDy,
+        fNs / 1000.0, qNs / 1000.0, qNs > 0.0 ? fNs / qNs : 0.0, pass ? "ok" : "FAIL");
+    if (!pass && d.worst >= 0) std::printf("             worst input #%d (|d|=%.4f)\n", d.worst, d.worstD);
+    return pass;
+}
+
+// FacePreprocessor(Equalize)와 같은 순서(equalizeHist -> GaussianBlur 7x7)로 만든 평활 뷰 (ROI 전체를 얼굴 영역으로)
+static std::vector<Mat> prepareEyes(const std::vector<Mat>& eyes) {
+    FacePreprocessor pre(FaceNormMode::Equalize);
+    std::vector<Mat> out;
+    out.reserve(eyes.size());
+    for (const Mat& e : eyes) {
+        const Rect r(0, 0, e.cols, e.rows);
+        pre.compute(e, r);
+        out.push_back(pre.smooth(r).clone());   // 뷰는 다음 compute까지만 유효
+    }
+    return out;
+}
+
+// 원본 세트와 평활 뷰 세트(이름 뒤 "+prep") 둘 다 검사
+static bool reportBoth(const char* name, const std::vector<Mat>& eyes, int repeat, float tol, float agreeMin) {
+    bool pass = report(name, kRaw, eyes, repeat, tol, agreeMin);
+    char prepName[48];
+    std::snprintf(prepName, sizeof(prepName), "%s+prep", name);
+    return report(prepName, kPrepared, prepareEyes(eyes), repeat, tol, agreeMin) && pass;
+}
+
+int main(int argc, char** argv)
+{
+    int count = 500, repeat = 3;
+    uint64_t seed = 777;
+    float tol = 0.02f, agreeMin = 0.98f;
+    std::vector<std::string> images;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--count") && i + 1 < argc) count = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--tol") && i + 1 < argc) tol = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--agree") && i + 1 < argc) agreeMin = (float)std::atof(argv[++i]);
+        else if (argv[i][0] != '-') images.push_back(argv[i]);
+        else {
+            std::fprintf(stderr, "usage: %s [--count N] [--seed S] [--repeat R] [--tol T] [--agree A] [eye.png ...]\n", argv[0]);
+            return 2;
+        }
+    }
+
+#if CV_SIMD
+    std::printf("universal intrinsics: %d-bit (v_uint8 x %d)\n", CV_SIMD_WIDTH * 8, (int)v_uint8::nlanes);
+#else
+    std::printf("universal intrinsics: off (scalar)\n");
+#endif
+    std::printf("tolerance: |d| <= %.3f, detection agreement >= %.1f%%\n\n", tol, agreeMin * 100.f);
+    std::printf("%-12s %5s %8s %6s %8s %8s %8s %8s %9s %9s %7s\n",
+        "set", "n", "agree", "both", "mean|dx|", "max|dx|", "mean|dy|", "max|dy|", "float us", "fixed us", "speed");
+
+    cv::setNumThreads(1);
+    bool pass = true;
+    for (Size sz : { Size(40, 24), Size(64, 40), Size(96, 60) }) {
+        std::vector<SyntheticEyeParams> set = makeSyntheticEyeSet(count, sz, seed);
+        std::vector<Mat> eyes;
+        eyes.reserve(set.size());
+        for (const SyntheticEyeParams& p : set) eyes.push_back(renderSyntheticEye(p));
+        char name[32];
+        std::snprintf(name, sizeof(name), "%dx%d", sz.width, sz.height);
+        pass = reportBoth(name, eyes, repeat, tol, agreeMin) && pass;
+    }
+
+    if (!images.empty()) {
+        std::vector<Mat> eyes;
+        for (const std::string& path : images) {
+            Mat e = imread(path, IMREAD_GRAYSCALE);
+            if (e.empty()) { std::fprintf(stderr, "cannot read %s\n", path.c_str()); return 2; }
+            eyes.push_back(e);
+        }
+        pass = reportBoth("images", eyes, repeat, tol, agreeMin) && pass;
+    }
+
+    std::printf("\n%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+// AutoCalibrator.cpp
+#include "AutoCalibrator.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace cv;
+
+static float median(std::vector<float>& v) {
+    const size_t h = v.size() / 2;
+    std::nth_element(v.begin(), v.begin() + h, v.end());
+    float m = v[h];
+    if (v.size() % 2 == 0) m = (m + *std::max_element(v.begin(), v.begin() + h)) * 0.5f;
+    return m;
+}
+
+static float rmsDistance(const std::vector<Point2f>& pts, const std::vector<int>& idx, Point2f c) {
+    if (idx.empty()) return 0.f;
+    double s = 0.0;
+    for (int i : idx) { Point2f d = pts[i] - c; s += d.dot(d); }
+    return (float)std::sqrt(s / idx.size());
+}
+
+AutoCalibrator::AutoCalibrator(const ScreenTopology& screens, AutoCalibOptions opt)
+    : monitors_(screens.monitors()), opt_(opt)
+{
+    for (int m = 0; m < (int)monitors_.size(); ++m)
+        for (const Point2f& p : screens.gridTargets(m, opt_.grid, opt_.margin)) {
+            targets_.push_back(p);
+            targetMon_.push_back(m);
+        }
+}
+
+void AutoCalibrator::start(size_t cameras, FrameTime now)
+{
+    raw_.assign(cameras, std::vector<std::vector<Point2f>>(targets_.size()));
+    rawL_ = raw_;
+    rawR_ = raw_;
+    reports_.clear();
+    cur_ = 0;
+    shownAt_ = now;
+    state_ = State::Collect;
+}
+
+void AutoCalibrator::cancel()
+{
+    state_ = State::Idle;
+    raw_.clear(); rawL_.clear(); rawR_.clear();
+}
+
+bool AutoCalibrator::update(std::vector<std::vector<CameraGaze>>& batches, FrameTime now)
+{
+    if (state_ != State::Collect) return false;
+
+    // 캡처 시각이 [settle, settle + collect) 안인 프레임만 (카메라 스레드가 쌓은 것이라 프레임마다 한 번씩)
+    const FrameTime from = shownAt_ + opt_.settle, to = from + opt_.collect;
+    for (size_t i = 0; i < batches.size() && i < raw_.size(); ++i) {
+        for (const CameraGaze& g : batches[i]) {
+            if (!g.got || g.t < from || g.t >= to) continue;
+            raw_[i][cur_].push_back(Point2f(g.nx, g.ny));
+            if (g.left.ok) rawL_[i][cur_].push_back(Point2f(g.left.nx, g.left.ny));
+            if (g.right.ok) rawR_[i][cur_].push_back(Point2f(g.right.nx, g.right.ny));
+        }
+        batches[i].clear();
+    }
+
+    // 창 안에서 캡처됐지만 아직 검출 중인 프레임이 도착할 때까지 타깃 유지
+    if (now < to + opt_.latencySlack) return false;
+    if (cur_ + 1 < targets_.size()) { ++cur_; shownAt_ = now; return false; }
+    return true;
+}
+
+int AutoCalibrator::aggregate(const std::vector<Point2f>& pts, const AutoCalibOptions& opt,
+    Point2f& out, float& spread)
+{
+    if (pts.empty()) return 0;
+    std::vector<int> all(pts.size());
+    for (size_t i = 0; i < pts.size(); ++i) all[i] = (int)i;
+
+    if (opt.aggregate == CalibAggregate::Median) {
+        std::vector<float> xs, ys;
+        for (const Point2f& p : pts) { xs.push_back(p.x); ys.push_back(p.y); }
+        out = Point2f(median(xs), median(ys));
+        spread = rmsDistance(pts, all, out);
+        return (int)pts.size();
+    }
+
+    // RANSAC (모델 = 한 점): 후보 중심 반경 안 프레임 수가 가장 많은 집합의 평균
+    // 응시 중 사카드/깜빡임 직후 프레임처럼 한쪽으로 몰린 이상치는 집합 밖으로 빠짐
+    const float r2 = opt.ransacRadius * opt.ransacRadius;
+    RNG rng(0x5eed);
+    std::vector<int> best, in;
+    const int iters = std::min<int>(opt.ransacIters, (int)pts.size());
+    for (int it = 0; it < iters; ++it) {
+        const Point2f c = pts[iters == (int)pts.size() ? it : rng.uniform(0, (int)pts.size())];
+        in.clear();
+        for (size_t i = 0; i < pts.size(); ++i) {
+            Point2f d = pts[i] - c;
+            if (d.dot(d) <= r2) in.push_back((int)i);
+        }
+        if (in.size() > best.size()) best.swap(in);
+    }
+    Point2f m(0.f, 0.f);
+    for (int i : best) m += pts[i];
+    out = m * (1.f / best.size());
+    spread = rmsDistance(pts, best, out);
+    return (int)best.size();
+}
+
+bool AutoCalibrator::finish(std::vector<CameraCalib>& calib)
+{
+    bool any = false;
+    reports_.assign(raw_.size(), std::vector<CalibPointReport>(targets_.size()));
+    for (size_t ci = 0; ci < raw_.size() && ci < calib.size(); ++ci) {
+        std::vector<Sample> samples;
+        for (size_t ti = 0; ti < targets_.size(); ++ti) {
+            CalibPointReport& r = reports_[ci][ti];
+            r.target = targets_[ti];
+            r.samples = (int)raw_[ci][ti].size();
+            r.inliers = aggregate(raw_[ci][ti], opt_, r.gaze, r.spread);
+            r.used = r.samples >= opt_.minSamples && r.inliers > 0;
+            if (!r.used) continue;
+            Sample s; s.nx = r.gaze.x; s.ny = r.gaze.y; s.sx = r.target.x; s.sy = r.target.y;
+
+            // 눈별: 그 눈이 충분히 보인 타깃만
+            Point2f e; float spread;
+            if ((int)rawL_[ci][ti].size() >= opt_.minSamples && aggregate(rawL_[ci][ti], opt_, e, spread) > 0) {
+                s.leftOk = true; s.lx = e.x; s.ly = e.y;
+            }
+            if ((int)rawR_[ci][ti].size() >= opt_.minSamples && aggregate(rawR_[ci][ti], opt_, e, spread) > 0) {
+                s.rightOk = true; s.rx = e.x; s.ry = e.y;
+            }
+            samples.push_back(s);
+        }
+
+        // 수동 샘플을 대체 (한 번에 한 방식)
+        CameraCalib& c = calib[ci];
+        c.samples = samples;
+        c.fit();
+        std::cout << "[AutoCalib] cam" << ci << (c.ready ? " OK (" : " FAIL (") << samples.size()
+            << "/" << targets_.size() << " targets, eye models L" << (c.leftReady ? "+" : "-")
+            << " R" << (c.rightReady ? "+" : "-") << ")\n";
+        if (!c.ready) continue;
+        any = true;
+
+        double se = 0.0;
+        for (CalibPointReport& r : reports_[ci]) {
+            if (!r.used) continue;
+            c.model.map(r.gaze.x, r.gaze.y, r.mapped.x, r.mapped.y);
+            r.residualPx = (float)norm(r.mapped - r.target);
+            se += r.residualPx * r.residualPx;
+        }
+        for (size_t ti = 0; ti < targets_.size(); ++ti) {
+            const CalibPointReport& r = reports_[ci][ti];
+            std::cout << cv::format("  #%zu (%4.0f,%4.0f) frames=%3d inliers=%3d spread=%.3f ", ti + 1,
+                r.target.x, r.target.y, r.samples, r.inliers, r.spread);
+            if (r.used) std::cout << cv::format("residual=%.1fpx\n", r.residualPx);
+            else std::cout << "skipped\n";
+        }
+        std::cout << cv::format("  RMS residual %.1fpx\n", std::sqrt(se / std::max<size_t>(1, samples.size())));
+    }
+    raw_.clear(); rawL_.clear(); rawR_.clear();
+    state_ = State::Result;
+    return any;
+}
+
+void AutoCalibrator::draw(Mat& canvas, int monitor) const
+{
+    const MonitorInfo& mon = monitors_[monitor];
+    canvas.create(mon.bounds.size(), CV_8UC3);
+    canvas.setTo(Scalar(30, 30, 30));
+    const Point2f org = mon.org;
+    const float s = mon.dpiScale;   // 고DPI 모니터에서도 같은 물리 크기로 보이게
+
+    if (state_ == State::Collect) {
+        if (targetMon_[cur_] != monitor) return;
+        // 수집 전(settle)에는 줄어드는 고리로 시선 유도, 수집 중에는 작은 점만
+        const Point c(cvRound(targets_[cur_].x - org.x), cvRound(targets_[cur_].y - org.y));
+        const float age = secondsBetween(shownAt_, PipelineClock::now());
+        const float settle = std::chrono::duration<float>(opt_.settle).count();
+        if (age < settle) circle(canvas, c, cvRound(s * (10 + 30 * (1.f - age / settle))), Scalar(0, 200, 255), 2, LINE_AA);
+        circle(canvas, c, cvRound(6 * s), Scalar(255, 255, 255), FILLED, LINE_AA);
+        circle(canvas, c, cvRound(2 * s), Scalar(0, 0, 0), FILLED, LINE_AA);
+        putText(canvas, cv::format("%zu / %zu  (ESC: cancel)", cur_ + 1, targets_.size()),
+            Point(20, cvRound(40 * s)), FONT_HERSHEY_SIMPLEX, 0.8 * s, Scalar(200, 200, 200), 2);
+        return;
+    }
+    if (state_ != State::Result) return;
+
+    // 결과: 타깃(흰색) -> 카메라별 매핑 점, 잔차 px (이 모니터에 있는 타깃만)
+    static const Scalar colors[] = { Scalar(0, 255, 0), Scalar(255, 200, 0), Scalar(0, 200, 255), Scalar(255, 0, 255) };
+    for (size_t ti = 0; ti < targets_.size(); ++ti)
+        if (targetMon_[ti] == monitor) circle(canvas, targets_[ti] - org, cvRound(6 * s), Scalar(255, 255, 255), FILLED, LINE_AA);
+    for (size_t ci = 0; ci < reports_.size(); ++ci) {
+        const Scalar& col = colors[ci % 4];
+        for (size_t ti = 0; ti < reports_[ci].size(); ++ti) {
+            if (targetMon_[ti] != monitor) continue;
+            const CalibPointReport& r = reports_[ci][ti];
+            const Point2f t = r.target - org;
+            if (r.residualPx < 0.f) {
+                putText(canvas, "x", t + Point2f(8.f, -8.f) * s, FONT_HERSHEY_SIMPLEX, 0.6 * s, col, 2);
+                continue;
+            }
+            line(canvas, t, r.mapped - org, col, 1, LINE_AA);
+            circle(canvas, r.mapped - org, cvRound(4 * s), col, FILLED, LINE_AA);
+            putText(canvas, cv::format("%.0f", r.residualPx), t + Point2f(10.f, 20.f + 18.f * ci) * s,
+                FONT_HERSHEY_SIMPLEX, 0.5 * s, col, 1);
+        }
+    }
+    putText(canvas, "Calibration result (any key: close)", Point(20, cvRound(40 * s)),
+        FONT_HERSHEY_SIMPLEX, 0.8 * s, Scalar(200, 200, 200), 2);
+}
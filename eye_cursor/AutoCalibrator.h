@@ -0,0 +1,90 @@
+// AutoCalibrator.h
+// 자동 화면 캘리브레이션: 모니터마다 전체 화면에 9/16개 타깃을 차례로 띄우고, 타깃마다 프레임별 원시 시선을 모아
+// 중앙값/RANSAC으로 한 점으로 집계한 뒤 카메라별 Poly2 학습 + 점별 잔차 보고
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <vector>
+#include "CameraPipeline.h"
+#include "GazeFusion.h"
+#include "PipelineClock.h"
+#include "ScreenTopology.h"
+
+enum class CalibAggregate { Median, Ransac };
+
+struct AutoCalibOptions {
+    int grid = 3;                                   // 모니터당 3 -> 9점, 4 -> 16점
+    float margin = 0.1f;                            // 화면 가장자리 여백 (비율)
+    std::chrono::milliseconds settle{ 600 };        // 타깃이 바뀐 뒤 버리는 구간 (사카드 + 반응 시간)
+    std::chrono::milliseconds collect{ 900 };       // 샘플 수집 구간 (응시 창)
+    std::chrono::milliseconds latencySlack{ 250 };  // 수집 창이 끝난 뒤 처리 중인 프레임을 기다리는 시간 (그다음 타깃 전환)
+    int minSamples = 8;                             // 타깃·카메라당 최소 유효 프레임
+    CalibAggregate aggregate = CalibAggregate::Ransac;
+    float ransacRadius = 0.04f;                     // 정규화 시선 단위 인라이어 반경
+    int ransacIters = 64;
+};
+
+// 타깃 하나, 카메라 하나의 집계 결과
+struct CalibPointReport {
+    cv::Point2f target;         // 가상 데스크톱 px
+    int samples = 0;            // 수집 프레임 수
+    int inliers = 0;            // 집계에 쓴 프레임 수
+    bool used = false;          // 학습에 들어감 (samples >= minSamples)
+    cv::Point2f gaze;           // 집계 시선 (nx, ny)
+    float spread = 0.f;         // 인라이어의 집계점 기준 RMS 거리 (정규화 단위)
+    cv::Point2f mapped;         // 학습된 모델로 gaze를 매핑한 화면 좌표
+    float residualPx = -1.f;    // |mapped - target|, 학습 실패면 -1
+};
+
+/**
+ * @class AutoCalibrator
+ * @brief 메인 루프에서 update()로 카메라별 프레임 결과 묶음(CameraPipeline::drainRecorded)을 넘기면
+ * 타깃 전환과 샘플 수집을 스스로 진행합니다. 수집 창은 캡처 시각 기준이라 처리 지연이 있어도 타깃이 바뀐 뒤
+ * settle 이전 프레임은 들어가지 않고, 창이 끝나도 latencySlack 동안은 아직 처리 중인 창 안 프레임을 기다립니다.
+ * 끝나면 finish()가 카메라별로 집계 샘플을 CameraCalib에 넣고 학습한 뒤 잔차를 계산합니다.
+ * 타깃은 모니터별 격자라 Poly2는 모든 모니터를 덮는 가상 데스크톱 좌표로 학습됩니다.
+ */
+class AutoCalibrator {
+public:
+    explicit AutoCalibrator(const ScreenTopology& screens, AutoCalibOptions opt = AutoCalibOptions());
+
+    void start(size_t cameras, FrameTime now);
+    void cancel();
+
+    bool collecting() const { return state_ == State::Collect; }
+    bool showing() const { return state_ != State::Idle; }   // 수집 중 또는 결과 화면
+
+    // 새 프레임 결과 반영 + 타깃 진행. batches[카메라] = 지난 호출 이후 그 카메라의 모든 결과 (반영 후 비움)
+    // 마지막 타깃 수집이 끝난 호출에서 true (한 번)
+    bool update(std::vector<std::vector<CameraGaze>>& batches, FrameTime now);
+
+    // 집계 -> 카메라별 샘플 교체 + 학습 + 잔차. 학습된 카메라가 하나라도 있으면 true. 이후 결과 화면
+    bool finish(std::vector<CameraCalib>& calib);
+
+    // 결과 화면 닫기
+    void close() { state_ = State::Idle; }
+
+    // 모니터 하나 크기의 캔버스에 그 모니터의 현재 타깃 또는 결과(타깃 -> 매핑 점) 그림
+    void draw(cv::Mat& canvas, int monitor) const;
+
+    const std::vector<std::vector<CalibPointReport>>& reports() const { return reports_; }
+
+    // 프레임별 시선 묶음 -> 한 점. 인라이어 수 반환 (0이면 실패)
+    static int aggregate(const std::vector<cv::Point2f>& pts, const AutoCalibOptions& opt,
+        cv::Point2f& out, float& spread);
+
+private:
+    enum class State { Idle, Collect, Result };
+
+    std::vector<MonitorInfo> monitors_;
+    AutoCalibOptions opt_;
+    std::vector<cv::Point2f> targets_;
+    std::vector<int> targetMon_;    // 타깃별 모니터
+    State state_ = State::Idle;
+    size_t cur_ = 0;                // 현재 타깃
+    FrameTime shownAt_;             // 현재 타깃을 띄운 시각
+
+    std::vector<std::vector<std::vector<cv::Point2f>>> raw_; // [카메라][타깃] 프레임별 양눈 융합 (nx, ny)
+    std::vector<std::vector<std::vector<cv::Point2f>>> rawL_, rawR_;   // 같은 구조, 눈별 (눈별 모델용)
+    std::vector<std::vector<CalibPointReport>> reports_;     // [카메라][타깃]
+};
@@ -0,0 +1,350 @@
+// CameraPipeline.cpp
+#include "CameraPipeline.h"
+#include "GazeModel.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace cv;
+
+static const float EMA_TAU_S = tauFromAlpha(0.25f, 30.f);   // 카메라별 시선 EMA (30fps에서 α=0.25와 동일)
+
+static float msSince(FrameTime t0) {
+    return std::chrono::duration<float, std::milli>(PipelineClock::now() - t0).count();
+}
+
+CameraPipeline::CameraPipeline(int camIndex, std::shared_ptr<ObjectDetector> face, std::shared_ptr<ObjectDetector> eye,
+    CaptureOptions capture, QualityOptions quality)
+    : cam_(camIndex), faceDet_(std::move(face)), eyeDet_(std::move(eye)), capture_(camIndex, capture),
+    quality_("cam" + std::to_string(camIndex), quality)
+{
+}
+
+CameraPipeline::~CameraPipeline()
+{
+    stop();
+}
+
+bool CameraPipeline::open()
+{
+    if (!faceDet_ || !eyeDet_) {
+        std::cerr << "Camera " << cam_ << ": detector missing\n"; return false;
+    }
+    if (!capture_.open()) return false;
+    if (poolCapacity_ > 0) {
+        // 슬랩 하나 = 기준 해상도 BGR (추적 crop/탐색 저해상도 프레임, 그레이, 디버그 캔버스 모두 들어감)
+        FramePoolOptions po;
+        po.capacity = poolCapacity_;
+        po.slotBytes = (size_t)capture_.canonicalSize().area() * 3;
+        pool_ = std::make_unique<FramePool>(po);
+    }
+    return true;
+}
+
+FramePoolStats CameraPipeline::framePoolStats() const
+{
+    return pool_ ? pool_->stats() : FramePoolStats();
+}
+
+void CameraPipeline::setPupilCache(const PupilCacheOptions& opt)
+{
+    cacheL_ = PupilCache(opt);
+    cacheR_ = PupilCache(opt);
+}
+
+PupilCacheStats CameraPipeline::cacheStats() const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return cacheStats_;
+}
+
+void CameraPipeline::setDetectors(std::shared_ptr<ObjectDetector> face, std::shared_ptr<ObjectDetector> eye)
+{
+    if (face) std::atomic_store(&faceDet_, std::move(face));
+    if (eye) std::atomic_store(&eyeDet_, std::move(eye));
+}
+
+void CameraPipeline::start(FrameSignal* signal)
+{
+    if (running_.exchange(true)) return;
+    signal_ = signal;
+    worker_ = std::thread(&CameraPipeline::run, this);
+}
+
+void CameraPipeline::stop()
+{
+    running_.store(false);
+    if (worker_.joinable()) worker_.join();
+}
+
+CameraGaze CameraPipeline::latest() const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return latest_;
+}
+
+void CameraPipeline::setRecording(bool on)
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    recording_ = on;
+    recorded_.clear();
+    if (on) recorded_.reserve(kRecordCap);
+}
+
+void CameraPipeline::drainRecorded(std::vector<CameraGaze>& out)
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    out.insert(out.end(), recorded_.begin(), recorded_.end());
+    recorded_.clear();
+}
+
+DebugFrame CameraPipeline::takeDebugFrame()
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    DebugFrame out = std::move(debug_);
+    debug_.buf.reset();
+    return out;
+}
+
+void CameraPipeline::run()
+{
+    while (running_.load()) {
+        // 캡처 모드에 따라 전체 프레임(탐색) 또는 얼굴 주변만(추적) 반전/변환되어 옴
+        CapturedFrame cf;
+        if (!capture_.read(cf, pool_.get())) break;
+        Mat& frame = cf.bgr;
+        const FrameTime t0 = PipelineClock::now();   // 처리 시간 = 캡처 대기 이후
+        const QualityLevel& q = quality_.level();
+        StageTimes st;
+
+        CameraGaze g;
+        g.t = cf.t;
+        g.cam = cam_;
+        g.seq = ++seq_;
+        // 프레임 단위로 검출기를 잡아 둠 (도중에 교체돼도 이번 프레임은 같은 인스턴스)
+        std::shared_ptr<ObjectDetector> faceDet = std::atomic_load(&faceDet_);
+        std::shared_ptr<ObjectDetector> eyeDet = std::atomic_load(&eyeDet_);
+        const bool standby = capture_.standby();
+        if (standby) {
+            // 대기 모드: 캐스케이드 대신 움직임 감지만 (빈 결과는 그대로 발행 -> 메인 루프/HUD 유지)
+            if (!standby_.exchange(true)) { motion_.reset(); standbyFaceT_ = cf.t; }
+            if (standbyWake(cf, *faceDet)) { capture_.wake(); standby_.store(false); }
+        }
+        else {
+            standby_.store(false);
+            // 프로파일 크기(기준 해상도 px)를 이번 프레임 해상도에 맞춤 (탐색 모드 저해상도, 품질 단계의 검출 축소)
+            faceDet->setSizeScale(q.detectScale / cf.sx);
+            eyeDet->setSizeScale(1.0 / cf.sx);
+            faceDet->setMinScaleFactor(q.minScaleFactor);
+            eyeDet->setMinScaleFactor(q.minScaleFactor);
+            process(frame, cf.gray, g, *faceDet, *eyeDet, q, st);
+
+            // 처리 영역 좌표 -> 기준 좌표 (nx/ny는 눈 ROI 기준 정규화라 그대로)
+            if (g.face) g.faceBox = cf.toCanonical(g.faceBox);
+            if (g.left.ok) g.left.box = cf.toCanonical(g.left.box);
+            if (g.right.ok) g.right.box = cf.toCanonical(g.right.box);
+            capture_.update(g.face, g.faceBox, cf.t);
+        }
+
+        // 디버그 프레임도 기준 좌표계 크기로 (crop/저해상도 부분을 제자리에)
+        // 메인 스레드로 넘기므로 저장소째(FrameRef) 넘김. 캔버스는 풀이 바닥이면 기다리지 않고 crop 그대로
+        // (그때는 crop 위치/배율을 같이 넘겨 메인이 기준 좌표 오버레이를 옮겨 그림)
+        DebugFrame dbg;
+        dbg.buf = cf.bgrBuf.empty() ? FrameRef::wrap(frame) : cf.bgrBuf;
+        dbg.roi = cf.roi; dbg.sx = cf.sx; dbg.sy = cf.sy;
+        if (cf.roi.size() != frame.size() || cf.roi.tl() != Point(0, 0)) {
+            FrameRef canvasBuf = pool_ ? pool_->tryAcquire(capture_.canonicalSize(), CV_8UC3)
+                : FrameRef::wrap(Mat(capture_.canonicalSize(), CV_8UC3));
+            if (!canvasBuf.empty()) {
+                Mat canvas = canvasBuf.mat();
+                canvas.setTo(Scalar(40, 40, 40));
+                if (cf.roi.size() == frame.size()) frame.copyTo(canvas(cf.roi));
+                else resize(frame, canvas(cf.roi), cf.roi.size(), 0, 0, INTER_NEAREST);
+                putText(canvas, capture_.modeName(), Point(canvas.cols - 200, 30),
+                    FONT_HERSHEY_SIMPLEX, 0.6, Scalar(200, 200, 200), 1);
+                frame = canvas;
+                dbg.buf = std::move(canvasBuf);
+                dbg.roi = Rect(Point(0, 0), canvas.size());
+                dbg.sx = dbg.sy = 1.f;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            latest_ = g;
+            if (recording_) {
+                if (recorded_.size() >= kRecordCap) recorded_.erase(recorded_.begin());
+                recorded_.push_back(g);
+            }
+            debug_ = std::move(dbg);
+            cacheStats_ = cacheL_.stats();
+            cacheStats_.merge(cacheR_.stats());
+        }
+        if (signal_) signal_->notify();
+
+        if (standby) continue;   // 대기 프레임은 품질 단계 판단에 넣지 않음
+        st.totalMs = msSince(t0);
+        quality_.update(st);
+    }
+    running_.store(false);
+    if (signal_) signal_->notify();   // 종료도 메인에 알림
+}
+
+bool CameraPipeline::standbyWake(const CapturedFrame& cf, ObjectDetector& faceDet)
+{
+    if (motion_.update(cf.gray)) return true;
+    // 움직임 없이 앉아 있는 사람 대비: 1초마다 대기 해상도 프레임에서 얼굴 검출 한 번
+    if (secondsBetween(standbyFaceT_, cf.t) < 1.f) return false;
+    standbyFaceT_ = cf.t;
+    faceDet.setSizeScale(1.0 / cf.sx);
+    faceDet.setMinScaleFactor(0.0);   // 프로파일 배율 그대로
+    faceDet.detect(cf.gray, faces_);
+    return !faces_.empty();
+}
+
+void CameraPipeline::process(Mat& frame, const Mat& gray, CameraGaze& g,
+    ObjectDetector& faceDet, ObjectDetector& eyeDet, const QualityLevel& q, StageTimes& st)
+{
+    const bool showDbg = showDbg_.load();
+    const bool draw = q.debugDraw;
+
+    FrameTime ts = PipelineClock::now();
+    std::vector<Rect>& faces = faces_;   // 멤버 벡터 재사용 (용량 유지 -> 매 프레임 할당 없음)
+    faces.clear();
+    if (q.detectScale < 1.f) {
+        // 품질 단계: 축소한 그레이에서 얼굴 검출 -> 처리 영역 좌표로
+        resize(gray, smallGray_, Size(), q.detectScale, q.detectScale, INTER_AREA);
+        faceDet.detect(smallGray_, faces);
+        const float inv = 1.f / q.detectScale;
+        for (Rect& r : faces)
+            r = Rect(cvRound(r.x * inv), cvRound(r.y * inv), cvRound(r.width * inv), cvRound(r.height * inv))
+            & Rect(0, 0, gray.cols, gray.rows);
+    }
+    else faceDet.detect(gray, faces);
+    st.faceMs = msSince(ts);
+    if (faces.empty()) { eyeRel_.clear(); cacheL_.reset(); cacheR_.reset(); return; }
+
+    Rect f = *std::max_element(faces.begin(), faces.end(),
+        [](const Rect& a, const Rect& b) {return a.area() < b.area(); });
+    if (draw) rectangle(frame, f, Scalar(0, 255, 0), 2);
+    g.face = true; g.faceBox = f;
+
+    Rect top = upperFaceRect(f);
+    top &= Rect(0, 0, frame.cols, frame.rows);                       // ★ FIX: 경계 클리핑
+    // 위쪽 얼굴 대비 정규화 + 평활은 여기서 한 번: 눈 캐스케이드와 두 눈 동공 추정은 이 결과의 뷰
+    facePre_.compute(gray, top);
+    if (facePre_.empty()) return;
+    Mat faceROI = facePre_.norm();
+
+    // 품질 단계: 눈 검출은 eyeEvery 프레임마다, 사이 프레임은 얼굴 ROI 기준 상대 위치를 그대로 씀
+    ts = PipelineClock::now();
+    std::vector<Rect>& eyes = eyes_;
+    eyes.clear();
+    if (q.eyeEvery > 1 && !eyeRel_.empty() && ++eyeAge_ < q.eyeEvery) {
+        for (const Rect2f& r : eyeRel_)
+            eyes.push_back(Rect(cvRound(r.x * top.width), cvRound(r.y * top.height),
+                cvRound(r.width * top.width), cvRound(r.height * top.height)));
+    }
+    else {
+        eyeDet.detect(faceROI, eyes);
+        std::sort(eyes.begin(), eyes.end(), [](const Rect& a, const Rect& b) {return a.x < b.x; });
+        eyeAge_ = 0;
+        eyeRel_.clear();
+        for (const Rect& e : eyes)
+            eyeRel_.push_back(Rect2f((float)e.x / top.width, (float)e.y / top.height,
+                (float)e.width / top.width, (float)e.height / top.height));
+    }
+    st.eyeMs = msSince(ts);
+    ts = PipelineClock::now();
+
+    float faceCenterX = f.x + f.width * 0.5f;
+    // 추정기 설정이 바뀌면 캐시된 결과는 다른 추정기 값이므로 버림
+    const PupilImpl impl = pupil_.load();
+    const bool coarse = coarse_.load();
+    const int cacheKey = (int)impl * 2 + (coarse ? 1 : 0);
+    if (cacheKey != cacheKey_) { cacheL_.reset(); cacheR_.reset(); cacheKey_ = cacheKey; }
+
+    for (size_t i = 0; i < eyes.size() && i < 2; i++) {
+        Rect et = eyeCropRect(eyes[i]);
+        et &= Rect(0, 0, faceROI.cols, faceROI.rows);                // ★ FIX: faceROI 경계 클리핑
+        if (et.width < 12 || et.height < 12) continue;
+
+        Rect er(et.x + top.x, et.y + top.y, et.width, et.height);
+        er &= Rect(0, 0, gray.cols, gray.rows);                      // ★ FIX: 프레임 경계 재클리핑
+        if (er.width < 8 || er.height < 8) continue;                 // ★ FIX: 최소 크기
+        if (draw) rectangle(frame, er, Scalar(255, 200, 0), 1);
+
+        Mat eyeSmooth = facePre_.smooth(er);
+        if (eyeSmooth.empty() || eyeSmooth.total() == 0 || eyeSmooth.type() != CV_8UC1) continue; // ★ FIX
+
+        bool isLeftSide = (er.x + er.width * 0.5f) < faceCenterX;
+
+        // 응시 중처럼 눈 ROI가 거의 그대로면 이전 결과 재사용 (PupilCache)
+        PupilCache& cache = isLeftSide ? cacheL_ : cacheR_;
+        PupilResult pr;
+        if (!cache.lookup(eyeSmooth, pr)) {
+            try {                                                    // ★ FIX: 예외 방지
+                // 대략 위치 창 안에서만 정밀 추정 (눈썹/눈꺼풀 그림자 제외)
+                pr.ok = coarse ? darkCentroidNormCoarse(impl, true, eyeSmooth, pr.nx, pr.ny, &pr.conf)
+                    : darkCentroidNormPrepared(impl, eyeSmooth, pr.nx, pr.ny, &pr.conf);
+            }
+            catch (const cv::Exception& ex) {
+                std::cerr << "[darkCentroidNorm] " << ex.what() << std::endl;
+                pr.ok = false;
+            }
+            cache.store(pr);
+        }
+        const bool ok = pr.ok;
+        const float nx = pr.nx, ny = pr.ny, conf = pr.conf;
+
+        if (ok) {
+            // 시각화
+            if (draw) {
+                int cx = er.x + er.width / 2 + (int)(nx * (er.width * 0.5f));
+                int cy = er.y + er.height / 2 + (int)(ny * (er.height * 0.5f));
+                line(frame, Point(cx, er.y), Point(cx, er.y + er.height), Scalar(0, 0, 255), 2);
+                line(frame, Point(er.x, cy), Point(er.x + er.width, cy), Scalar(0, 255, 0), 2);
+            }
+
+            EyeObs& o = isLeftSide ? g.left : g.right;
+            o.ok = true; o.nx = nx; o.ny = ny; o.conf = conf; o.box = er;
+
+            if (showDbg && draw) {
+                putText(frame, cv::format("nx=%.2f ny=%.2f", nx, ny),
+                    Point(er.x, er.y - 6), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(0, 255, 255), 1);
+            }
+        }
+        else if (draw) {
+            putText(frame, "pupil?", Point(er.x, er.y - 6),
+                FONT_HERSHEY_SIMPLEX, 0.45, Scalar(40, 40, 255), 1);
+        }
+    }
+    st.pupilMs = msSince(ts);
+
+    // 눈별 EMA (눈별 Poly2 입력). 그 눈이 보인 프레임만, 간격은 그 눈의 마지막 갱신부터
+    auto eyeEma = [&](EyeObs& o, EyeEma& e) {
+        if (!o.ok) return;
+        float a = e.init ? emaAlpha(secondsBetween(e.t, g.t), EMA_TAU_S) : 1.f;
+        e.x = ema1(e.x, o.nx, a); e.y = ema1(e.y, o.ny, a);
+        e.t = g.t; e.init = true;
+        o.emaX = e.x; o.emaY = e.y;
+        };
+    eyeEma(g.left, emaL_);
+    eyeEma(g.right, emaR_);
+
+    // 양눈 융합: 신뢰도 가중 + 눈 사이 오프셋 보정 (한쪽 눈만 보여도 평균이 튀지 않음)
+    Point2f mid;
+    const float fdt = fusion_.ready() ? secondsBetween(fusionT_, g.t) : 0.f;
+    if (fusion_.fuse(g.left.ok, Point2f(g.left.nx, g.left.ny), g.left.conf,
+        g.right.ok, Point2f(g.right.nx, g.right.ny), g.right.conf, fdt, mid)) {
+        fusionT_ = g.t;
+        // 프레임 간격(실제 경과 시간)으로 α 계산 -> FPS가 바뀌어도 평활 강도 유지
+        float dt = emaInit_ ? secondsBetween(emaT_, g.t) : 1.f / 30.f;
+        float a = emaAlpha(dt, EMA_TAU_S);
+        emaX_ = ema1(emaX_, mid.x, a);
+        emaY_ = ema1(emaY_, mid.y, a);
+        emaT_ = g.t; emaInit_ = true;
+        g.nx = mid.x; g.ny = mid.y;
+        g.got = true;
+    }
+    g.emaX = emaX_; g.emaY = emaY_;
+}
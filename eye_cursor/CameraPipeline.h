@@ -0,0 +1,172 @@
+// CameraPipeline.h
+// 카메라 1대 = 캡처 + 얼굴/눈/동공 검출 스레드 1개
+#pragma once
+#include <opencv2/opencv.hpp>
+#include "BinocularFusion.h"
+#include "CaptureController.h"
+#include "FacePreprocessor.h"
+#include "FramePool.h"
+#include "MotionDetector.h"
+#include "PupilCache.h"
+#include "ObjectDetector.h"
+#include "PipelineClock.h"
+#include "PupilEstimator.h"
+#include "QualityController.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 한쪽 눈의 이번 프레임 관측값
+struct EyeObs {
+    bool ok = false;
+    float nx = 0.f, ny = 0.f;   // 눈 ROI 중심 기준 정규화 시선
+    float conf = 0.f;           // 0..1 (darkCentroidNorm 질량/ROI 크기 기반)
+    float emaX = 0.f, emaY = 0.f;   // 이 눈만의 EMA (눈별 Poly2 입력)
+    cv::Rect box;               // 프레임 좌표계 눈 ROI
+};
+
+// 카메라 1대의 프레임별 결과
+struct CameraGaze {
+    int cam = -1;
+    uint64_t seq = 0;                                   // 0이면 아직 결과 없음
+    FrameTime t;                // 캡처(grab) 시각
+    bool face = false;
+    cv::Rect faceBox;           // 기준 좌표계 (추적 해상도 전체 프레임, 미러)
+    EyeObs left, right;
+    bool got = false;           // 이번 프레임 시선 유효 (한쪽 눈 이상)
+    float nx = 0.f, ny = 0.f;   // 이번 프레임 양눈 융합 (EMA 전, 자동 캘리브레이션 샘플)
+    float emaX = 0.f, emaY = 0.f; // 카메라별 1차 EMA (양눈 융합 값)
+};
+
+// 메인 스레드로 넘기는 디버그 프레임: 보통은 기준 좌표계 크기 캔버스(roi = 전체, 배율 1),
+// 풀이 바닥나 캔버스를 못 받은 프레임은 처리 영역(crop/저해상도) 그대로 -> 기준 좌표에 그릴 때는 toFrame으로
+struct DebugFrame {
+    FrameRef buf;
+    cv::Rect roi;               // 이 프레임이 기준 좌표계에서 차지하는 영역
+    float sx = 1.f, sy = 1.f;   // 기준 px / 프레임 px
+
+    cv::Mat& mat() { return buf.mat(); }
+    bool empty() const { return buf.empty(); }
+    cv::Point toFrame(const cv::Point& canon) const {
+        return cv::Point(cvRound((canon.x - roi.x) / sx), cvRound((canon.y - roi.y) / sy));
+    }
+};
+
+// 여러 파이프라인 -> 메인 스레드 "새 결과 있음" 알림
+class FrameSignal {
+public:
+    void notify() {
+        { std::lock_guard<std::mutex> lk(m_); ++count_; }
+        cv_.notify_all();
+    }
+    // seen 이후 새 알림이 올 때까지 (최대 timeout) 대기, 새 알림이 있으면 true
+    bool wait(uint64_t& seen, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lk(m_);
+        bool fresh = cv_.wait_for(lk, timeout, [&] { return count_ != seen; });
+        seen = count_;
+        return fresh;
+    }
+private:
+    std::mutex m_;
+    std::condition_variable cv_;
+    uint64_t count_ = 0;
+};
+
+class CameraPipeline {
+public:
+    // 검출기는 이 카메라 스레드 전용 인스턴스 (DetectorRegistry::create로 카메라마다 따로 생성)
+    // 박스 좌표와 디버그 프레임은 캡처 모드와 상관없이 기준 좌표계 (CaptureController 참고)
+    // quality: 처리 시간 예산 (넘으면 품질 단계를 내림, QualityController 참고)
+    CameraPipeline(int camIndex, std::shared_ptr<ObjectDetector> face, std::shared_ptr<ObjectDetector> eye,
+        CaptureOptions capture = CaptureOptions(), QualityOptions quality = QualityOptions());
+    ~CameraPipeline();
+
+    // 카메라 열기 (실패 시 false, 에러는 stderr)
+    bool open();
+    void start(FrameSignal* signal);
+    void stop();
+
+    int index() const { return cam_; }
+    bool alive() const { return running_.load(); }
+    // 대기 모드 (얼굴 없음이 오래 지속 -> 저해상도 + 움직임 감지만)
+    bool standby() const { return standby_.load(); }
+
+    // 최신 결과 복사 (seq가 바뀌지 않았으면 같은 결과)
+    CameraGaze latest() const;
+    // 켜져 있는 동안 모든 프레임 결과를 큐에 쌓음 (자동 캘리브레이션: 메인 루프가 카메라보다 느려도 빠짐없이)
+    // 끄면 큐를 비움. 메인이 오래 안 가져가면 kRecordCap개까지만 (오래된 것부터 버림)
+    void setRecording(bool on);
+    // 쌓인 결과를 out 뒤에 붙이고 큐를 비움 (캡처 순서)
+    void drainRecorded(std::vector<CameraGaze>& out);
+    static constexpr size_t kRecordCap = 512;
+    // 최신 디버그 프레임을 가져감 (한 번만 반환, 없으면 빈 프레임). 들고 있는 동안 풀 슬랩 하나를 붙잡음
+    DebugFrame takeDebugFrame();
+
+    void setShowDebug(bool on) { showDbg_.store(on); }
+    void setPupilImpl(PupilImpl impl) { pupil_.store(impl); }
+    void setCoarsePupil(bool on) { coarse_.store(on); }
+    // 프레임 버퍼 풀 슬랩 수 (open 전에만, 0 = 풀 없이 매 프레임 할당)
+    void setFramePoolCapacity(int n) { poolCapacity_ = n; }
+    // 풀 압력 지표 (풀 없으면 빈 값)
+    FramePoolStats framePoolStats() const;
+    // 눈별 동공 결과 캐시 설정 (start 전에만)
+    void setPupilCache(const PupilCacheOptions& opt);
+    // 두 눈 합친 캐시 지표 (적중률, 감사 오차)
+    PupilCacheStats cacheStats() const;
+
+    // 실행 중 검출기 교체 (nullptr = 유지). 다음 프레임부터 적용, 이전 인스턴스는 스레드가 놓으면 해제
+    void setDetectors(std::shared_ptr<ObjectDetector> face, std::shared_ptr<ObjectDetector> eye);
+
+private:
+    void run();
+    // 대기 프레임에서 깨어날지: 움직임 또는 (1초마다) 얼굴
+    bool standbyWake(const CapturedFrame& cf, ObjectDetector& faceDet);
+    void process(cv::Mat& frame, const cv::Mat& gray, CameraGaze& g,
+        ObjectDetector& faceDet, ObjectDetector& eyeDet, const QualityLevel& q, StageTimes& st);
+
+    int cam_;
+    std::shared_ptr<ObjectDetector> faceDet_, eyeDet_;   // std::atomic_load/store로만 접근
+    CaptureController capture_;
+    int poolCapacity_ = 8;
+    std::unique_ptr<FramePool> pool_;   // FrameRef를 들고 있는 멤버(debug_)보다 먼저 선언 -> 나중에 소멸
+    QualityController quality_;
+
+    // 파이프라인 스레드 전용 상태
+    float emaX_ = 0.f, emaY_ = 0.f;
+    FrameTime emaT_;            // 마지막 EMA 갱신 캡처 시각
+    bool emaInit_ = false;
+    BinocularFusion fusion_;    // 양눈 -> 가운데 시선 (한쪽 눈 프레임 오프셋 보정)
+    FrameTime fusionT_;
+    struct EyeEma { float x = 0.f, y = 0.f; FrameTime t; bool init = false; } emaL_, emaR_;
+    cv::Mat smallGray_;                 // 축소 얼굴 검출 입력
+    std::vector<cv::Rect> faces_, eyes_;    // 검출 결과 (용량 재사용)
+    FacePreprocessor facePre_;          // 위쪽 얼굴 equalizeHist + 평활 (프레임당 한 번)
+    std::vector<cv::Rect2f> eyeRel_;    // 마지막 눈 검출 결과 (얼굴 ROI 크기 기준 비율)
+    int eyeAge_ = 0;                    // 그 결과를 재사용한 프레임 수
+    MotionDetector motion_;             // 대기 모드 움직임 감지
+    PupilCache cacheL_, cacheR_;        // 눈별 동공 결과 캐시 (얼굴 중심 기준 왼쪽/오른쪽)
+    int cacheKey_ = -1;                 // 캐시를 채운 추정기 설정 (PupilImpl, coarse)
+    FrameTime standbyFaceT_;            // 대기 중 마지막 얼굴 확인 시각
+    uint64_t seq_ = 0;
+
+    std::atomic<bool> running_{ false };
+    std::atomic<bool> showDbg_{ true };
+    std::atomic<bool> standby_{ false };
+    std::atomic<PupilImpl> pupil_{ kDefaultPupilImpl };
+    std::atomic<bool> coarse_{ true };
+    FrameSignal* signal_ = nullptr;
+    std::thread worker_;
+
+    mutable std::mutex mtx_;
+    CameraGaze latest_;
+    bool recording_ = false;
+    std::vector<CameraGaze> recorded_;
+    DebugFrame debug_;
+    PupilCacheStats cacheStats_;
+};
@@ -0,0 +1,259 @@
+// CaptureController.cpp
+#include "CaptureController.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace cv;
+
+CaptureController::CaptureController(int camIndex, CaptureOptions opt)
+    : cam_(camIndex), opt_(opt)
+{
+}
+
+CaptureController::~CaptureController()
+{
+    clearHwCrop();
+#ifdef __linux__
+    if (v4lFd_ >= 0) ::close(v4lFd_);
+#endif
+}
+
+bool CaptureController::setResolution(Size size, double fps)
+{
+    // 스트리밍 중 해상도 변경: 백엔드가 내부적으로 스트림을 멈췄다 다시 시작 (수백 ms 끊김)
+    cap_.set(CAP_PROP_FRAME_WIDTH, size.width);
+    cap_.set(CAP_PROP_FRAME_HEIGHT, size.height);
+    cap_.set(CAP_PROP_FPS, fps);
+    fourccChecked_ = false;   // 해상도마다 드라이버가 다른 픽셀 형식을 고를 수 있음
+    Size got((int)cap_.get(CAP_PROP_FRAME_WIDTH), (int)cap_.get(CAP_PROP_FRAME_HEIGHT));
+    return got == size;
+}
+
+bool CaptureController::open()
+{
+    if (!cap_.open(cam_)) { std::cerr << "Camera " << cam_ << " open failed\n"; return false; }
+
+    // 기준 좌표계 = 실제로 받은 추적 해상도
+    setResolution(opt_.trackSize, opt_.trackFps);
+    canon_ = Size((int)cap_.get(CAP_PROP_FRAME_WIDTH), (int)cap_.get(CAP_PROP_FRAME_HEIGHT));
+    if (canon_.area() <= 0) canon_ = opt_.trackSize;
+    if (!opt_.adaptive) { mode_ = Mode::Fixed; return true; }
+
+    // 원본(YUYV)을 받아 crop 후 변환. 백엔드가 무시하거나 MJPEG면 첫 프레임에서 되돌림
+    rawYuyv_ = cap_.set(CAP_PROP_CONVERT_RGB, 0);
+    if (!setResolution(opt_.searchSize, opt_.searchFps))
+        std::cerr << "Camera " << cam_ << ": search resolution not supported, using "
+        << cap_.get(CAP_PROP_FRAME_WIDTH) << "x" << cap_.get(CAP_PROP_FRAME_HEIGHT) << "\n";
+    mode_ = Mode::Search;
+    return true;
+}
+
+const char* CaptureController::modeName() const
+{
+    switch (mode_) {
+    case Mode::Search: return "search";
+    case Mode::Track: return hwActive_ ? "track(hw crop)" : "track(crop)";
+    case Mode::Standby: return "standby";
+    default: return "full";
+    }
+}
+
+bool CaptureController::read(CapturedFrame& f, FramePool* pool)
+{
+    for (;;) {
+        // grab 직후를 캡처 시각으로 사용 (retrieve/디코딩 시간 제외)
+        if (!cap_.grab()) return false;
+        f.t = PipelineClock::now();
+        if (!cap_.retrieve(raw_) || raw_.empty()) return false;
+        if (raw_.type() == CV_8UC2 && !fourccChecked_) {
+            // 2채널 원본이 다 YUY2는 아님 (UYVY 등은 바이트 순서가 달라 색/그레이가 틀어짐) -> 모르면 백엔드 변환으로
+            fourccChecked_ = true;
+            const int fourcc = (int)cap_.get(CAP_PROP_FOURCC);
+            if (fourcc != VideoWriter::fourcc('Y', 'U', 'Y', 'V') && fourcc != VideoWriter::fourcc('Y', 'U', 'Y', '2')) {
+                std::cerr << "Camera " << cam_ << ": raw format is not YUYV, using backend conversion\n";
+                cap_.set(CAP_PROP_CONVERT_RGB, 1);
+                rawYuyv_ = false;
+                continue;
+            }
+        }
+        if (raw_.type() == CV_8UC3 || raw_.type() == CV_8UC2) break;
+        // 압축 원본(MJPEG 등)은 자를 수 없음 -> 백엔드 변환으로 되돌리고 다음 프레임
+        if (rawYuyv_) { cap_.set(CAP_PROP_CONVERT_RGB, 1); rawYuyv_ = false; continue; }
+        return false;
+    }
+    const bool yuyv = raw_.type() == CV_8UC2;
+    const Size full = raw_.size();
+
+    // 처리 영역 (원본 좌표 = 미러 전)
+    Rect src(0, 0, full.width, full.height);
+    f.roi = Rect(0, 0, canon_.width, canon_.height);
+    if (mode_ == Mode::Track && hwActive_) {
+        f.roi = roi_;   // 카메라가 이미 crop해서 보냄 (크기는 드라이버에 따라 crop 크기 또는 원래 크기)
+    }
+    else if (mode_ == Mode::Track) {
+        const double kx = full.width / (double)canon_.width, ky = full.height / (double)canon_.height;
+        int x = (int)((canon_.width - roi_.x - roi_.width) * kx);   // 미러 해제
+        int w = (int)(roi_.width * kx);
+        if (yuyv) { x &= ~1; w = (w + 1) & ~1; }                    // YUYV는 2픽셀 단위
+        src = Rect(x, (int)(roi_.y * ky), w, (int)(roi_.height * ky)) & src;
+        f.roi = Rect(canon_.width - (int)((src.x + src.width) / kx), (int)(src.y / ky),
+            (int)(src.width / kx), (int)(src.height / ky));
+    }
+
+    // 자른 부분만 반전 + 변환 (YUYV의 그레이는 Y 채널 추출이라 거의 공짜)
+    const Mat part = raw_(src);
+    FrameRef tmpBuf;
+    Mat tmpBgr = tmpBgr_, tmpGray = tmpGray_;
+    if (pool) {
+        f.bgrBuf = pool->acquire(part.size(), CV_8UC3);
+        f.grayBuf = pool->acquire(part.size(), CV_8UC1);
+        f.bgr = f.bgrBuf.mat(); f.gray = f.grayBuf.mat();
+        if (yuyv) {
+            // 변환 임시도 슬랩 하나: BGR 헤더와 같은 저장소 위의 1채널 헤더 (순서대로 쓰므로 겹쳐도 됨)
+            tmpBuf = pool->acquire(part.size(), CV_8UC3);
+            tmpBgr = tmpBuf.mat();
+            tmpGray = Mat(part.size(), CV_8UC1, tmpBgr.data);
+        }
+    }
+    else { f.bgrBuf.reset(); f.grayBuf.reset(); }
+    if (yuyv) {
+        cvtColor(part, tmpBgr, COLOR_YUV2BGR_YUY2);
+        flip(tmpBgr, f.bgr, 1);
+        cvtColor(part, tmpGray, COLOR_YUV2GRAY_YUY2);
+        flip(tmpGray, f.gray, 1);
+        if (!pool) { tmpBgr_ = tmpBgr; tmpGray_ = tmpGray; }   // 풀 없이: 다음 프레임에 같은 버퍼 재사용
+    }
+    else {
+        flip(part, f.bgr, 1);
+        cvtColor(f.bgr, f.gray, COLOR_BGR2GRAY);
+    }
+    f.sx = f.roi.width / (float)f.bgr.cols;
+    f.sy = f.roi.height / (float)f.bgr.rows;
+    f.tracking = mode_ == Mode::Track;
+    return true;
+}
+
+Rect CaptureController::cropAround(const Rect& face) const
+{
+    int mx = (int)(face.width * opt_.margin), my = (int)(face.height * opt_.margin);
+    return Rect(face.x - mx, face.y - my, face.width + 2 * mx, face.height + 2 * my)
+        & Rect(0, 0, canon_.width, canon_.height);
+}
+
+void CaptureController::update(bool face, const Rect& faceCanon, FrameTime t)
+{
+    if (mode_ == Mode::Standby) return;
+    if (face || !faceInit_) { lastFace_ = t; faceInit_ = true; }
+
+    // 얼굴 없는 시간이 길면 대기 (추적 모드는 먼저 탐색으로 떨어진 뒤)
+    if (!face && mode_ != Mode::Track && opt_.standbyAfterSec > 0.f && secondsBetween(lastFace_, t) >= opt_.standbyAfterSec) {
+        setResolution(opt_.standbySize, opt_.standbyFps);
+        mode_ = Mode::Standby;
+        std::cout << "[Capture] cam" << cam_ << " -> " << modeName() << "\n";
+        return;
+    }
+
+    if (mode_ == Mode::Fixed) return;
+    if (face) { ++hit_; miss_ = 0; }
+    else { ++miss_; hit_ = 0; }
+
+    if (mode_ == Mode::Search) {
+        if (hit_ < opt_.lockFrames) return;
+        roi_ = cropAround(faceCanon);
+        setResolution(opt_.trackSize, opt_.trackFps);
+        if (opt_.hwCrop && !hwFailed_) {
+            hwActive_ = applyHwCrop(roi_);
+            hwFailed_ = !hwActive_;
+        }
+        mode_ = Mode::Track;
+        std::cout << "[Capture] cam" << cam_ << " -> " << modeName() << "\n";
+        return;
+    }
+
+    // 추적 모드
+    if (face) {
+        Rect want = cropAround(faceCanon);
+        if (!hwActive_) { roi_ = want; return; }
+        // 하드웨어 crop은 ioctl이 비싸므로 얼굴이 crop 가장자리 여유의 절반 안쪽을 벗어날 때만 다시 설정
+        int ix = (int)(faceCanon.width * opt_.margin * 0.5f), iy = (int)(faceCanon.height * opt_.margin * 0.5f);
+        Rect inner(roi_.x + ix, roi_.y + iy, roi_.width - 2 * ix, roi_.height - 2 * iy);
+        if ((faceCanon & inner) != faceCanon && !applyHwCrop(want)) {
+            clearHwCrop();
+            hwFailed_ = true;
+            roi_ = want;
+        }
+    }
+    else if (miss_ >= opt_.lossFrames) {
+        clearHwCrop();
+        setResolution(opt_.searchSize, opt_.searchFps);
+        mode_ = Mode::Search;
+        hit_ = 0;
+        std::cout << "[Capture] cam" << cam_ << " -> " << modeName() << "\n";
+    }
+}
+
+void CaptureController::wake()
+{
+    if (mode_ != Mode::Standby) return;
+    if (opt_.adaptive) { setResolution(opt_.searchSize, opt_.searchFps); mode_ = Mode::Search; }
+    else { setResolution(opt_.trackSize, opt_.trackFps); mode_ = Mode::Fixed; }
+    hit_ = miss_ = 0;
+    faceInit_ = false;   // 다음 update부터 다시 standbyAfterSec를 셈
+    std::cout << "[Capture] cam" << cam_ << " -> " << modeName() << "\n";
+}
+
+bool CaptureController::applyHwCrop(const Rect& canonRoi)
+{
+#ifdef __linux__
+    if (v4lFd_ < 0) v4lFd_ = ::open(("/dev/video" + std::to_string(cam_)).c_str(), O_RDWR | O_NONBLOCK);
+    if (v4lFd_ < 0) return false;
+
+    v4l2_selection bounds = {};
+    bounds.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    bounds.target = V4L2_SEL_TGT_CROP_BOUNDS;
+    if (ioctl(v4lFd_, VIDIOC_G_SELECTION, &bounds) < 0) return false;   // UVC 웹캠 대부분은 여기서 실패
+
+    // 기준 좌표(미러) -> 센서 좌표 (미러 해제 + 배율)
+    const double kx = bounds.r.width / (double)canon_.width, ky = bounds.r.height / (double)canon_.height;
+    v4l2_selection sel = {};
+    sel.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    sel.target = V4L2_SEL_TGT_CROP;
+    sel.r.left = bounds.r.left + (int)((canon_.width - canonRoi.x - canonRoi.width) * kx);
+    sel.r.top = bounds.r.top + (int)(canonRoi.y * ky);
+    sel.r.width = (uint32_t)(canonRoi.width * kx);
+    sel.r.height = (uint32_t)(canonRoi.height * ky);
+    if (ioctl(v4lFd_, VIDIOC_S_SELECTION, &sel) < 0) return false;      // 스트리밍 중 변경 불가(EBUSY) 포함
+
+    // 드라이버가 정렬/제한한 실제 영역을 기준 좌표로 되돌림
+    roi_ = Rect(canon_.width - (int)((sel.r.left - bounds.r.left + (int)sel.r.width) / kx),
+        (int)((sel.r.top - bounds.r.top) / ky), (int)(sel.r.width / kx), (int)(sel.r.height / ky))
+        & Rect(0, 0, canon_.width, canon_.height);
+    return true;
+#else
+    (void)canonRoi;
+    return false;
+#endif
+}
+
+void CaptureController::clearHwCrop()
+{
+#ifdef __linux__
+    if (!hwActive_ || v4lFd_ < 0) { hwActive_ = false; return; }
+    v4l2_selection def = {};
+    def.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    def.target = V4L2_SEL_TGT_CROP_DEFAULT;
+    if (ioctl(v4lFd_, VIDIOC_G_SELECTION, &def) == 0) {
+        def.target = V4L2_SEL_TGT_CROP;
+        ioctl(v4lFd_, VIDIOC_S_SELECTION, &def);
+    }
+#endif
+    hwActive_ = false;
+}
@@ -0,0 +1,92 @@
+// CaptureController.h
+// 카메라 캡처 모드 관리: 얼굴 탐색 중에는 저해상도/고FPS, 얼굴을 잡으면 고해상도 + 얼굴 주변만 처리,
+// 얼굴이 한동안 없으면 대기(standby): 최저 해상도/FPS로 움직임만 확인
+#pragma once
+#include <opencv2/opencv.hpp>
+#include "FramePool.h"
+#include "PipelineClock.h"
+
+struct CaptureOptions {
+    bool adaptive = true;                   // false = 예전처럼 trackSize 전체 프레임 고정
+    cv::Size searchSize = cv::Size(640, 360);
+    double searchFps = 60.0;
+    cv::Size trackSize = cv::Size(1280, 720);
+    double trackFps = 30.0;
+    int lockFrames = 3;                     // 연속 얼굴 검출 N프레임 -> 추적 모드
+    int lossFrames = 8;                     // 추적 중 연속 미검출 N프레임 -> 탐색 모드
+    float margin = 0.5f;                    // crop = 얼굴 박스 + 얼굴 크기 x margin (사방)
+    bool hwCrop = true;                     // 추적 모드에서 V4L2 하드웨어 crop 먼저 시도 (Linux)
+    float standbyAfterSec = 30.f;           // 얼굴 없이 이만큼 지나면 대기 모드 (0 = 끔)
+    cv::Size standbySize = cv::Size(320, 180);
+    double standbyFps = 5.0;
+};
+
+// 한 프레임: 처리 영역(crop 또는 전체)의 BGR/그레이와 기준 좌표계로 되돌리는 정보
+// 기준 좌표계 = 추적 해상도(trackSize) 전체 프레임, 좌우 반전(미러) 적용 후
+struct CapturedFrame {
+    FrameTime t;                // grab 직후 시각
+    cv::Mat bgr, gray;          // 처리 영역 (미러 적용)
+    FrameRef bgrBuf, grayBuf;   // 풀에서 받았으면 bgr/gray의 저장소 (다른 스레드로 넘길 때는 이걸로)
+    cv::Rect roi;               // 처리 영역이 기준 좌표계에서 차지하는 영역
+    float sx = 1.f, sy = 1.f;   // 기준 px / 처리 영역 px
+    bool tracking = false;
+
+    cv::Rect toCanonical(const cv::Rect& r) const {
+        return cv::Rect(roi.x + cvRound(r.x * sx), roi.y + cvRound(r.y * sy), cvRound(r.width * sx), cvRound(r.height * sy));
+    }
+};
+
+/**
+ * @class CaptureController
+ * @brief 탐색 모드: searchSize/searchFps로 전체 프레임을 받아 얼굴을 찾습니다.
+ * 추적 모드: trackSize로 올리고 얼굴 주변만 씁니다. V4L2 crop이 되면 카메라가 그 영역만 보내고
+ * (버스 대역폭 감소), 안 되면 원본(가능하면 YUYV, 변환 전)에서 잘라 그 부분만 반전/변환합니다.
+ * 얼굴을 lossFrames 동안 놓치면 전체 프레임 탐색으로 돌아갑니다.
+ * 탐색(또는 고정) 모드에서 standbyAfterSec 동안 얼굴이 없으면 대기 모드: standbySize/standbyFps로 내리고
+ * 검출은 호출자가 건너뜁니다(CameraPipeline은 움직임 감지만). wake()로 원래 모드/해상도로 돌아갑니다.
+ * 결과 좌표는 항상 기준 좌표계라서 모드가 바뀌어도 하위 로직은 그대로입니다.
+ */
+class CaptureController {
+public:
+    CaptureController(int camIndex, CaptureOptions opt);
+    ~CaptureController();
+
+    // 카메라 열기 (실패 시 false, 에러는 stderr)
+    bool open();
+    // grab + 시각 + retrieve + crop + 반전/변환. 카메라 끊김 시 false
+    // pool이 있으면 bgr/gray(와 YUYV 변환 임시 버퍼)를 풀 슬랩에 바로 씀 (매 프레임 할당 없음)
+    bool read(CapturedFrame& f, FramePool* pool = nullptr);
+    // 이번 프레임 검출 결과로 모드/crop 갱신 (faceCanon: 기준 좌표계 얼굴 박스, t: 캡처 시각)
+    void update(bool face, const cv::Rect& faceCanon, FrameTime t);
+    // 대기 모드 -> 탐색(고정) 모드. 해상도 전환은 여기서 (백엔드에 따라 수백 ms)
+    void wake();
+    bool standby() const { return mode_ == Mode::Standby; }
+
+    cv::Size canonicalSize() const { return canon_; }
+    const char* modeName() const;
+
+private:
+    enum class Mode { Fixed, Search, Track, Standby };
+
+    bool setResolution(cv::Size size, double fps);
+    cv::Rect cropAround(const cv::Rect& faceCanon) const;
+    bool applyHwCrop(const cv::Rect& canonRoi);   // 성공 시 roi_를 드라이버가 맞춘 영역으로 갱신
+    void clearHwCrop();
+
+    int cam_;
+    CaptureOptions opt_;
+    cv::VideoCapture cap_;
+    cv::Size canon_;            // 실제 추적 해상도
+    Mode mode_ = Mode::Fixed;
+    bool rawYuyv_ = false;      // CONVERT_RGB를 끄고 YUYV 원본을 받는 중
+    bool fourccChecked_ = false;   // 2채널 원본이 YUYV인지 확인함 (해상도를 바꾸면 다시 확인)
+    int hit_ = 0, miss_ = 0;
+    FrameTime lastFace_;        // 마지막으로 얼굴을 본 캡처 시각 (대기 진입 기준)
+    bool faceInit_ = false;
+    cv::Rect roi_;              // 추적 모드 처리 영역 (기준 좌표)
+    bool hwActive_ = false;     // 하드웨어 crop 적용 중
+    bool hwFailed_ = false;     // 드라이버가 crop을 거부함 -> 이후 디지털 crop만
+    int v4lFd_ = -1;
+    cv::Mat raw_;
+    cv::Mat tmpBgr_, tmpGray_;  // 풀 없이 YUYV 변환할 때의 임시 (프레임 사이 재사용)
+};
@@ -0,0 +1,43 @@
+// CpuMeter.cpp
+#include "CpuMeter.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+void CpuMeter::reset()
+{
+    wall_ = PipelineClock::now();
+    cpu_ = processCpuSeconds();
+}
+
+float CpuMeter::lap(float* seconds)
+{
+    const FrameTime now = PipelineClock::now();
+    const double cpu = processCpuSeconds();
+    const float wall = secondsBetween(wall_, now);
+    const float pct = wall > 0.f ? (float)((cpu - cpu_) / wall * 100.0) : 0.f;
+    if (seconds) *seconds = wall;
+    wall_ = now; cpu_ = cpu;
+    return pct;
+}
+
+double CpuMeter::processCpuSeconds()
+{
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) return 0.0;
+    auto toSec = [](const FILETIME& ft) {
+        ULARGE_INTEGER v; v.LowPart = ft.dwLowDateTime; v.HighPart = ft.dwHighDateTime;
+        return v.QuadPart * 1e-7;   // 100ns 단위
+        };
+    return toSec(kernel) + toSec(user);
+#else
+    rusage ru = {};
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0.0;
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+#endif
+}
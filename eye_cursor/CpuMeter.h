@@ -0,0 +1,22 @@
+// CpuMeter.h
+// 프로세스 CPU 사용률 측정 (모든 스레드 합, 코어 하나 = 100%): 대기 모드 전후 소비 비교용
+#pragma once
+#include "PipelineClock.h"
+
+/**
+ * @class CpuMeter
+ * @brief lap()은 직전 lap() 이후 구간의 평균 CPU 사용률(%)과 구간 길이를 돌려주고 기준을 다시 잡습니다.
+ * Windows는 GetProcessTimes, 그 밖은 getrusage(RUSAGE_SELF)의 사용자 + 커널 시간.
+ */
+class CpuMeter {
+public:
+    CpuMeter() { reset(); }
+    void reset();
+    // 반환: CPU % (코어 하나 기준, 코어 수만큼 넘을 수 있음). seconds: 구간 길이 (선택)
+    float lap(float* seconds = nullptr);
+
+private:
+    static double processCpuSeconds();
+    FrameTime wall_;
+    double cpu_ = 0.0;
+};
@@ -0,0 +1,159 @@
+// CursorOutput.cpp
+#include "CursorOutput.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include "GazeModel.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002   // Windows 10 1803+ SDK
+#endif
+#endif
+
+using namespace cv;
+
+CursorOutput::CursorOutput(const ScreenTopology& screens, CursorOutputOptions opt)
+    : screens_(screens), opt_(opt), rate_(opt.rateHz > 0.f ? opt.rateHz : displayRateHz(screens))
+{
+}
+
+CursorOutput::~CursorOutput()
+{
+    stop();
+}
+
+float CursorOutput::displayRateHz(const ScreenTopology& screens)
+{
+    float hz = 0.f;
+#ifdef _WIN32
+    // 모니터마다 주사율이 다르면 가장 빠른 쪽 (느린 모니터에선 한 번 더 부르는 것뿐)
+    for (const MonitorInfo& m : screens.monitors()) {
+        DEVMODEA dm = {};
+        dm.dmSize = sizeof(dm);
+        if (EnumDisplaySettingsA(m.name.c_str(), ENUM_CURRENT_SETTINGS, &dm) && dm.dmDisplayFrequency > 1)
+            hz = std::max(hz, (float)dm.dmDisplayFrequency);   // 0, 1 = 하드웨어 기본값 (모름)
+    }
+#else
+    (void)screens;
+#endif
+    return hz > 0.f ? std::clamp(hz, 30.f, 500.f) : 60.f;
+}
+
+void CursorOutput::start()
+{
+    if (running_.exchange(true)) return;
+    worker_ = std::thread(&CursorOutput::run, this);
+}
+
+void CursorOutput::stop()
+{
+    if (!running_.exchange(false)) return;
+    if (worker_.joinable()) worker_.join();
+}
+
+Point2f CursorOutput::Track::at(FrameTime now, float maxExtrapSec) const
+{
+    if (!moving) return p;
+    const float dt = std::clamp(secondsBetween(t, now), 0.f, maxExtrapSec);
+    return p + v * dt;
+}
+
+bool CursorOutput::predict(FrameTime now, Point2f& out) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (!have_) return false;
+    const float s = blend_ > 0.f ? std::clamp(secondsBetween(switchT_, now) / blend_, 0.f, 1.f) : 1.f;
+    out = prev_.at(now, opt_.maxExtrapSec) * (1.f - s) + cur_.at(now, opt_.maxExtrapSec) * s;
+    return true;
+}
+
+void CursorOutput::push(Point2f p, FrameTime t)
+{
+    const FrameTime now = PipelineClock::now();
+    Point2f shown;
+    const bool had = predict(now, shown);
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    const float dt = had ? secondsBetween(cur_.t, t) : 0.f;
+    Track next;
+    next.p = p; next.t = t;
+    if (had && dt > 0.f && dt <= opt_.maxGapSec) {
+        // 속도: 순간 속도(px/s)의 EMA, 정지 상태에서 시작하면 0에서 출발
+        const Point2f vInst = (p - cur_.p) * (1.f / dt);
+        const Point2f v0 = cur_.moving ? cur_.v : Point2f();
+        const float a = emaAlpha(dt, opt_.velTauSec);
+        next.v = Point2f(ema1(v0.x, vInst.x, a), ema1(v0.y, vInst.y, a));
+        next.moving = true;
+        interval_ = ema1(interval_, dt, 0.2f);
+    }
+    else if (had && dt <= 0.f) return;   // 같은/이전 캡처 시각 (다른 카메라가 늦게 도착) -> 무시
+
+    if (had) {
+        // 지금 화면에 보이는 궤적에서 출발해 새 궤적으로 넘어감 (전환 도중 또 와도 끊김 없음)
+        prev_.p = shown; prev_.v = cur_.moving ? cur_.v : Point2f();
+        prev_.t = now; prev_.moving = cur_.moving;
+        blend_ = opt_.blendSec > 0.f ? opt_.blendSec : interval_;
+    }
+    else {
+        prev_ = next;
+        blend_ = 0.f;
+    }
+    cur_ = next;
+    switchT_ = now;
+    have_ = true;
+}
+
+void CursorOutput::gap()
+{
+    const FrameTime now = PipelineClock::now();
+    Point2f shown;
+    if (!predict(now, shown)) return;
+    std::lock_guard<std::mutex> lk(mtx_);
+    cur_.p = shown; cur_.v = Point2f();
+    cur_.moving = false;   // t는 마지막 캡처 시각 그대로 (다음 push의 간격 계산용)
+    prev_ = cur_;
+    blend_ = 0.f;
+}
+
+void CursorOutput::run()
+{
+    const auto period = std::chrono::duration_cast<PipelineClock::duration>(std::chrono::duration<double>(1.0 / rate_));
+#ifdef _WIN32
+    // 기본 Sleep 해상도(15.6ms)로는 144Hz를 못 맞춤 -> 고해상도 대기 타이머, 없으면 일반 타이머
+    HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timer) timer = CreateWaitableTimerW(nullptr, TRUE, nullptr);
+#endif
+    FrameTime next = PipelineClock::now();
+    Point last(INT_MIN, INT_MIN);
+    while (running_.load()) {
+        next += period;
+        FrameTime now = PipelineClock::now();
+        if (now - next > period) next = now;   // 밀렸으면 따라잡지 말고 다시 시작
+#ifdef _WIN32
+        if (timer && next > now) {
+            LARGE_INTEGER due;
+            due.QuadPart = -(LONGLONG)(std::chrono::duration_cast<std::chrono::nanoseconds>(next - now).count() / 100);
+            if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE)) WaitForSingleObject(timer, INFINITE);
+        }
+        else std::this_thread::sleep_until(next);
+#else
+        std::this_thread::sleep_until(next);
+#endif
+        Point2f p;
+        if (!active_.load()) { last = Point(INT_MIN, INT_MIN); continue; }
+        if (!predict(PipelineClock::now(), p)) continue;
+        // 모니터 사이 빈 곳은 가장 가까운 모니터 안으로
+        const Point q = screens_.clamp(p);
+        if (q == last) continue;
+        last = q;
+#ifdef _WIN32
+        SetCursorPos(q.x, q.y);
+#endif
+    }
+#ifdef _WIN32
+    if (timer) CloseHandle(timer);
+#endif
+}
@@ -0,0 +1,73 @@
+// CursorOutput.h
+// 디스플레이 주사율 커서 출력: 카메라 프레임마다 받은 화면 시선(캡처 시각 포함)으로 속도를 추정하고,
+// 별도 스레드가 모니터 주사율로 "지금" 위치를 외삽해 SetCursorPos -> 30fps 카메라에서도 144Hz 모니터에 계단 없이
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "PipelineClock.h"
+#include "ScreenTopology.h"
+
+struct CursorOutputOptions {
+    bool enabled = true;            // false: 예전처럼 검출 루프에서 바로 SetCursorPos
+    float rateHz = 0.f;             // 출력 주기 (0 = 모니터 주사율 중 최대, 못 읽으면 60)
+    float velTauSec = 0.05f;        // 속도 추정 EMA 시정수 (캡처 간격 기준)
+    float blendSec = 0.f;           // 새 샘플이 오면 이전 궤적 -> 새 궤적으로 넘어가는 시간 (0 = 측정한 카메라 간격)
+    float maxExtrapSec = 0.1f;      // 마지막 샘플 이후 외삽 상한 (넘으면 그 자리에 멈춤)
+    float maxGapSec = 0.2f;         // 샘플 간격이 이보다 길면 속도 리셋 (추적 재개)
+};
+
+/**
+ * @class CursorOutput
+ * @brief 검출 루프는 push(화면 좌표, 캡처 시각)만 부르고, 출력 스레드가 주사율마다
+ * 궤적 p(t) = p_last + v * min(t - t_last, maxExtrapSec)를 현재 시각에서 계산해 커서를 옮깁니다.
+ * 새 샘플이 오면 궤적이 바뀌므로 blendSec 동안 이전 궤적과 새 궤적을 선형으로 섞어 점프를 없앱니다.
+ * 외삽 기준이 캡처 시각이라 캡처 -> 출력 지연만큼 앞을 예측하게 되고, 위치 필터를 더 넣지 않으므로 필터 지연도 늘지 않습니다.
+ * 출력 타이머는 Windows 고해상도 대기 타이머(없으면 sleep_until). 정수 위치가 같으면 SetCursorPos를 생략합니다.
+ */
+class CursorOutput {
+public:
+    CursorOutput(const ScreenTopology& screens, CursorOutputOptions opt = CursorOutputOptions());
+    ~CursorOutput();
+
+    void start();
+    void stop();
+
+    // 매핑된 화면 좌표 (가상 데스크톱 px)와 그 캡처 시각
+    void push(cv::Point2f p, FrameTime t);
+    // 추적이 끊김: 마지막 위치에 멈추고 다음 샘플에서 속도를 새로 시작
+    void gap();
+    // false면 위치는 계속 추정하되 커서는 안 건드림 (제어 끔, 캘리브레이션 중)
+    void setActive(bool on) { active_.store(on); }
+
+    float rateHz() const { return rate_; }
+    // 현재 시각 기준 예측 위치 (출력 스레드와 같은 계산, 디버그/HUD용)
+    bool predict(FrameTime now, cv::Point2f& out) const;
+
+private:
+    struct Track {
+        cv::Point2f p, v;           // 마지막 샘플 위치, 속도 (px/s)
+        FrameTime t;                // 마지막 샘플 캡처 시각
+        bool moving = false;        // false = 속도 0으로 정지
+        cv::Point2f at(FrameTime now, float maxExtrapSec) const;
+    };
+
+    void run();
+    static float displayRateHz(const ScreenTopology& screens);
+
+    ScreenTopology screens_;
+    CursorOutputOptions opt_;
+    float rate_;
+
+    mutable std::mutex mtx_;        // 아래 궤적 상태 (push와 출력 스레드 사이, 둘 다 짧게 잡음)
+    bool have_ = false;
+    Track cur_, prev_;              // 새 궤적, 섞는 중인 이전 궤적
+    FrameTime switchT_;             // 궤적을 바꾼 시각 (출력 시계)
+    float blend_ = 0.f;             // 이번 전환 길이 (초)
+    float interval_ = 1.f / 30.f;   // 카메라 간격 추정 (EMA)
+
+    std::atomic<bool> active_{ false };
+    std::atomic<bool> running_{ false };
+    std::thread worker_;
+};
@@ -0,0 +1,47 @@
+// FixationDetector.cpp
+#include "FixationDetector.h"
+#include <algorithm>
+
+FixationDetector::FixationDetector(float maxDispersion, std::chrono::milliseconds minDuration)
+    : maxDispersion_(maxDispersion), minDuration_(minDuration)
+{
+}
+
+void FixationDetector::reset()
+{
+    active_ = false;
+    fixating_ = false;
+}
+
+void FixationDetector::restart(float x, float y, FrameTime t)
+{
+    active_ = true;
+    start_ = last_ = t;
+    minX_ = maxX_ = x;
+    minY_ = maxY_ = y;
+}
+
+FixationDetector::Event FixationDetector::update(float x, float y, FrameTime t)
+{
+    if (!active_) { restart(x, y, t); return Event::None; }
+
+    float nMinX = std::min(minX_, x), nMaxX = std::max(maxX_, x);
+    float nMinY = std::min(minY_, y), nMaxY = std::max(maxY_, y);
+    if ((nMaxX - nMinX) + (nMaxY - nMinY) > maxDispersion_) {
+        // 범위 이탈 -> 진행 중이던 응시 종료, 현재 샘플부터 새 후보
+        bool wasFixating = fixating_;
+        if (wasFixating)
+            lastDuration_ = std::chrono::duration_cast<std::chrono::milliseconds>(last_ - start_);
+        fixating_ = false;
+        restart(x, y, t);
+        return wasFixating ? Event::End : Event::None;
+    }
+
+    minX_ = nMinX; maxX_ = nMaxX; minY_ = nMinY; maxY_ = nMaxY;
+    last_ = t;
+    if (!fixating_ && t - start_ >= minDuration_) {
+        fixating_ = true;
+        return Event::Start;
+    }
+    return Event::None;
+}
@@ -0,0 +1,38 @@
+// FixationDetector.h
+#pragma once
+#include "PipelineClock.h"
+
+/**
+ * @class FixationDetector
+ * @brief 분산 기준(I-DT) 응시 검출. 샘플마다 O(1).
+ * 현재 후보 구간의 x/y 범위 합이 maxDispersion 이하로 minDuration 이상 유지되면 응시 시작,
+ * 범위를 벗어나면 응시 끝. 입력은 정규화 시선(emaX, emaY) 기준.
+ */
+class FixationDetector {
+public:
+    enum class Event { None, Start, End };
+
+    explicit FixationDetector(float maxDispersion = 0.06f,
+        std::chrono::milliseconds minDuration = std::chrono::milliseconds(100));
+
+    // 샘플 1개 반영. Start면 centerX/Y, End면 지속 시간이 유효
+    Event update(float x, float y, FrameTime t);
+    void reset();
+
+    bool fixating() const { return fixating_; }
+    float centerX() const { return (minX_ + maxX_) * 0.5f; }
+    float centerY() const { return (minY_ + maxY_) * 0.5f; }
+    // 직전 End 이벤트의 응시 지속 시간
+    std::chrono::milliseconds lastDuration() const { return lastDuration_; }
+
+private:
+    void restart(float x, float y, FrameTime t);
+
+    float maxDispersion_;
+    std::chrono::milliseconds minDuration_;
+    bool active_ = false;       // 후보 구간 존재
+    bool fixating_ = false;
+    FrameTime start_, last_;
+    float minX_ = 0.f, maxX_ = 0.f, minY_ = 0.f, maxY_ = 0.f;
+    std::chrono::milliseconds lastDuration_{ 0 };
+};
@@ -0,0 +1,113 @@
+// FramePool.cpp
+#include "FramePool.h"
+#include <algorithm>
+#include <cstring>
+#include "PipelineClock.h"
+
+using namespace cv;
+
+FrameRef& FrameRef::operator=(const FrameRef& o)
+{
+    if (this == &o) return *this;
+    FrameRef tmp(o);
+    *this = std::move(tmp);
+    return *this;
+}
+
+FrameRef& FrameRef::operator=(FrameRef&& o) noexcept
+{
+    if (this == &o) return *this;
+    release();
+    slot_ = o.slot_; o.slot_ = nullptr;
+    m_ = std::move(o.m_);
+    return *this;
+}
+
+void FrameRef::release()
+{
+    Slot* s = slot_;
+    slot_ = nullptr;
+    if (s && s->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) s->pool->giveBack(s);
+}
+
+FramePool::FramePool(FramePoolOptions opt) : opt_(opt)
+{
+    opt_.capacity = std::max(1, opt_.capacity);
+    slots_.reset(new FrameRef::Slot[opt_.capacity]);
+    free_.reserve(opt_.capacity);
+    for (int i = 0; i < opt_.capacity; ++i) {
+        FrameRef::Slot& s = slots_[i];
+        s.pool = this;
+        s.index = i;
+        s.data = (uchar*)fastMalloc(opt_.slotBytes);   // CV_MALLOC_ALIGN(64) 정렬 -> SIMD 로드/캐시 라인 맞음
+        std::memset(s.data, 0, opt_.slotBytes);        // 페이지를 지금 건드려 둠 (첫 프레임들의 페이지 폴트 제거)
+        free_.push_back(i);
+    }
+    stats_.capacity = stats_.free = stats_.minFree = opt_.capacity;
+}
+
+FramePool::~FramePool()
+{
+    for (int i = 0; i < opt_.capacity; ++i) fastFree(slots_[i].data);
+}
+
+FrameRef FramePool::acquire(Size size, int type)
+{
+    return take(size, type, true);
+}
+
+FrameRef FramePool::tryAcquire(Size size, int type)
+{
+    return take(size, type, false);
+}
+
+FrameRef FramePool::take(Size size, int type, bool wait)
+{
+    const size_t bytes = (size_t)size.area() * CV_ELEM_SIZE(type);
+    std::unique_lock<std::mutex> lk(mtx_);
+    ++stats_.acquires;
+    if (bytes > opt_.slotBytes) {
+        ++stats_.oversize;
+        lk.unlock();
+        return FrameRef::wrap(Mat(size, type));
+    }
+    if (free_.empty()) {
+        if (!wait) { ++stats_.dry; return FrameRef(); }
+        ++stats_.waits;
+        const FrameTime t0 = PipelineClock::now();
+        cv_.wait_for(lk, opt_.wait, [&] { return !free_.empty(); });
+        stats_.waitMs += secondsBetween(t0, PipelineClock::now()) * 1000.0;
+        if (free_.empty()) {
+            ++stats_.fallbacks;
+            lk.unlock();
+            return FrameRef::wrap(Mat(size, type));
+        }
+    }
+    FrameRef::Slot* s = &slots_[free_.back()];
+    free_.pop_back();
+    stats_.free = (int)free_.size();
+    stats_.minFree = std::min(stats_.minFree, stats_.free);
+    lk.unlock();
+
+    s->refs.store(1, std::memory_order_relaxed);
+    FrameRef r;
+    r.slot_ = s;
+    r.m_ = Mat(size, type, s->data);   // 연속 헤더 (Mat이 소유하지 않음, 수명은 슬랩 참조 카운트)
+    return r;
+}
+
+void FramePool::giveBack(FrameRef::Slot* s)
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        free_.push_back(s->index);
+        stats_.free = (int)free_.size();
+    }
+    cv_.notify_one();
+}
+
+FramePoolStats FramePool::stats() const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return stats_;
+}
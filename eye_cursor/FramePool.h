@@ -0,0 +1,107 @@
+// FramePool.h
+// 고정 개수 프레임 버퍼 풀: 미리 할당(64바이트 정렬 + 페이지 미리 건드림)한 슬랩을 참조 카운트 핸들로 빌려주고
+// 마지막 핸들이 사라지면 자동 반납 -> 캡처/검출/화면 스레드 사이를 오가는 프레임에 매 프레임 malloc/페이지 폴트 없음
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class FramePool;
+
+/**
+ * @class FrameRef
+ * @brief 풀 슬랩 위의 Mat 헤더 + 참조 카운트. 복사하면 같은 슬랩을 공유하고(원자적 증가, 할당 없음),
+ * 마지막 FrameRef가 사라질 때 슬랩이 풀로 돌아갑니다. mat()의 헤더를 따로 복사해 들고 있으면 슬랩을 붙잡지 않으므로
+ * 스레드를 넘길 때는 FrameRef로 넘깁니다. 풀이 바닥나 힙에서 받은 프레임(pooled() == false)도 같은 방식으로 씁니다.
+ * 풀은 모든 FrameRef보다 오래 살아야 합니다.
+ */
+class FrameRef {
+public:
+    FrameRef() = default;
+    FrameRef(const FrameRef& o) : slot_(o.slot_), m_(o.m_) { retain(); }
+    FrameRef(FrameRef&& o) noexcept : slot_(o.slot_), m_(std::move(o.m_)) { o.slot_ = nullptr; }
+    FrameRef& operator=(const FrameRef& o);
+    FrameRef& operator=(FrameRef&& o) noexcept;
+    ~FrameRef() { release(); }
+
+    // 풀 밖의 Mat을 감쌈 (풀 없이 쓰는 경로, 힙 대체)
+    static FrameRef wrap(const cv::Mat& m) { FrameRef r; r.m_ = m; return r; }
+
+    cv::Mat& mat() { return m_; }
+    const cv::Mat& mat() const { return m_; }
+    bool empty() const { return m_.empty(); }
+    bool pooled() const { return slot_ != nullptr; }
+    void reset() { release(); m_ = cv::Mat(); }
+
+private:
+    friend class FramePool;
+    struct Slot {
+        FramePool* pool = nullptr;
+        uchar* data = nullptr;
+        int index = 0;
+        std::atomic<int> refs{ 0 };
+    };
+    void retain() { if (slot_) slot_->refs.fetch_add(1, std::memory_order_relaxed); }
+    void release();
+
+    Slot* slot_ = nullptr;
+    cv::Mat m_;
+};
+
+struct FramePoolOptions {
+    int capacity = 8;                           // 슬랩 개수
+    size_t slotBytes = 1280 * 720 * 3;          // 슬랩 하나 크기 (가장 큰 프레임, 보통 기준 해상도 BGR)
+    std::chrono::milliseconds wait{ 20 };       // 바닥났을 때 반납을 기다리는 최대 시간 (그다음은 힙)
+};
+
+// 풀 압력 지표
+struct FramePoolStats {
+    int capacity = 0;
+    int free = 0;               // 지금 남은 슬랩
+    int minFree = 0;            // 지금까지 가장 적게 남았을 때 (0이면 바닥난 적 있음)
+    uint64_t acquires = 0;
+    uint64_t waits = 0;         // 바닥나서 기다린 횟수 (역압)
+    double waitMs = 0.0;        // 기다린 시간 합
+    uint64_t fallbacks = 0;     // 기다려도 없어서 힙에서 받은 수
+    uint64_t dry = 0;           // 기다리지 않는 요청(tryAcquire)이 빈손으로 돌아간 수
+    uint64_t oversize = 0;      // 슬랩보다 커서 힙에서 받은 수
+};
+
+/**
+ * @class FramePool
+ * @brief acquire(size, type)는 빈 슬랩 위에 연속(continuous) Mat 헤더를 만들어 돌려줍니다. 크기가 프레임마다 달라도
+ * (추적 모드 crop) 슬랩 안에 들어가면 같은 슬랩을 씁니다. OpenCV 함수에 출력으로 넘기면 크기/타입이 맞아 재할당 없이 그 자리에 씁니다.
+ * 바닥나면 wait 동안 반납을 기다리고(역압: 생산 스레드가 소비 속도에 맞춰짐), 그래도 없으면 힙에서 받고 fallbacks를 셉니다.
+ * tryAcquire는 기다리지 않고 빈 FrameRef (디버그 화면처럼 빠져도 되는 프레임용).
+ */
+class FramePool {
+public:
+    explicit FramePool(FramePoolOptions opt = FramePoolOptions());
+    ~FramePool();
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    FrameRef acquire(cv::Size size, int type);
+    FrameRef tryAcquire(cv::Size size, int type);
+
+    FramePoolStats stats() const;
+    const FramePoolOptions& options() const { return opt_; }
+
+private:
+    friend class FrameRef;
+    FrameRef take(cv::Size size, int type, bool wait);
+    void giveBack(FrameRef::Slot* s);
+
+    FramePoolOptions opt_;
+    std::unique_ptr<FrameRef::Slot[]> slots_;
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<int> free_;     // 빈 슬랩 번호 (capacity만큼 미리 잡아 둠 -> push/pop 할당 없음)
+    FramePoolStats stats_;
+};
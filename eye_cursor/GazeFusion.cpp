@@ -0,0 +1,82 @@
+// GazeFusion.cpp
+#include "GazeFusion.h"
+
+bool CameraCalib::fit()
+{
+    std::vector<Sample> l, r;
+    for (const Sample& s : samples) {
+        if (s.leftOk) { Sample e = s; e.nx = s.lx; e.ny = s.ly; l.push_back(e); }
+        if (s.rightOk) { Sample e = s; e.nx = s.rx; e.ny = s.ry; r.push_back(e); }
+    }
+    ready = model.fit(samples);
+    leftReady = ready && leftModel.fit(l);
+    rightReady = ready && rightModel.fit(r);
+    return ready;
+}
+
+// 보이는 눈마다 자기 모델로 매핑 -> 신뢰도 가중 평균. 쓸 수 있는 눈이 없으면 false
+static bool mapEyes(const CameraCalib& c, const CameraGaze& g, float& sx, float& sy) {
+    float w = 0.f, x = 0.f, y = 0.f, ex, ey;
+    if (g.left.ok && c.leftReady && c.leftModel.map(g.left.emaX, g.left.emaY, ex, ey)) {
+        x += g.left.conf * ex; y += g.left.conf * ey; w += g.left.conf;
+    }
+    if (g.right.ok && c.rightReady && c.rightModel.map(g.right.emaX, g.right.emaY, ex, ey)) {
+        x += g.right.conf * ex; y += g.right.conf * ey; w += g.right.conf;
+    }
+    if (w <= 0.f) return false;
+    sx = x / w; sy = y / w;
+    return true;
+}
+
+FusedGaze fuseGaze(const std::vector<CameraGaze>& cams,
+    const std::vector<CameraCalib>& calib,
+    std::chrono::milliseconds alignWindow)
+{
+    FusedGaze out;
+
+    // 기준 시각 = 결과가 있는 카메라 중 가장 최근 캡처
+    bool any = false;
+    for (const CameraGaze& g : cams) {
+        if (g.seq == 0) continue;
+        if (!any || g.t > out.t) out.t = g.t;
+        any = true;
+    }
+    if (!any) return out;
+
+    float wSum = 0.f, wMapSum = 0.f, faceArea = 0.f;
+    for (size_t i = 0; i < cams.size(); ++i) {
+        const CameraGaze& g = cams[i];
+        if (g.seq == 0 || out.t - g.t > alignWindow) continue;   // 오래된 관측 제외
+
+        if (g.face && (float)g.faceBox.area() > faceArea) {
+            faceArea = (float)g.faceBox.area();
+            out.face = true; out.faceCam = g.cam; out.faceBox = g.faceBox;
+        }
+        out.leftSeen = out.leftSeen || g.left.ok;
+        out.rightSeen = out.rightSeen || g.right.ok;
+        if (g.left.ok && (!out.left.ok || g.left.conf > out.left.conf)) out.left = g.left;
+        if (g.right.ok && (!out.right.ok || g.right.conf > out.right.conf)) out.right = g.right;
+        if (!g.got) continue;
+
+        // 카메라 가중치 = 보이는 눈들의 신뢰도 합
+        float w = (g.left.ok ? g.left.conf : 0.f) + (g.right.ok ? g.right.conf : 0.f);
+        if (w <= 0.f) continue;
+        out.nx += w * g.emaX; out.ny += w * g.emaY; wSum += w;
+
+        float sx, sy;
+        if (i < calib.size() && calib[i].ready
+            && (mapEyes(calib[i], g, sx, sy) || calib[i].model.map(g.emaX, g.emaY, sx, sy))) {
+            out.sx += w * sx; out.sy += w * sy; wMapSum += w;
+        }
+    }
+
+    if (wSum > 0.f) {
+        out.nx /= wSum; out.ny /= wSum;
+        out.got = true;
+    }
+    if (wMapSum > 0.f) {
+        out.sx /= wMapSum; out.sy /= wMapSum;
+        out.mapped = true;
+    }
+    return out;
+}
@@ -0,0 +1,39 @@
+// GazeFusion.h
+// 카메라별 시선 추정 -> 하나의 시선으로 융합 (눈별 신뢰도 + 캡처 시각 정렬)
+#pragma once
+#include "CameraPipeline.h"
+#include "GazeModel.h"
+#include <chrono>
+#include <vector>
+
+// 카메라마다 따로 두는 캘리브레이션 (카메라 위치가 다르면 매핑도 다름)
+// 같은 샘플로 양눈 융합 모델 + 눈별 모델을 학습. 눈마다 오프셋/배율이 달라서
+// 눈별 모델로 각각 화면 좌표를 낸 뒤 합치면 한쪽 눈이 빠져도 커서가 튀지 않음
+struct CameraCalib {
+    std::vector<Sample> samples;
+    Poly2 model;                    // 양눈 융합 값 -> 화면 (눈별 모델이 없을 때)
+    Poly2 leftModel, rightModel;    // 눈별 EMA -> 화면
+    bool ready = false;
+    bool leftReady = false, rightReady = false;
+
+    // samples로 세 모델 학습. 눈별 모델은 그 눈이 보인 샘플이 6개 이상일 때만. ready 반환
+    bool fit();
+};
+
+struct FusedGaze {
+    bool face = false;
+    int faceCam = -1;           // 얼굴 박스를 가져온 카메라 (HUD 표시용)
+    cv::Rect faceBox;
+    bool leftSeen = false, rightSeen = false;   // 정렬된 카메라 중 하나라도 보면 true
+    EyeObs left, right;         // 눈별 원시 관측 (정렬된 카메라 중 신뢰도 최고)
+    bool got = false;           // 시선 유효
+    float nx = 0.f, ny = 0.f;   // 신뢰도 가중 평균 (카메라별 emaX/emaY)
+    bool mapped = false;        // 캘리브된 카메라가 하나 이상 기여
+    float sx = 0.f, sy = 0.f;   // 화면 좌표 (카메라별·눈별 Poly2 매핑 후 신뢰도 가중 평균)
+    FrameTime t;                // 기준(가장 최근) 캡처 시각
+};
+
+// 가장 최근 캡처 시각에서 alignWindow 안에 든 카메라만 융합
+FusedGaze fuseGaze(const std::vector<CameraGaze>& cams,
+    const std::vector<CameraCalib>& calib,
+    std::chrono::milliseconds alignWindow);
@@ -0,0 +1,266 @@
+// GazeHeatmap.cpp
+#include "GazeHeatmap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using namespace cv;
+
+// 전역 배율 지수가 이만큼 커지면 (e^30 ~ 1e13) 타일 전체를 한 번 재정규화
+static const double RESCALE_EXP = 30.0;
+
+static const char HEATMAP_MAGIC[4] = { 'G', 'Z', 'H', 'M' };
+static const uint32_t HEATMAP_VERSION = 1;
+
+// 바이너리 헤더 (리틀 엔디언, 뒤에 float rows*cols 행 우선)
+struct HeatmapFileHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t x, y, width, height;    // area
+    int32_t cellPx, cols, rows;
+    uint32_t reserved;
+    uint64_t samples;
+};
+
+// ---------------- Writer ----------------
+
+bool GazeHeatmap::Writer::add(Point2f p, FrameTime t)
+{
+    // 이번 위치에 머문 시간 = 직전 샘플부터의 간격 (첫 샘플은 기준만 잡음)
+    float w = hasLast_ ? std::clamp(secondsBetween(last_, t), 0.f, maxGap_) : 0.f;
+    last_ = t; hasLast_ = true;
+    if (w <= 0.f || !(p.x == p.x && p.y == p.y)) return true;
+
+    const size_t h = head_.load(std::memory_order_relaxed);
+    if (h - tail_.load(std::memory_order_acquire) >= kCap) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ring_[h & (kCap - 1)] = Item{ p.x, p.y, w, t };
+    head_.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+// ---------------- GazeHeatmap ----------------
+
+GazeHeatmap::GazeHeatmap(HeatmapOptions opt) : opt_(opt)
+{
+    opt_.cellPx = std::max(1, opt_.cellPx);
+    cols_ = std::max(1, (opt_.area.width + opt_.cellPx - 1) / opt_.cellPx);
+    rows_ = std::max(1, (opt_.area.height + opt_.cellPx - 1) / opt_.cellPx);
+    tilesX_ = (cols_ + kTile - 1) / kTile;
+    tilesY_ = (rows_ + kTile - 1) / kTile;
+    tiles_.resize((size_t)tilesX_ * tilesY_);
+    lambda_ = opt_.halfLifeSec > 0.f ? std::log(2.0) / opt_.halfLifeSec : 0.0;
+
+    auto s = std::make_shared<HeatmapSnapshot>();
+    s->area = opt_.area; s->cellPx = opt_.cellPx;
+    s->grid = Mat::zeros(rows_, cols_, CV_32F);
+    s->buildSat();
+    snap_ = s;
+}
+
+GazeHeatmap::~GazeHeatmap()
+{
+    stop();
+}
+
+std::shared_ptr<GazeHeatmap::Writer> GazeHeatmap::writer()
+{
+    std::shared_ptr<Writer> w(new Writer(opt_.maxGapSec));
+    std::lock_guard<std::mutex> lk(writersMtx_);
+    writers_.push_back(w);
+    return w;
+}
+
+void GazeHeatmap::start()
+{
+    if (running_.exchange(true)) return;
+    worker_ = std::thread(&GazeHeatmap::run, this);
+}
+
+void GazeHeatmap::stop()
+{
+    if (!running_.exchange(false)) return;
+    if (worker_.joinable()) worker_.join();
+}
+
+void GazeHeatmap::run()
+{
+    while (running_.load()) {
+        std::this_thread::sleep_for(opt_.mergeInterval);
+        flush();
+    }
+}
+
+void GazeHeatmap::flush()
+{
+    std::lock_guard<std::mutex> lk(mergeMtx_);
+    mergeLocked();
+}
+
+void GazeHeatmap::clear()
+{
+    std::lock_guard<std::mutex> lk(mergeMtx_);
+    mergeLocked();   // 링에 남은 것까지 버리려고 먼저 비움
+    for (auto& t : tiles_) t.reset();
+    t0Init_ = false;
+    samples_ = 0;
+    auto s = std::make_shared<HeatmapSnapshot>();
+    s->area = opt_.area; s->cellPx = opt_.cellPx;
+    s->grid = Mat::zeros(rows_, cols_, CV_32F);
+    s->buildSat();
+    std::atomic_store(&snap_, std::shared_ptr<const HeatmapSnapshot>(s));
+}
+
+void GazeHeatmap::addCell(int c, int r, float w)
+{
+    std::unique_ptr<float[]>& tile = tiles_[(size_t)(r / kTile) * tilesX_ + c / kTile];
+    if (!tile) {
+        tile.reset(new float[kTile * kTile]);
+        std::fill(tile.get(), tile.get() + kTile * kTile, 0.f);
+    }
+    tile[(r % kTile) * kTile + c % kTile] += w;
+}
+
+void GazeHeatmap::rescale(FrameTime t)
+{
+    const double k = std::exp(-lambda_ * secondsBetween(t0_, t));
+    for (auto& tile : tiles_)
+        if (tile) for (int i = 0; i < kTile * kTile; ++i) tile[i] = (float)(tile[i] * k);
+    t0_ = t;
+}
+
+void GazeHeatmap::mergeLocked()
+{
+    std::vector<std::shared_ptr<Writer>> writers;
+    {
+        std::lock_guard<std::mutex> lk(writersMtx_);
+        writers = writers_;
+    }
+
+    // 1) 링 비우기 -> 타일 (감쇠 있으면 샘플 시각의 배율을 곱해서)
+    for (const std::shared_ptr<Writer>& w : writers) {
+        const size_t head = w->head_.load(std::memory_order_acquire);
+        size_t tail = w->tail_.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            const Writer::Item& it = w->ring_[tail & (Writer::kCap - 1)];
+            if (!t0Init_) { t0_ = it.t; t0Init_ = true; }
+            ++samples_;
+            lastT_ = std::max(lastT_, it.t);
+            const int c = (int)std::floor((it.x - opt_.area.x) / opt_.cellPx);
+            const int r = (int)std::floor((it.y - opt_.area.y) / opt_.cellPx);
+            if (c < 0 || r < 0 || c >= cols_ || r >= rows_) continue;
+            float wt = it.w;
+            if (lambda_ > 0.0) {
+                const double e = lambda_ * secondsBetween(t0_, it.t);
+                if (e > RESCALE_EXP) { rescale(it.t); wt = it.w; }
+                else wt = (float)(it.w * std::exp(e));
+            }
+            addCell(c, r, wt);
+        }
+        w->tail_.store(tail, std::memory_order_release);
+    }
+
+    // 2) 스냅샷: 지금 시각 기준으로 감쇠한 격자 + 누적합
+    const FrameTime now = std::max(PipelineClock::now(), lastT_);
+    if (lambda_ > 0.0 && t0Init_ && lambda_ * secondsBetween(t0_, now) > RESCALE_EXP) rescale(now);
+    const float k = (lambda_ > 0.0 && t0Init_) ? (float)std::exp(-lambda_ * secondsBetween(t0_, now)) : 1.f;
+
+    auto s = std::make_shared<HeatmapSnapshot>();
+    s->area = opt_.area; s->cellPx = opt_.cellPx;
+    s->t = now; s->samples = samples_;
+    s->grid = Mat::zeros(rows_, cols_, CV_32F);
+    for (int ty = 0; ty < tilesY_; ++ty)
+        for (int tx = 0; tx < tilesX_; ++tx) {
+            const float* tile = tiles_[(size_t)ty * tilesX_ + tx].get();
+            if (!tile) continue;
+            const int r1 = std::min(rows_, (ty + 1) * kTile), c1 = std::min(cols_, (tx + 1) * kTile);
+            for (int r = ty * kTile; r < r1; ++r) {
+                float* dst = s->grid.ptr<float>(r);
+                const float* src = tile + (r - ty * kTile) * kTile;
+                for (int c = tx * kTile; c < c1; ++c) dst[c] = src[c - tx * kTile] * k;
+            }
+        }
+    s->buildSat();
+    std::atomic_store(&snap_, std::shared_ptr<const HeatmapSnapshot>(s));
+}
+
+// ---------------- HeatmapSnapshot ----------------
+
+void HeatmapSnapshot::buildSat()
+{
+    integral(grid, sat, CV_64F);
+}
+
+double HeatmapSnapshot::dwell(const Rect& region) const
+{
+    if (sat.empty()) return 0.0;
+    const int cols = sat.cols - 1, rows = sat.rows - 1;
+    // px -> 칸 (부분적으로 걸친 칸 포함), 격자 밖은 잘라냄
+    const int c0 = std::clamp((int)std::floor((region.x - area.x) / (double)cellPx), 0, cols);
+    const int r0 = std::clamp((int)std::floor((region.y - area.y) / (double)cellPx), 0, rows);
+    const int c1 = std::clamp((int)std::ceil((region.x + region.width - area.x) / (double)cellPx), 0, cols);
+    const int r1 = std::clamp((int)std::ceil((region.y + region.height - area.y) / (double)cellPx), 0, rows);
+    if (c1 <= c0 || r1 <= r0) return 0.0;
+    return sat.at<double>(r1, c1) - sat.at<double>(r0, c1) - sat.at<double>(r1, c0) + sat.at<double>(r0, c0);
+}
+
+bool HeatmapSnapshot::savePng(const std::string& path) const
+{
+    if (grid.empty()) return false;
+    double maxV = 0.0;
+    minMaxLoc(grid, nullptr, &maxV);
+    Mat g8, color;
+    // 제곱근으로 눌러서 긴 응시 몇 곳이 나머지를 다 지우지 않게
+    Mat root; cv::sqrt(grid, root);
+    root.convertTo(g8, CV_8U, maxV > 0.0 ? 255.0 / std::sqrt(maxV) : 0.0);
+    applyColorMap(g8, color, COLORMAP_INFERNO);
+    color.setTo(Scalar::all(0), g8 == 0);
+    resize(color, color, Size(grid.cols * cellPx, grid.rows * cellPx), 0, 0, INTER_NEAREST);
+    if (!imwrite(path, color)) { std::cerr << "[Heatmap] cannot write " << path << "\n"; return false; }
+    return true;
+}
+
+bool HeatmapSnapshot::saveBinary(const std::string& path) const
+{
+    if (grid.empty() || grid.type() != CV_32F) return false;
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) { std::cerr << "[Heatmap] cannot write " << path << "\n"; return false; }
+    HeatmapFileHeader h = {};
+    std::memcpy(h.magic, HEATMAP_MAGIC, 4);
+    h.version = HEATMAP_VERSION;
+    h.x = area.x; h.y = area.y; h.width = area.width; h.height = area.height;
+    h.cellPx = cellPx; h.cols = grid.cols; h.rows = grid.rows;
+    h.samples = samples;
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    for (int r = 0; r < grid.rows && ok; ++r)
+        ok = std::fwrite(grid.ptr<float>(r), sizeof(float), grid.cols, f) == (size_t)grid.cols;
+    std::fclose(f);
+    if (!ok) std::cerr << "[Heatmap] write failed: " << path << "\n";
+    return ok;
+}
+
+bool HeatmapSnapshot::loadBinary(const std::string& path, HeatmapSnapshot& out)
+{
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) { std::cerr << "[Heatmap] cannot open " << path << "\n"; return false; }
+    HeatmapFileHeader h = {};
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1 && !std::memcmp(h.magic, HEATMAP_MAGIC, 4)
+        && h.version == HEATMAP_VERSION && h.cols > 0 && h.rows > 0 && h.cellPx > 0;
+    HeatmapSnapshot s;
+    if (ok) {
+        s.area = Rect(h.x, h.y, h.width, h.height);
+        s.cellPx = h.cellPx; s.samples = h.samples;
+        s.grid = Mat::zeros(h.rows, h.cols, CV_32F);
+        for (int r = 0; r < h.rows && ok; ++r)
+            ok = std::fread(s.grid.ptr<float>(r), sizeof(float), h.cols, f) == (size_t)h.cols;
+    }
+    std::fclose(f);
+    if (!ok) { std::cerr << "[Heatmap] invalid heatmap file: " << path << "\n"; return false; }
+    s.buildSat();
+    out = s;
+    return true;
+}
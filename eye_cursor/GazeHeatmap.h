@@ -0,0 +1,122 @@
+// GazeHeatmap.h
+// 화면 시선 히트맵 / 응시 시간 분석: 타일 단위 화면 격자에 시간 감쇠 누적, 스냅샷 PNG/바이너리 내보내기,
+// 영역별 응시 시간을 누적합 테이블로 O(1) 조회
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PipelineClock.h"
+
+struct HeatmapOptions {
+    cv::Rect area = cv::Rect(0, 0, 1920, 1080);         // 가상 데스크톱 px (ScreenTopology::virtualBounds)
+    int cellPx = 8;                                     // 격자 칸 크기 (px)
+    float halfLifeSec = 0.f;                            // 감쇠 반감기 (0 = 감쇠 없음, 전체 누적)
+    std::chrono::milliseconds mergeInterval{ 250 };     // 스레드별 누적분 병합 + 스냅샷 주기
+    float maxGapSec = 0.1f;                             // 샘플 간격 상한 (추적이 끊긴 구간을 응시로 세지 않음)
+};
+
+/**
+ * @class HeatmapSnapshot
+ * @brief 병합 시점의 불변 격자. 칸 값 = 그 칸을 본 시간(초, 감쇠 반영)이고,
+ * (rows+1)x(cols+1) 누적합 테이블로 임의 사각형의 응시 시간을 조회 4번으로 답합니다.
+ */
+struct HeatmapSnapshot {
+    cv::Rect area;
+    int cellPx = 8;
+    cv::Mat grid;               // CV_32F rows x cols, 칸별 응시 시간 (초)
+    cv::Mat sat;                // CV_64F (rows+1) x (cols+1), grid의 누적합
+    FrameTime t;                // 마지막 병합 시각
+    uint64_t samples = 0;       // 지금까지 병합된 샘플 수 (감쇠와 무관)
+
+    // 영역(가상 데스크톱 px) 안 응시 시간 (초). 칸 경계로 바깥쪽 반올림
+    double dwell(const cv::Rect& region) const;
+    double total() const { return sat.empty() ? 0.0 : sat.at<double>(sat.rows - 1, sat.cols - 1); }
+
+    // 컬러맵 PNG (최대값 기준 정규화, 0은 검정)
+    bool savePng(const std::string& path) const;
+    // 헤더 + float 격자 그대로 (다른 도구에서 읽기용). loadBinary는 sat까지 다시 만듦
+    bool saveBinary(const std::string& path) const;
+    static bool loadBinary(const std::string& path, HeatmapSnapshot& out);
+
+    void buildSat();
+};
+
+/**
+ * @class GazeHeatmap
+ * @brief 시선을 내는 스레드마다 writer()로 받은 Writer에 add()만 합니다. Writer는 단일 생산자 링이라
+ * add()는 락도 할당도 없이 끝나고, 가득 차면 버리고 dropped를 셉니다.
+ * 병합 스레드가 mergeInterval마다 모든 링을 비워 64x64칸 타일(필요할 때 할당)에 더하고,
+ * 격자 + 누적합 테이블 스냅샷을 만들어 원자적으로 교체합니다. 조회는 snapshot()으로 받은 불변 객체에서.
+ * 감쇠는 칸마다 곱하지 않고 전역 배율 exp(t/τ)로 샘플 가중치를 키워 두었다가 배율이 커지면 한 번에 재정규화합니다.
+ */
+class GazeHeatmap {
+public:
+    class Writer {
+    public:
+        // 화면 좌표 p를 시각 t에 봄. 직전 샘플과의 간격(maxGapSec 상한)만큼 응시 시간으로 누적
+        bool add(cv::Point2f p, FrameTime t);
+        // 추적이 끊김: 다음 샘플은 간격 없이 시작
+        void gap() { hasLast_ = false; }
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class GazeHeatmap;
+        struct Item { float x, y, w; FrameTime t; };
+        static constexpr size_t kCap = 4096;   // 2의 거듭제곱
+        explicit Writer(float maxGapSec) : ring_(kCap), maxGap_(maxGapSec) {}
+
+        std::vector<Item> ring_;
+        std::atomic<size_t> head_{ 0 }, tail_{ 0 };
+        std::atomic<uint64_t> dropped_{ 0 };
+        float maxGap_;
+        FrameTime last_;
+        bool hasLast_ = false;
+    };
+
+    explicit GazeHeatmap(HeatmapOptions opt = HeatmapOptions());
+    ~GazeHeatmap();
+
+    // 생산자 스레드마다 하나 (등록만 락, 이후 add는 락 없음)
+    std::shared_ptr<Writer> writer();
+
+    void start();
+    void stop();
+    // 지금 바로 병합 + 스냅샷 (병합 스레드 없이 쓰거나 종료 직전 내보내기용)
+    void flush();
+
+    std::shared_ptr<const HeatmapSnapshot> snapshot() const { return std::atomic_load(&snap_); }
+    void clear();
+
+private:
+    void run();
+    void mergeLocked();
+    void addCell(int c, int r, float w);
+    void rescale(FrameTime t);
+
+    static constexpr int kTile = 64;   // 타일 한 변 (칸)
+
+    HeatmapOptions opt_;
+    int cols_, rows_, tilesX_, tilesY_;
+    double lambda_;                                 // 1/τ (감쇠 없으면 0)
+
+    std::mutex writersMtx_;
+    std::vector<std::shared_ptr<Writer>> writers_;
+
+    // 병합 상태 (mergeMtx_: 병합 스레드와 flush/clear 사이)
+    std::mutex mergeMtx_;
+    std::vector<std::unique_ptr<float[]>> tiles_;   // tilesY_ x tilesX_, 미사용 타일은 nullptr
+    FrameTime t0_;                                  // 배율 기준 시각: 실제 값 = 저장값 * exp(-(now - t0)/τ)
+    bool t0Init_ = false;
+    FrameTime lastT_;
+    uint64_t samples_ = 0;
+
+    std::shared_ptr<const HeatmapSnapshot> snap_;   // std::atomic_load/store로만 접근
+    std::atomic<bool> running_{ false };
+    std::thread worker_;
+};
@@ -0,0 +1,40 @@
+// GazeModel.h
+// 시선(nx,ny) -> 화면 좌표 매핑 모델 (2차 다항식) + 필터
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+struct Sample {
+    float nx, ny;   // 입력: 시선 정규화 (양눈 융합)
+    float sx, sy;   // 타깃: 화면 px
+    bool leftOk = false, rightOk = false;           // 눈별 값 유효 (눈별 모델 학습용)
+    float lx = 0.f, ly = 0.f, rx = 0.f, ry = 0.f;   // 눈별 시선 정규화
+};
+
+struct Poly2 {
+    cv::Mat A, B; // 6x1
+    bool fit(const std::vector<Sample>& S) {
+        if (S.size() < 6) return false;
+        cv::Mat M((int)S.size(), 6, CV_32F), X((int)S.size(), 1, CV_32F), Y((int)S.size(), 1, CV_32F);
+        for (int i = 0; i < (int)S.size(); ++i) {
+            float nx = S[i].nx, ny = S[i].ny;
+            M.at<float>(i, 0) = 1.f;  M.at<float>(i, 1) = nx;  M.at<float>(i, 2) = ny;
+            M.at<float>(i, 3) = nx * ny; M.at<float>(i, 4) = nx * nx; M.at<float>(i, 5) = ny * ny;
+            X.at<float>(i, 0) = S[i].sx; Y.at<float>(i, 0) = S[i].sy;
+        }
+        cv::Mat Acoef, Bcoef;
+        bool ok1 = cv::solve(M, X, Acoef, cv::DECOMP_SVD);
+        bool ok2 = cv::solve(M, Y, Bcoef, cv::DECOMP_SVD);
+        if (!(ok1 && ok2)) return false;
+        A = Acoef.clone(); B = Bcoef.clone(); return true;
+    }
+    bool map(float nx, float ny, float& sx, float& sy) const {
+        if (A.empty() || B.empty()) return false;
+        float f[6] = { 1.f,nx,ny,nx * ny,nx * nx,ny * ny };
+        sx = 0.f; sy = 0.f;
+        for (int i = 0; i < 6; ++i) { sx += A.at<float>(i, 0) * f[i]; sy += B.at<float>(i, 0) * f[i]; }
+        return true;
+    }
+};
+
+inline float ema1(float prev, float cur, float a) { return prev * (1.f - a) + cur * a; }
@@ -0,0 +1,359 @@
+// GazePipeline.h
+// 정책(policy) 기반 시선 파이프라인 템플릿: 눈 검출 -> 동공 추정 -> (양눈 융합) -> 필터 -> 매핑 -> 출력
+// 단계 조합을 컴파일 타임에 고르면 핫 패스가 인라인되고 꺼진 단계(NoFilter, NullOutput 등)는 코드가 아예 안 나옴
+// 설정 파일로 고르는 빌드용 타입 소거(Any*) 정책 + makeRuntimePipeline 도 같이 (헤더 전용)
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include "BinocularFusion.h"
+#include "Calib.h"
+#include "CoarsePupil.h"
+#include "FacePreprocessor.h"
+#include "GazeModel.h"
+#include "ObjectDetector.h"
+#include "PipelineClock.h"
+#include "PupilEstimator.h"
+#include "PupilFinder.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+// 눈 박스 (프레임 좌표). ok가 false면 그 눈은 이번 프레임에 없음
+struct EyeBoxes {
+    bool face = false;
+    cv::Rect faceBox;
+    bool leftOk = false, rightOk = false;
+    cv::Rect left, right;
+};
+
+// 한 프레임 결과
+struct GazeFrame {
+    FrameTime t;
+    EyeBoxes boxes;
+    bool leftOk = false, rightOk = false;
+    cv::Point2f left, right;        // 눈별 정규화 시선
+    bool got = false;               // 양눈 융합 시선 있음
+    float nx = 0.f, ny = 0.f;       // 융합 (필터 후)
+    bool mapped = false;
+    float sx = 0.f, sy = 0.f;       // 화면 px
+};
+
+// 정책 공통: static constexpr bool enabled = false인 정책은 파이프라인이 호출 자체를 컴파일에서 뺌
+//   Detector: bool eyes(const cv::Mat& gray, EyeBoxes& out)
+//   Pupil:    bool estimate(const cv::Mat& gray, const cv::Rect& eye, float& nx, float& ny, float& conf)
+//   Filter:   void apply(float& nx, float& ny, FrameTime t)
+//   Mapper:   bool map(float nx, float ny, float& sx, float& sy)
+//   Output:   void emit(const GazeFrame& f)
+
+// ---------------- Detector ----------------
+
+// 얼굴 -> 위쪽 얼굴 정규화(FacePreprocessor) -> 눈 캐스케이드. 박스는 커서 파이프라인과 같은 강축소
+struct CascadeEyes {
+    static constexpr bool enabled = true;
+    std::shared_ptr<ObjectDetector> face, eye;
+    FacePreprocessor pre;
+
+    bool eyes(const cv::Mat& gray, EyeBoxes& out) {
+        std::vector<cv::Rect> faces, es;
+        face->detect(gray, faces);
+        if (faces.empty()) return false;
+        const cv::Rect f = *std::max_element(faces.begin(), faces.end(),
+            [](const cv::Rect& a, const cv::Rect& b) { return a.area() < b.area(); });
+        out.face = true; out.faceBox = f;
+        const cv::Rect top = upperFaceRect(f) & cv::Rect(0, 0, gray.cols, gray.rows);
+        pre.compute(gray, top);
+        if (pre.empty()) return false;
+        eye->detect(pre.norm(), es);
+        for (size_t i = 0; i < es.size() && i < 2; ++i) {
+            const cv::Rect er = (eyeCropRect(es[i]) + top.tl()) & top;
+            if (er.width < 12 || er.height < 12) continue;
+            const bool isLeft = er.x + er.width * 0.5f < f.x + f.width * 0.5f;
+            (isLeft ? out.leftOk : out.rightOk) = true;
+            (isLeft ? out.left : out.right) = er;
+        }
+        return out.leftOk || out.rightOk;
+    }
+};
+
+// 고정 눈 박스 (헤드레스트 키오스크, 녹화 재생, 벤치)
+struct FixedEyes {
+    static constexpr bool enabled = true;
+    cv::Rect left, right;
+
+    bool eyes(const cv::Mat& gray, EyeBoxes& out) {
+        const cv::Rect frame(0, 0, gray.cols, gray.rows);
+        out.face = true;
+        out.left = left & frame; out.right = right & frame;
+        out.leftOk = out.left.area() > 0; out.rightOk = out.right.area() > 0;
+        return out.leftOk || out.rightOk;
+    }
+};
+
+// ---------------- Pupil ----------------
+
+// darkCentroidNorm (float / fixed), coarse = CoarsePupil 창 안에서만
+template <PupilImpl Impl = PupilImpl::Float, bool Coarse = false>
+struct DarkCentroidPupil {
+    static constexpr bool enabled = true;
+    bool estimate(const cv::Mat& gray, const cv::Rect& eye, float& nx, float& ny, float& conf) {
+        const cv::Mat roi = gray(eye);
+        return Coarse ? darkCentroidNormCoarse(Impl, false, roi, nx, ny, &conf) : darkCentroidNorm(Impl, roi, nx, ny, &conf);
+    }
+};
+
+// findPupil (Otsu + 컨투어, 허프원 대체). 픽셀 중심 -> darkCentroidNorm과 같은 정규화
+template <bool Coarse = false>
+struct FindPupilPupil {
+    static constexpr bool enabled = true;
+    bool estimate(const cv::Mat& gray, const cv::Rect& eye, float& nx, float& ny, float& conf) {
+        const cv::Mat roi = gray(eye);
+        cv::Point p; float r = 0.f;
+        if (!(Coarse ? findPupilCoarse(roi, false, p, r) : findPupil(roi, p, r))) return false;
+        nx = (p.x - (roi.cols - 1) * 0.5f) / std::max(1.f, roi.cols * 0.5f);
+        ny = (p.y - (roi.rows - 1) * 0.5f) / std::max(1.f, roi.rows * 0.5f);
+        conf = 1.f;
+        return true;
+    }
+};
+
+// ---------------- Filter ----------------
+
+struct NoFilter {
+    static constexpr bool enabled = false;
+    void apply(float&, float&, FrameTime) {}
+};
+
+// ema1 + 캡처 시각 간격 기반 α (PipelineClock 참고)
+struct EmaFilter {
+    static constexpr bool enabled = true;
+    float tauSec = tauFromAlpha(0.25f, 30.f);
+    float x = 0.f, y = 0.f;
+    FrameTime last;
+    bool init = false;
+
+    void apply(float& nx, float& ny, FrameTime t) {
+        const float a = init ? emaAlpha(secondsBetween(last, t), tauSec) : 1.f;
+        x = ema1(x, nx, a); y = ema1(y, ny, a);
+        last = t; init = true;
+        nx = x; ny = y;
+    }
+};
+
+// ---------------- Mapper ----------------
+
+struct NoMapper {
+    static constexpr bool enabled = false;
+    bool map(float, float, float&, float&) { return false; }
+};
+
+struct Poly2Mapper {
+    static constexpr bool enabled = true;
+    Poly2 model;
+    bool map(float nx, float ny, float& sx, float& sy) { return model.map(nx, ny, sx, sy); }
+};
+
+// 5방향 캘리브(-1.5..1.5, 0 = 가운데) -> screen 사각형 (±1이 가장자리)
+struct Calib2DMapper {
+    static constexpr bool enabled = true;
+    Calib2D calib;
+    cv::Rect screen = cv::Rect(0, 0, 1920, 1080);
+    bool map(float nx, float ny, float& sx, float& sy) {
+        if (!calib.ready()) return false;
+        sx = screen.x + (calib.X.map(nx) * 0.5f + 0.5f) * (screen.width - 1);
+        sy = screen.y + (calib.Y.map(ny) * 0.5f + 0.5f) * (screen.height - 1);
+        return true;
+    }
+};
+
+// ---------------- Output ----------------
+
+struct NullOutput {
+    static constexpr bool enabled = false;
+    void emit(const GazeFrame&) {}
+};
+
+// 매핑된 시선으로 커서 이동 (Windows가 아니면 아무것도 안 함)
+struct Win32CursorOutput {
+    static constexpr bool enabled = true;
+    void emit(const GazeFrame& f) {
+#ifdef _WIN32
+        if (f.mapped) SetCursorPos((int)std::lround(f.sx), (int)std::lround(f.sy));
+#else
+        (void)f;
+#endif
+    }
+};
+
+// ---------------- Pipeline ----------------
+
+/**
+ * @class GazePipeline
+ * @brief 다섯 단계 정책을 값으로 들고 process()에서 차례로 부릅니다. 가상 호출이 없어 컴파일러가 전부 인라인할 수 있고,
+ * enabled = false인 단계는 if constexpr로 빠집니다 (필터 없음 = 필터 코드 없음, 매퍼 없음 = mapped 항상 false).
+ * 양눈 융합은 BinocularFusion (신뢰도 가중 + 눈 사이 오프셋 보정)이 고정으로 맡습니다.
+ * 정책에 접근해 실행 중 상태(Poly2 계수, 캘리브 등)를 바꿀 수 있습니다. 인스턴스는 스레드 하나 전용.
+ */
+template <class Detector, class Pupil, class Filter, class Mapper, class Output>
+class GazePipeline {
+public:
+    GazePipeline(Detector d = Detector(), Pupil p = Pupil(), Filter f = Filter(), Mapper m = Mapper(), Output o = Output())
+        : det_(std::move(d)), pupil_(std::move(p)), filter_(std::move(f)), mapper_(std::move(m)), out_(std::move(o)) {}
+
+    // gray: 프레임 전체 그레이, t: 캡처 시각. 융합 시선이 나오면 true
+    bool process(const cv::Mat& gray, FrameTime t, GazeFrame& f) {
+        f = GazeFrame();
+        f.t = t;
+        if (!det_.eyes(gray, f.boxes)) return emit(f);
+
+        float conf[2] = { 0.f, 0.f };
+        if constexpr (Pupil::enabled) {
+            if (f.boxes.leftOk) f.leftOk = pupil_.estimate(gray, f.boxes.left, f.left.x, f.left.y, conf[0]);
+            if (f.boxes.rightOk) f.rightOk = pupil_.estimate(gray, f.boxes.right, f.right.x, f.right.y, conf[1]);
+        }
+        const float dt = fusion_.ready() ? secondsBetween(fusionT_, t) : 0.f;
+        cv::Point2f mid;
+        if (!fusion_.fuse(f.leftOk, f.left, conf[0], f.rightOk, f.right, conf[1], dt, mid)) return emit(f);
+        fusionT_ = t;
+        f.got = true;
+        f.nx = mid.x; f.ny = mid.y;
+
+        if constexpr (Filter::enabled) filter_.apply(f.nx, f.ny, t);
+        if constexpr (Mapper::enabled) f.mapped = mapper_.map(f.nx, f.ny, f.sx, f.sy);
+        return emit(f);
+    }
+
+    Detector& detector() { return det_; }
+    Pupil& pupil() { return pupil_; }
+    Filter& filter() { return filter_; }
+    Mapper& mapper() { return mapper_; }
+    Output& output() { return out_; }
+
+private:
+    bool emit(const GazeFrame& f) {
+        if constexpr (Output::enabled) out_.emit(f);
+        return f.got;
+    }
+
+    Detector det_;
+    Pupil pupil_;
+    Filter filter_;
+    Mapper mapper_;
+    Output out_;
+    BinocularFusion fusion_;
+    FrameTime fusionT_;
+};
+
+// 커서 프로그램 기본 조합 (캐스케이드 + coarse darkCentroid + EMA + Poly2 + 커서)
+using CursorGazePipeline = GazePipeline<CascadeEyes, DarkCentroidPupil<kDefaultPupilImpl, true>, EmaFilter, Poly2Mapper, Win32CursorOutput>;
+
+// ---------------- 타입 소거 (런타임 조합) ----------------
+
+// 각 단계를 std::function으로 감싼 정책. 빈 함수 = 그 단계 끔 (런타임 분기 한 번)
+struct AnyDetector {
+    static constexpr bool enabled = true;
+    std::function<bool(const cv::Mat&, EyeBoxes&)> fn;
+    bool eyes(const cv::Mat& gray, EyeBoxes& out) { return fn && fn(gray, out); }
+};
+struct AnyPupil {
+    static constexpr bool enabled = true;
+    std::function<bool(const cv::Mat&, const cv::Rect&, float&, float&, float&)> fn;
+    bool estimate(const cv::Mat& g, const cv::Rect& e, float& nx, float& ny, float& c) { return fn && fn(g, e, nx, ny, c); }
+};
+struct AnyFilter {
+    static constexpr bool enabled = true;
+    std::function<void(float&, float&, FrameTime)> fn;
+    void apply(float& nx, float& ny, FrameTime t) { if (fn) fn(nx, ny, t); }
+};
+struct AnyMapper {
+    static constexpr bool enabled = true;
+    std::function<bool(float, float, float&, float&)> fn;
+    bool map(float nx, float ny, float& sx, float& sy) { return fn && fn(nx, ny, sx, sy); }
+};
+struct AnyOutput {
+    static constexpr bool enabled = true;
+    std::function<void(const GazeFrame&)> fn;
+    void emit(const GazeFrame& f) { if (fn) fn(f); }
+};
+
+using RuntimeGazePipeline = GazePipeline<AnyDetector, AnyPupil, AnyFilter, AnyMapper, AnyOutput>;
+
+// 구체 정책 하나를 Any*로 감쌈 (상태는 shared_ptr로 들고 있음 -> 복사해도 같은 인스턴스)
+template <class P> AnyDetector anyDetector(P p) {
+    auto s = std::make_shared<P>(std::move(p));
+    return AnyDetector{ [s](const cv::Mat& g, EyeBoxes& o) { return s->eyes(g, o); } };
+}
+template <class P> AnyPupil anyPupil(P p) {
+    auto s = std::make_shared<P>(std::move(p));
+    return AnyPupil{ [s](const cv::Mat& g, const cv::Rect& e, float& x, float& y, float& c) { return s->estimate(g, e, x, y, c); } };
+}
+template <class P> AnyFilter anyFilter(P p) {
+    if constexpr (!P::enabled) return AnyFilter{};
+    else {
+        auto s = std::make_shared<P>(std::move(p));
+        return AnyFilter{ [s](float& x, float& y, FrameTime t) { s->apply(x, y, t); } };
+    }
+}
+template <class P> AnyMapper anyMapper(P p) {
+    if constexpr (!P::enabled) return AnyMapper{};
+    else {
+        auto s = std::make_shared<P>(std::move(p));
+        return AnyMapper{ [s](float x, float y, float& sx, float& sy) { return s->map(x, y, sx, sy); } };
+    }
+}
+template <class P> AnyOutput anyOutput(P p) {
+    if constexpr (!P::enabled) return AnyOutput{};
+    else {
+        auto s = std::make_shared<P>(std::move(p));
+        return AnyOutput{ [s](const GazeFrame& f) { s->emit(f); } };
+    }
+}
+
+// 설정 문자열로 고르는 단계 이름
+struct GazePipelineConfig {
+    std::string pupil = "darkCentroid";   // darkCentroid | darkCentroidFixed | findPupil (+ "+coarse")
+    std::string filter = "ema";           // ema | none
+    std::string mapper = "poly2";         // poly2 | calib2d | none
+    std::string output = "cursor";        // cursor | none
+};
+
+/**
+ * @brief 설정으로 런타임 파이프라인을 만듭니다. 검출기와 매퍼 상태(Poly2/Calib2D)는 호출자가 넘깁니다.
+ * 모르는 이름이면 false + error에 이유.
+ */
+inline bool makeRuntimePipeline(const GazePipelineConfig& cfg, AnyDetector detector, const Poly2& poly,
+    const Calib2DMapper& calib, RuntimeGazePipeline& out, std::string* error = nullptr)
+{
+    auto fail = [&](const std::string& what) { if (error) *error = "unknown " + what; return false; };
+
+    AnyPupil pupil;
+    if (cfg.pupil == "darkCentroid") pupil = anyPupil(DarkCentroidPupil<PupilImpl::Float, false>());
+    else if (cfg.pupil == "darkCentroid+coarse") pupil = anyPupil(DarkCentroidPupil<PupilImpl::Float, true>());
+    else if (cfg.pupil == "darkCentroidFixed") pupil = anyPupil(DarkCentroidPupil<PupilImpl::Fixed, false>());
+    else if (cfg.pupil == "darkCentroidFixed+coarse") pupil = anyPupil(DarkCentroidPupil<PupilImpl::Fixed, true>());
+    else if (cfg.pupil == "findPupil") pupil = anyPupil(FindPupilPupil<false>());
+    else if (cfg.pupil == "findPupil+coarse") pupil = anyPupil(FindPupilPupil<true>());
+    else return fail("pupil: " + cfg.pupil);
+
+    AnyFilter filter;
+    if (cfg.filter == "ema") filter = anyFilter(EmaFilter());
+    else if (cfg.filter != "none") return fail("filter: " + cfg.filter);
+
+    AnyMapper mapper;
+    if (cfg.mapper == "poly2") mapper = anyMapper(Poly2Mapper{ poly });
+    else if (cfg.mapper == "calib2d") mapper = anyMapper(calib);
+    else if (cfg.mapper != "none") return fail("mapper: " + cfg.mapper);
+
+    AnyOutput output;
+    if (cfg.output == "cursor") output = anyOutput(Win32CursorOutput());
+    else if (cfg.output != "none") return fail("output: " + cfg.output);
+
+    out = RuntimeGazePipeline(std::move(detector), std::move(pupil), std::move(filter), std::move(mapper), std::move(output));
+    return true;
+}
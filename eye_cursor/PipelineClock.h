@@ -0,0 +1,28 @@
+// PipelineClock.h
+// 파이프라인 공통 시계: 캡처 시점에 찍은 단조(monotonic) 시각을 프레임과 함께 전달
+// 모든 시간 의존 로직(EMA, 깜빡임, 쿨다운)은 프레임 수가 아니라 이 시각 차이로 계산
+#pragma once
+#include <chrono>
+#include <cmath>
+
+using PipelineClock = std::chrono::steady_clock;
+using FrameTime = PipelineClock::time_point;
+
+// 두 시각 사이 경과 초 (b - a)
+inline float secondsBetween(FrameTime a, FrameTime b) {
+    return std::chrono::duration<float>(b - a).count();
+}
+
+// 시정수 tau(초) 1차 EMA의 dt초 경과 후 가중치: a = 1 - exp(-dt/tau)
+// 프레임레이트가 바뀌어도 같은 시간 동안의 평활 강도가 유지됨
+inline float emaAlpha(float dtSec, float tauSec) {
+    if (dtSec <= 0.f) return 0.f;
+    if (tauSec <= 0.f) return 1.f;
+    return 1.f - std::exp(-dtSec / tauSec);
+}
+
+// 기존 "프레임당 α" 상수를 기준 FPS에서 같은 반응의 시정수로 환산
+// tau = -1 / (fps * ln(1-α))   예) α=0.25 @30fps -> 약 0.116초
+inline float tauFromAlpha(float alphaPerFrame, float refFps) {
+    return alphaPerFrame > 0.f ? -1.f / (refFps * std::log(1.f - alphaPerFrame)) : 0.f;
+}
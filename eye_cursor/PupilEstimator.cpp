@@ -0,0 +1,74 @@
+// PupilEstimator.cpp
+#include "PupilEstimator.h"
+#include "CoarsePupil.h"
+#include <algorithm>
+
+using namespace cv;
+
+bool darkCentroidNorm(const Mat& eyeGray, float& nx, float& ny, float* conf) {
+    // ★ FIX: 빈/작은/타입 체크 (기존 CV_Assert 제거)
+    if (eyeGray.empty() || eyeGray.total() == 0 || eyeGray.rows < 5 || eyeGray.cols < 5 || eyeGray.type() != CV_8UC1)
+        return false;
+
+    Mat blur; GaussianBlur(eyeGray, blur, Size(7, 7), 0);
+    Mat eq;   equalizeHist(blur, eq);             // ★ FIX: equalizeHist(blur, eq) (기존 코드 버그)
+    return darkCentroidNormPrepared(eq, nx, ny, conf);
+}
+
+bool darkCentroidNormPrepared(const Mat& eyeNorm, float& nx, float& ny, float* conf) {
+    if (eyeNorm.empty() || eyeNorm.rows < 5 || eyeNorm.cols < 5 || eyeNorm.type() != CV_8UC1)
+        return false;
+    const Mat& eyeGray = eyeNorm;   // 아래 정규화/신뢰도는 ROI 크기만 씀
+    Mat inv;  bitwise_not(eyeNorm, inv);
+
+    if (inv.empty() || inv.total() == 0) return false; // ★ FIX: 가드
+    Scalar m, s; meanStdDev(inv, m, s);
+    double t = m[0] + 0.6 * s[0];
+
+    Mat w; threshold(inv, w, t, 255, THRESH_TOZERO);
+    morphologyEx(w, w, MORPH_OPEN, getStructuringElement(MORPH_ELLIPSE, Size(3, 3)));
+    morphologyEx(w, w, MORPH_CLOSE, getStructuringElement(MORPH_ELLIPSE, Size(5, 5)));
+    Moments mu = moments(w, false);
+    if (mu.m00 < 2e4) return false;
+
+    float cx = (float)(mu.m10 / mu.m00);
+    float cy = (float)(mu.m01 / mu.m00);
+    float centerX = (eyeGray.cols - 1) * 0.5f;
+    float centerY = (eyeGray.rows - 1) * 0.5f;
+
+    nx = (cx - centerX) / std::max(1.f, eyeGray.cols * 0.5f);
+    ny = (cy - centerY) / std::max(1.f, eyeGray.rows * 0.5f);
+    nx = std::clamp(nx, -1.5f, 1.5f);
+    ny = std::clamp(ny, -1.5f, 1.5f);
+
+    if (conf) {
+        // 질량이 하한(2e4)의 5배 이상이면 1, ROI가 작을수록(해상도 낮을수록) 감점
+        float massC = (float)std::min(1.0, (mu.m00 - 2e4) / 8e4);
+        float sizeC = std::min(1.f, eyeGray.cols / 40.f);
+        *conf = std::max(0.05f, massC * sizeC);
+    }
+    return true;
+}
+
+bool darkCentroidNormCoarse(PupilImpl impl, bool prepared, const Mat& eye, float& nx, float& ny, float* conf) {
+    if (eye.empty() || eye.rows < 5 || eye.cols < 5 || eye.type() != CV_8UC1) return false;
+    Rect win;
+    coarsePupilWindow(eye, win);
+
+    float wx, wy, wc = 0.f;
+    const Mat sub = eye(win);
+    const bool ok = prepared ? darkCentroidNormPrepared(impl, sub, wx, wy, &wc) : darkCentroidNorm(impl, sub, wx, wy, &wc);
+    if (!ok) return false;
+
+    // 창 정규화 좌표 -> 창 px -> ROI px -> ROI 정규화 (darkCentroidNorm과 같은 식)
+    const float cx = win.x + wx * std::max(1.f, win.width * 0.5f) + (win.width - 1) * 0.5f;
+    const float cy = win.y + wy * std::max(1.f, win.height * 0.5f) + (win.height - 1) * 0.5f;
+    nx = std::clamp((cx - (eye.cols - 1) * 0.5f) / std::max(1.f, eye.cols * 0.5f), -1.5f, 1.5f);
+    ny = std::clamp((cy - (eye.rows - 1) * 0.5f) / std::max(1.f, eye.rows * 0.5f), -1.5f, 1.5f);
+    if (conf) {
+        // 크기 감점은 창이 아니라 ROI 해상도 기준
+        const float sw = std::min(1.f, win.width / 40.f), se = std::min(1.f, eye.cols / 40.f);
+        *conf = std::clamp(wc * se / std::max(sw, 1e-3f), 0.05f, 1.f);
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+// PupilEstimator.h
+#pragma once
+#include <opencv2/opencv.hpp>
+
+// --- 시선 검출: 어두운 질량 중심 -> (nx, ny) ---
+// conf가 주어지면 동공 가중치 질량 기반 신뢰도(0..1)를 함께 반환
+bool darkCentroidNorm(const cv::Mat& eyeGray, float& nx, float& ny, float* conf = nullptr);
+
+// 이미 평활 + 대비 정규화된 눈 ROI (FacePreprocessor::smooth 뷰)에서 시작. ROI별 blur/equalizeHist 생략
+bool darkCentroidNormPrepared(const cv::Mat& eyeNorm, float& nx, float& ny, float* conf = nullptr);
+
+// 같은 알고리즘의 정수/고정소수점 + universal intrinsics 버전 (PupilEstimatorFixed.cpp)
+// FPU가 약한 ARM 키오스크용. float 경로와의 차이는 eye_bench/validate_pupil_fixed로 확인
+bool darkCentroidNormFixed(const cv::Mat& eyeGray, float& nx, float& ny, float* conf = nullptr);
+bool darkCentroidNormFixedPrepared(const cv::Mat& eyeNorm, float& nx, float& ny, float* conf = nullptr);
+
+enum class PupilImpl { Float, Fixed };
+
+// 기본 구현: ARM 빌드는 고정소수점, 그 외는 float (EYE_PUPIL_FIXED_DEFAULT=0/1로 강제)
+#ifndef EYE_PUPIL_FIXED_DEFAULT
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define EYE_PUPIL_FIXED_DEFAULT 1
+#else
+#define EYE_PUPIL_FIXED_DEFAULT 0
+#endif
+#endif
+constexpr PupilImpl kDefaultPupilImpl = EYE_PUPIL_FIXED_DEFAULT ? PupilImpl::Fixed : PupilImpl::Float;
+
+inline bool darkCentroidNorm(PupilImpl impl, const cv::Mat& eyeGray, float& nx, float& ny, float* conf = nullptr) {
+    return impl == PupilImpl::Fixed ? darkCentroidNormFixed(eyeGray, nx, ny, conf) : darkCentroidNorm(eyeGray, nx, ny, conf);
+}
+inline bool darkCentroidNormPrepared(PupilImpl impl, const cv::Mat& eyeNorm, float& nx, float& ny, float* conf = nullptr) {
+    return impl == PupilImpl::Fixed ? darkCentroidNormFixedPrepared(eyeNorm, nx, ny, conf) : darkCentroidNormPrepared(eyeNorm, nx, ny, conf);
+}
+
+// 대략 위치(CoarsePupil) 창 안에서만 정밀 추정 -> nx, ny, conf는 전체 ROI 기준으로 환산
+// prepared: eye가 FacePreprocessor::smooth 뷰. 창을 못 구하면 전체 ROI로
+bool darkCentroidNormCoarse(PupilImpl impl, bool prepared, const cv::Mat& eye, float& nx, float& ny, float* conf = nullptr);
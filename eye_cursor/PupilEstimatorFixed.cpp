@@ -0,0 +1,185 @@
+// PupilEstimatorFixed.cpp
+// darkCentroidNorm의 정수/고정소수점 버전. 부동소수 연산은 마지막 정규화 몇 번뿐
+// OpenCV universal intrinsics(v_uint8 등)로 작성 -> 같은 소스가 x86에서는 SSE/AVX, ARM에서는 NEON으로 컴파일
+// (CV_SIMD가 0인 빌드는 같은 식의 스칼라 루프)
+#include "PupilEstimator.h"
+#include <opencv2/core/hal/intrin.hpp>
+#include <algorithm>
+#include <cstdint>
+
+using namespace cv;
+
+// GaussianBlur(7x7, sigma 자동)이 쓰는 고정 커널 {1,3.5,7,9,7,3.5,1}/32 를 합 256으로
+static const uint16_t kGauss[7] = { 8, 28, 56, 72, 56, 28, 8 };
+
+// 가로 7탭: src 행(좌우 3픽셀 패딩 포함) -> dst 행 (cols개). 합 <= 255*256 이라 u16 안에서 끝남
+static void blurRowH(const uchar* src, uchar* dst, int cols) {
+    int x = 0;
+#if CV_SIMD
+    const int n = v_uint8::nlanes;
+    for (; x <= cols - n; x += n) {
+        v_uint16 lo = vx_setzero_u16(), hi = vx_setzero_u16();
+        for (int k = 0; k < 7; ++k) {
+            v_uint16 a, b;
+            v_expand(vx_load(src + x + k), a, b);
+            const v_uint16 w = vx_setall_u16(kGauss[k]);
+            lo += a * w; hi += b * w;
+        }
+        v_store(dst + x, v_rshr_pack<8>(lo, hi));
+    }
+#endif
+    for (; x < cols; ++x) {
+        unsigned s = 0;
+        for (int k = 0; k < 7; ++k) s += kGauss[k] * src[x + k];
+        dst[x] = (uchar)((s + 128) >> 8);
+    }
+}
+
+// 세로 7탭: rows[0..6] 같은 열 -> dst 행
+static void blurRowV(const uchar* const* rows, uchar* dst, int cols) {
+    int x = 0;
+#if CV_SIMD
+    const int n = v_uint8::nlanes;
+    for (; x <= cols - n; x += n) {
+        v_uint16 lo = vx_setzero_u16(), hi = vx_setzero_u16();
+        for (int k = 0; k < 7; ++k) {
+            v_uint16 a, b;
+            v_expand(vx_load(rows[k] + x), a, b);
+            const v_uint16 w = vx_setall_u16(kGauss[k]);
+            lo += a * w; hi += b * w;
+        }
+        v_store(dst + x, v_rshr_pack<8>(lo, hi));
+    }
+#endif
+    for (; x < cols; ++x) {
+        unsigned s = 0;
+        for (int k = 0; k < 7; ++k) s += kGauss[k] * rows[k][x];
+        dst[x] = (uchar)((s + 128) >> 8);
+    }
+}
+
+// 행 하나의 sum(w), sum(x*w). SIMD는 int32 레인에 누적하므로 앞 2048열까지만 (x*w 합 < 2^31), 나머지는 스칼라
+static void rowMoments(const uchar* p, int cols, int64_t& s0, int64_t& s1) {
+    int x = 0;
+    int64_t a0 = 0, a1 = 0;
+#if CV_SIMD
+    const int n = v_uint8::nlanes, h = v_int16::nlanes;
+    int16_t idx[v_int16::nlanes];
+    for (int i = 0; i < h; ++i) idx[i] = (int16_t)i;
+    v_int16 xlo = vx_load(idx), xhi = xlo + vx_setall_s16((int16_t)h);
+    const v_int16 step = vx_setall_s16((int16_t)n), ones = vx_setall_s16(1);
+    v_int32 acc0 = vx_setzero_s32(), acc1 = vx_setzero_s32();
+    const int simdEnd = std::min(cols, 2048);
+    for (; x <= simdEnd - n; x += n) {
+        v_uint16 a, b;
+        v_expand(vx_load(p + x), a, b);
+        const v_int16 wa = v_reinterpret_as_s16(a), wb = v_reinterpret_as_s16(b);
+        acc0 += v_dotprod(wa, ones) + v_dotprod(wb, ones);
+        acc1 += v_dotprod(wa, xlo) + v_dotprod(wb, xhi);
+        xlo += step; xhi += step;
+    }
+    a0 = v_reduce_sum(acc0);
+    a1 = v_reduce_sum(acc1);
+#endif
+    for (; x < cols; ++x) { a0 += p[x]; a1 += (int64_t)x * p[x]; }
+    s0 = a0; s1 = a1;
+}
+
+static uint64_t isqrt64(uint64_t v) {
+    uint64_t r = 0, bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) { v -= r + bit; r = (r >> 1) + bit; }
+        else r >>= 1;
+        bit >>= 2;
+    }
+    return r;
+}
+
+// blur: 평활된 ROI. equalize=false면 이미 정규화된 입력 (FacePreprocessor) -> 히스토그램 평활화 LUT 생략
+static bool fixedFromBlurred(const Mat& blur, bool equalize, float& nx, float& ny, float* conf);
+
+bool darkCentroidNormFixed(const Mat& eyeGray, float& nx, float& ny, float* conf) {
+    if (eyeGray.empty() || eyeGray.rows < 5 || eyeGray.cols < 5 || eyeGray.type() != CV_8UC1)
+        return false;
+    const int rows = eyeGray.rows, cols = eyeGray.cols;
+
+    // 1) 7x7 가우시안 (분리형, 경계 BORDER_REFLECT_101 = GaussianBlur 기본값)
+    Mat pad; copyMakeBorder(eyeGray, pad, 3, 3, 3, 3, BORDER_REFLECT_101);
+    Mat h(rows + 6, cols, CV_8UC1), blur(rows, cols, CV_8UC1);
+    for (int r = 0; r < rows + 6; ++r) blurRowH(pad.ptr<uchar>(r), h.ptr<uchar>(r), cols);
+    for (int r = 0; r < rows; ++r) {
+        const uchar* src[7];
+        for (int k = 0; k < 7; ++k) src[k] = h.ptr<uchar>(r + k);
+        blurRowV(src, blur.ptr<uchar>(r), cols);
+    }
+    return fixedFromBlurred(blur, true, nx, ny, conf);
+}
+
+bool darkCentroidNormFixedPrepared(const Mat& eyeNorm, float& nx, float& ny, float* conf) {
+    if (eyeNorm.empty() || eyeNorm.rows < 5 || eyeNorm.cols < 5 || eyeNorm.type() != CV_8UC1)
+        return false;
+    return fixedFromBlurred(eyeNorm, false, nx, ny, conf);
+}
+
+static bool fixedFromBlurred(const Mat& blur, bool equalize, float& nx, float& ny, float* conf) {
+    const int rows = blur.rows, cols = blur.cols;
+
+    // 2) 히스토그램 하나로 equalizeHist + 반전 + 평균/표준편차 + THRESH_TOZERO를 LUT 하나로 접음
+    int hist[256] = { 0 };
+    for (int r = 0; r < rows; ++r) {
+        const uchar* p = blur.ptr<uchar>(r);
+        for (int x = 0; x < cols; ++x) ++hist[p[x]];
+    }
+    const int64_t N = (int64_t)rows * cols;
+    int i0 = 0;
+    while (!hist[i0]) ++i0;
+    if (hist[i0] == N) return false;   // 단색: float 경로도 가중치가 전부 0
+
+    // equalizeHist: lut[i] = round(255 * (cdf[i] - cdf[i0]) / (N - hist[i0]))
+    uchar inv[256];
+    const int64_t D = N - hist[i0];
+    int64_t cdf = 0;
+    for (int i = 0; i < 256; ++i) {
+        if (i > i0) cdf += hist[i];
+        const int eq = !equalize ? i : i <= i0 ? 0 : (int)((cdf * 510 + D) / (2 * D));
+        inv[i] = (uchar)(255 - eq);
+    }
+
+    // 반전 이미지 평균 + 0.6 * 표준편차 (모집단) -> 정수 임계값 T (inv > t  <=>  inv > floor(t))
+    int64_t S = 0, SS = 0;
+    for (int i = 0; i < 256; ++i) { S += (int64_t)hist[i] * inv[i]; SS += (int64_t)hist[i] * inv[i] * inv[i]; }
+    const int64_t sdN = (int64_t)isqrt64((uint64_t)std::max<int64_t>(0, N * SS - S * S));   // std * N
+    const int64_t T = (5 * S + 3 * sdN) / (5 * N);
+
+    Mat lut(1, 256, CV_8UC1);
+    for (int i = 0; i < 256; ++i) lut.at<uchar>(i) = inv[i] > T ? inv[i] : 0;
+    Mat w; LUT(blur, lut, w);
+
+    // 3) 모폴로지 (OpenCV 8U 경로가 이미 정수 SIMD)
+    morphologyEx(w, w, MORPH_OPEN, getStructuringElement(MORPH_ELLIPSE, Size(3, 3)));
+    morphologyEx(w, w, MORPH_CLOSE, getStructuringElement(MORPH_ELLIPSE, Size(5, 5)));
+
+    // 4) 0/1차 모멘트 (정수 누적)
+    int64_t m00 = 0, m10 = 0, m01 = 0;
+    for (int r = 0; r < rows; ++r) {
+        int64_t s0, s1;
+        rowMoments(w.ptr<uchar>(r), cols, s0, s1);
+        m00 += s0; m10 += s1; m01 += (int64_t)r * s0;
+    }
+    if (m00 < 20000) return false;
+
+    const float cx = (float)((double)m10 / m00);
+    const float cy = (float)((double)m01 / m00);
+    nx = (cx - (cols - 1) * 0.5f) / std::max(1.f, cols * 0.5f);
+    ny = (cy - (rows - 1) * 0.5f) / std::max(1.f, rows * 0.5f);
+    nx = std::clamp(nx, -1.5f, 1.5f);
+    ny = std::clamp(ny, -1.5f, 1.5f);
+
+    if (conf) {
+        float massC = (float)std::min<int64_t>(80000, m00 - 20000) / 80000.f;
+        float sizeC = std::min(1.f, cols / 40.f);
+        *conf = std::max(0.05f, massC * sizeC);
+    }
+    return true;
+}
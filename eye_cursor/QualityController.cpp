@@ -0,0 +1,67 @@
+// QualityController.cpp
+#include "QualityController.h"
+#include <algorithm>
+#include <cstdio>
+
+// 품질 손실이 작은 것부터: 그리기 -> 눈 검출 간격 -> 피라미드 배율 -> 검출 해상도
+const std::vector<QualityLevel>& QualityController::levels()
+{
+    static const std::vector<QualityLevel> L = {
+        { "full",        1.00f, 0.0, 1, true },
+        { "no-debug",    1.00f, 0.0, 1, false },
+        { "eye/2",       1.00f, 0.0, 2, false },
+        { "sf1.2",       1.00f, 1.2, 2, false },
+        { "face@0.75",   0.75f, 1.2, 3, false },
+        { "face@0.5",    0.50f, 1.3, 4, false },
+    };
+    return L;
+}
+
+QualityController::QualityController(std::string tag, QualityOptions opt)
+    : tag_(std::move(tag)), opt_(opt), hist_((size_t)std::max(1, opt.window))
+{
+}
+
+bool QualityController::update(const StageTimes& t)
+{
+    if (!opt_.enabled) return false;
+    hist_[n_ % hist_.size()] = t;
+    ++n_;
+    if (n_ < hist_.size()) return false;
+
+    float mean = 0.f;
+    for (const StageTimes& s : hist_) mean += s.totalMs;
+    mean /= (float)hist_.size();
+
+    if (mean > opt_.budgetMs) {
+        // 올리자마자 넘침 = 그 단계는 아직 무리 -> 다음 복구는 더 오래 기다림
+        if (justRestored_) backoff_ = std::min(16, backoff_ * 2);
+        if (level_ + 1 < (int)levels().size()) { change(level_ + 1, mean); return true; }
+        calm_ = 0;
+        return false;
+    }
+    if (justRestored_) { justRestored_ = false; backoff_ = std::max(1, backoff_ / 2); }
+
+    calm_ = mean < opt_.budgetMs * opt_.restoreRatio ? calm_ + 1 : 0;
+    if (level_ > 0 && calm_ >= opt_.restoreHold * backoff_) {
+        change(level_ - 1, mean);
+        justRestored_ = true;
+        return true;
+    }
+    return false;
+}
+
+void QualityController::change(int to, float meanMs)
+{
+    // 원인 단계가 보이게 창 평균의 단계별 시간도 같이
+    float face = 0.f, eye = 0.f, pupil = 0.f;
+    for (const StageTimes& s : hist_) { face += s.faceMs; eye += s.eyeMs; pupil += s.pupilMs; }
+    const float k = 1.f / (float)hist_.size();
+    std::printf("[Quality] %s L%d %s -> L%d %s: %.1f ms %s %.1f ms budget (face %.1f eye %.1f pupil %.1f)\n",
+        tag_.c_str(), level_, levels()[level_].name, to, levels()[to].name,
+        meanMs, to > level_ ? ">" : "<<", opt_.budgetMs, face * k, eye * k, pupil * k);
+    std::fflush(stdout);
+    level_ = to;
+    n_ = 0;
+    calm_ = 0;
+}
@@ -0,0 +1,61 @@
+// QualityController.h
+// 프레임 처리 시간 예산 유지: 부하가 크면 품질 단계를 내리고(검출 해상도, 캐스케이드 배율, 눈 검출 간격, 디버그 그리기)
+// 여유가 생기면 되돌림. 단계가 바뀔 때마다 로그
+#pragma once
+#include <string>
+#include <vector>
+
+// 품질 단계 하나 (0 = 최고 품질)
+struct QualityLevel {
+    const char* name;
+    float detectScale;          // 얼굴 검출 입력 축소 비율 (1 = 처리 영역 그대로)
+    double minScaleFactor;      // 캐스케이드 scaleFactor 하한 (프로파일 값이 더 크면 그대로)
+    int eyeEvery;               // 눈 검출을 N프레임마다 (사이 프레임은 얼굴 기준 상대 위치 재사용)
+    bool debugDraw;             // 디버그 프레임에 박스/텍스트 그리기
+};
+
+// 한 프레임의 단계별 처리 시간 (캡처 대기 제외)
+struct StageTimes {
+    float faceMs = 0.f, eyeMs = 0.f, pupilMs = 0.f;
+    float totalMs = 0.f;        // 캡처 이후 결과 게시까지
+};
+
+struct QualityOptions {
+    bool enabled = true;
+    float budgetMs = 33.f;      // 프레임 처리 예산 (30fps)
+    float restoreRatio = 0.6f;  // 평균이 예산의 이 비율 아래로 유지되면 한 단계 복구
+    int window = 30;            // 판단에 쓰는 최근 프레임 수 (단계가 바뀌면 새로 채움)
+    int restoreHold = 90;       // 복구 전 여유가 유지돼야 하는 프레임 수 (복구 직후 다시 내려가면 두 배, 최대 16배)
+};
+
+/**
+ * @class QualityController
+ * @brief 카메라 스레드마다 하나. 프레임마다 update()로 처리 시간을 넣으면 최근 window 프레임 평균을 예산과 비교합니다.
+ * 넘으면 한 단계 내리고, 예산의 restoreRatio 아래가 restoreHold 프레임 유지되면 한 단계 올립니다.
+ * 단계를 바꾼 직후에는 창을 비워 새 단계의 시간만으로 다시 판단합니다.
+ * 올린 직후 곧바로 다시 내려가면 복구 대기를 늘려 두 단계 사이를 오가지 않게 합니다.
+ */
+class QualityController {
+public:
+    explicit QualityController(std::string tag, QualityOptions opt = QualityOptions());
+
+    // 이번 프레임 처리 시간 반영. 단계가 바뀌면 true (stdout 로그)
+    bool update(const StageTimes& t);
+
+    const QualityLevel& level() const { return levels()[level_]; }
+    int levelIndex() const { return level_; }
+
+    static const std::vector<QualityLevel>& levels();
+
+private:
+    void change(int to, float meanMs);
+
+    std::string tag_;
+    QualityOptions opt_;
+    int level_ = 0;
+    std::vector<StageTimes> hist_;  // 최근 window 프레임 (링)
+    size_t n_ = 0;                  // 현재 단계에서 쌓인 프레임 수
+    int calm_ = 0;                  // 연속 여유 프레임 수
+    int backoff_ = 1;               // 복구 대기 배수
+    bool justRestored_ = false;     // 마지막 변경이 복구였고 아직 창이 다 안 참
+};
@@ -0,0 +1,176 @@
+// ScreenTopology.cpp
+#include "ScreenTopology.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <shellscalingapi.h>
+#pragma comment(lib, "Shcore.lib")
+#endif
+
+using namespace cv;
+
+// 점 ~ 사각형 거리 제곱 (안이면 0)
+static float distance2(Point2f p, const Rect& r) {
+    float dx = std::max({ (float)r.x - p.x, 0.f, p.x - (float)(r.x + r.width - 1) });
+    float dy = std::max({ (float)r.y - p.y, 0.f, p.y - (float)(r.y + r.height - 1) });
+    return dx * dx + dy * dy;
+}
+
+#ifdef _WIN32
+static BOOL CALLBACK enumMonitor(HMONITOR h, HDC, LPRECT, LPARAM lp) {
+    std::vector<MonitorInfo>* out = reinterpret_cast<std::vector<MonitorInfo>*>(lp);
+    MONITORINFOEXA mi = {};
+    mi.cbSize = sizeof(mi);
+    if (!GetMonitorInfoA(h, &mi)) return TRUE;
+    MonitorInfo m;
+    m.name = mi.szDevice;
+    m.bounds = Rect(mi.rcMonitor.left, mi.rcMonitor.top,
+        mi.rcMonitor.right - mi.rcMonitor.left, mi.rcMonitor.bottom - mi.rcMonitor.top);
+    m.primary = (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
+    UINT dx = 96, dy = 96;
+    if (GetDpiForMonitor(h, MDT_EFFECTIVE_DPI, &dx, &dy) == S_OK) m.dpiScale = dx / 96.f;
+    out->push_back(m);
+    return TRUE;
+}
+#endif
+
+void ScreenTopology::enableDpiAwareness()
+{
+#ifdef _WIN32
+    // 인식하지 않으면 배율 125%+ 모니터에서 좌표가 논리 px로 축소되어 SetCursorPos가 어긋남
+    if (!SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2))
+        SetProcessDpiAwareness(PROCESS_PER_MONITOR_DPI_AWARE);   // Windows 8.1 ~ 10 1607
+#endif
+}
+
+ScreenTopology ScreenTopology::detect()
+{
+    ScreenTopology t;
+#ifdef _WIN32
+    EnumDisplayMonitors(nullptr, nullptr, enumMonitor, reinterpret_cast<LPARAM>(&t.mons_));
+    if (!t.mons_.empty()) { t.build(); return t; }
+    std::cerr << "EnumDisplayMonitors failed, using primary screen size\n";
+    parse(std::to_string(GetSystemMetrics(SM_CXSCREEN)) + "x" + std::to_string(GetSystemMetrics(SM_CYSCREEN)) + "+0+0", t);
+#else
+    // 헤드리스/테스트용 스텁
+    const char* env = std::getenv("EYE_SCREENS");
+    if (!env || !parse(env, t)) parse("1920x1080+0+0", t);
+#endif
+    return t;
+}
+
+bool ScreenTopology::parse(const std::string& spec, ScreenTopology& out)
+{
+    std::vector<MonitorInfo> mons;
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t end = spec.find(',', pos);
+        if (end == std::string::npos) end = spec.size();
+        const std::string item = spec.substr(pos, end - pos);
+        pos = end + 1;
+        if (item.empty()) continue;
+
+        int w = 0, h = 0, x = 0, y = 0;
+        float scale = 1.f;
+        if (std::sscanf(item.c_str(), "%dx%d%d%d@%f", &w, &h, &x, &y, &scale) < 4 || w <= 0 || h <= 0 || scale <= 0.f) {
+            std::cerr << "Screen spec invalid: " << item << " (WxH+X+Y[@scale])\n";
+            return false;
+        }
+        MonitorInfo m;
+        m.name = "screen" + std::to_string(mons.size());
+        m.bounds = Rect(x, y, w, h);
+        m.dpiScale = scale;
+        m.primary = mons.empty();
+        mons.push_back(m);
+    }
+    if (mons.empty()) return false;
+    out.mons_ = mons;
+    out.build();
+    return true;
+}
+
+void ScreenTopology::build()
+{
+    virt_ = mons_[0].bounds;
+    for (MonitorInfo& m : mons_) {
+        virt_ |= m.bounds;
+        m.org = Point2f((float)m.bounds.x, (float)m.bounds.y);
+        m.size = Point2f((float)(m.bounds.width - 1), (float)(m.bounds.height - 1));
+    }
+
+    // 칸별 모니터 후보
+    cols_ = (virt_.width + kCell - 1) / kCell;
+    rows_ = (virt_.height + kCell - 1) / kCell;
+    cellCount_.assign((size_t)cols_ * rows_, 0);
+    cellMons_.assign((size_t)cols_ * rows_ * 4, 0);
+    for (int r = 0; r < rows_; ++r)
+        for (int c = 0; c < cols_; ++c) {
+            const size_t i = (size_t)r * cols_ + c;
+            const Rect cell(virt_.x + c * kCell, virt_.y + r * kCell, kCell, kCell);
+            for (size_t m = 0; m < mons_.size() && cellCount_[i] < 4; ++m)
+                if ((cell & mons_[m].bounds).area() > 0) cellMons_[i * 4 + cellCount_[i]++] = (uint8_t)m;
+            if (cellCount_[i] > 0) continue;
+
+            // 모니터 사이 빈 칸: 칸 중심에서 가장 가까운 모니터
+            const Point2f center(cell.x + kCell * 0.5f, cell.y + kCell * 0.5f);
+            size_t best = 0;
+            for (size_t m = 1; m < mons_.size(); ++m)
+                if (distance2(center, mons_[m].bounds) < distance2(center, mons_[best].bounds)) best = m;
+            cellMons_[i * 4] = (uint8_t)best;
+            cellCount_[i] = 1;
+        }
+}
+
+int ScreenTopology::primary() const
+{
+    for (size_t i = 0; i < mons_.size(); ++i)
+        if (mons_[i].primary) return (int)i;
+    return 0;
+}
+
+int ScreenTopology::monitorAt(Point2f p) const
+{
+    if (mons_.empty()) return -1;
+    if (!(p.x == p.x && p.y == p.y)) return primary();   // NaN
+    const int c = (int)std::clamp(std::floor((p.x - virt_.x) / kCell), 0.f, (float)(cols_ - 1));
+    const int r = (int)std::clamp(std::floor((p.y - virt_.y) / kCell), 0.f, (float)(rows_ - 1));
+    const size_t i = (size_t)r * cols_ + c;
+
+    int best = cellMons_[i * 4];
+    float bestD = distance2(p, mons_[best].bounds);
+    for (int k = 1; k < cellCount_[i] && bestD > 0.f; ++k) {
+        const int m = cellMons_[i * 4 + k];
+        const float d = distance2(p, mons_[m].bounds);
+        if (d < bestD) { best = m; bestD = d; }
+    }
+    return best;
+}
+
+Point ScreenTopology::clamp(Point2f p) const
+{
+    const int m = monitorAt(p);
+    if (m < 0) return Point();
+    const Rect& b = mons_[m].bounds;
+    const int x = (p.x == p.x) ? (int)std::lround(p.x) : b.x + b.width / 2;
+    const int y = (p.y == p.y) ? (int)std::lround(p.y) : b.y + b.height / 2;
+    return Point(std::clamp(x, b.x, b.x + b.width - 1), std::clamp(y, b.y, b.y + b.height - 1));
+}
+
+std::vector<Point2f> ScreenTopology::gridTargets(int monitor, int n, float margin) const
+{
+    std::vector<Point2f> out;
+    if (monitor < 0 || monitor >= (int)mons_.size()) return out;
+    n = std::max(2, n);
+    const MonitorInfo& m = mons_[monitor];
+    for (int r = 0; r < n; ++r)
+        for (int c = 0; c < n; ++c)
+            out.push_back(m.toVirtual(margin + (1.f - 2.f * margin) * c / (n - 1),
+                margin + (1.f - 2.f * margin) * r / (n - 1)));
+    return out;
+}
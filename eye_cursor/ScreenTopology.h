@@ -0,0 +1,62 @@
+// ScreenTopology.h
+// 모니터 배치 (가상 데스크톱 좌표) + 모니터별 클램프/타깃 생성
+// Windows: EnumDisplayMonitors (프로세스 DPI 인식 = 모니터별 V2 -> 모든 좌표가 물리 px)
+// 그 외(헤드리스 Linux 등): EYE_SCREENS 환경 변수 또는 1920x1080 하나짜리 스텁
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MonitorInfo {
+    std::string name;
+    cv::Rect bounds;            // 가상 데스크톱 물리 px (주 모니터 왼쪽 위 = 0,0, 음수 가능)
+    float dpiScale = 1.f;       // 96 DPI = 1.0
+    bool primary = false;
+
+    // 모니터 안 비율 (0..1) -> 가상 데스크톱 px (미리 계산한 오프셋/배율)
+    cv::Point2f toVirtual(float u, float v) const { return cv::Point2f(org.x + u * size.x, org.y + v * size.y); }
+
+    cv::Point2f org, size;      // build()가 채움
+};
+
+/**
+ * @class ScreenTopology
+ * @brief 모니터 목록과 가상 데스크톱 범위. 커서 좌표(Poly2 출력)는 항상 가상 데스크톱 px입니다.
+ * 가상 데스크톱을 kCell px 칸으로 나눠 칸마다 겹치는 모니터 후보(최대 4개, 없으면 가장 가까운 모니터)를
+ * 미리 저장해 두므로 점 -> 모니터 찾기와 클램프는 모니터 수와 무관하게 상수 시간입니다.
+ */
+class ScreenTopology {
+public:
+    static constexpr int kCell = 64;
+
+    // 현재 시스템 모니터 (실패하면 스텁)
+    static ScreenTopology detect();
+
+    // "WxH+X+Y[@배율],..." 예) "1920x1080+0+0,2560x1440+1920+0@1.5". 첫 항목이 주 모니터
+    static bool parse(const std::string& spec, ScreenTopology& out);
+
+    // 모니터별 DPI 인식 켜기 (Windows, 창을 만들기 전에 한 번). 다른 OS는 아무것도 안 함
+    static void enableDpiAwareness();
+
+    const std::vector<MonitorInfo>& monitors() const { return mons_; }
+    const cv::Rect& virtualBounds() const { return virt_; }
+    int primary() const;
+
+    // p가 들어 있는 모니터, 모니터 사이 빈 곳이면 가장 가까운 모니터
+    int monitorAt(cv::Point2f p) const;
+    // p를 monitorAt(p) 모니터 안으로
+    cv::Point clamp(cv::Point2f p) const;
+
+    // 모니터 하나의 n×n 격자 타깃 (가상 데스크톱 px, 행 우선)
+    std::vector<cv::Point2f> gridTargets(int monitor, int n, float margin) const;
+
+private:
+    void build();
+
+    std::vector<MonitorInfo> mons_;
+    cv::Rect virt_;
+    int cols_ = 0, rows_ = 0;
+    std::vector<uint8_t> cellCount_;        // 칸별 후보 수
+    std::vector<uint8_t> cellMons_;         // 칸별 후보 모니터 인덱스 4개
+};
@@ -1,79 +1,43 @@
 // gaze_absolute_cursor_win_blink_click.cpp
-// OpenCV만: 시선(nx,ny) -> 2차 다항식 매핑으로 절대좌표 + 숫자키(1~9) 캘리브레이션 + 왼/오른쪽 눈 깜빡이 클릭 (안정화 패치)
+// OpenCV만: 시선(nx,ny) -> 2차 다항식 매핑으로 절대좌표 + 숫자키(1~9)/자동(C) 캘리브레이션 + 왼/오른쪽 눈 깜빡이 클릭 (안정화 패치)
+// 카메라 N대 지원: 카메라마다 검출 스레드 + 개별 Poly2, 메인에서 신뢰도/시각 정렬로 융합
+//   사용법: eye_tracking_cursor_click [카메라번호...] [--stream [소켓경로]] [--shm [이름]] [--profile 검출프로파일.yml]
+//           [--detectors 검출기설정.yml] [--full-frame] [--calib-points 9|16] [--calib-agg median|ransac]
+//           [--screens WxH+X+Y[@배율],...] [--pupil float|fixed] [--heatmap [파일접두사]] [--heatmap-halflife 초]
+//           [--budget ms] [--no-quality] [--no-coarse] [--cursor-rate hz] [--no-upsample]
+//           [--standby 초] [--pupil-cache off|임계값] [--frame-pool N]
+//           (기본: 0번, 스트림/공유메모리 끔, Haar 얼굴/눈 + 기본 검출 파라미터, 탐색/추적 캡처 모드 전환,
+//            자동 캘리브레이션 모니터당 9점 + RANSAC, 모니터 배치는 시스템에서, 동공 추정은 ARM이면 fixed,
+//            프레임 처리 예산 33ms 넘으면 품질 단계 자동 조절, 커서는 모니터 주사율로 예측 출력,
+//            얼굴 없이 30초면 대기 모드: 320x180/5fps 움직임 감지만, 눈 ROI가 그대로면 동공 결과 재사용)
+#define NOMINMAX
 #include <opencv2/opencv.hpp>
 #include <windows.h>
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <string>
 #include <vector>
+#include "AutoCalibrator.h"
+#include "CameraPipeline.h"
+#include "CpuMeter.h"
+#include "CursorOutput.h"
+#include "DetectorProfile.h"
+#include "DetectorRegistry.h"
+#include "FixationDetector.h"
+#include "GazeFusion.h"
+#include "GazeHeatmap.h"
+#include "GazeModel.h"
+#include "GazePublisher.h"
+#include "GazeShmWriter.h"
+#include "PipelineClock.h"
+#include "ScreenTopology.h"
 
 using namespace cv;
 using std::cout; using std::endl;
 
-struct Sample {
-    float nx, ny;   // 입력: 시선 정규화
-    float sx, sy;   // 타깃: 화면 px
-};
-
-struct Poly2 {
-    Mat A, B; // 6x1
-    bool fit(const std::vector<Sample>& S) {
-        if (S.size() < 6) return false;
-        Mat M((int)S.size(), 6, CV_32F), X((int)S.size(), 1, CV_32F), Y((int)S.size(), 1, CV_32F);
-        for (int i = 0; i < (int)S.size(); ++i) {
-            float nx = S[i].nx, ny = S[i].ny;
-            M.at<float>(i, 0) = 1.f;  M.at<float>(i, 1) = nx;  M.at<float>(i, 2) = ny;
-            M.at<float>(i, 3) = nx * ny; M.at<float>(i, 4) = nx * nx; M.at<float>(i, 5) = ny * ny;
-            X.at<float>(i, 0) = S[i].sx; Y.at<float>(i, 0) = S[i].sy;
-        }
-        Mat Acoef, Bcoef;
-        bool ok1 = solve(M, X, Acoef, DECOMP_SVD);
-        bool ok2 = solve(M, Y, Bcoef, DECOMP_SVD);
-        if (!(ok1 && ok2)) return false;
-        A = Acoef.clone(); B = Bcoef.clone(); return true;
-    }
-    bool map(float nx, float ny, float& sx, float& sy) const {
-        if (A.empty() || B.empty()) return false;
-        float f[6] = { 1.f,nx,ny,nx * ny,nx * nx,ny * ny };
-        sx = 0.f; sy = 0.f;
-        for (int i = 0; i < 6; ++i) { sx += A.at<float>(i, 0) * f[i]; sy += B.at<float>(i, 0) * f[i]; }
-        return true;
-    }
-};
-
-static float ema1(float prev, float cur, float a) { return prev * (1.f - a) + cur * a; }
-
-// --- 시선 검출: 어두운 질량 중심 -> (nx, ny) ---
-static bool darkCentroidNorm(const Mat& eyeGray, float& nx, float& ny) {
-    // ★ FIX: 빈/작은/타입 체크 (기존 CV_Assert 제거)
-    if (eyeGray.empty() || eyeGray.total() == 0 || eyeGray.rows < 5 || eyeGray.cols < 5 || eyeGray.type() != CV_8UC1)
-        return false;
-
-    Mat blur; GaussianBlur(eyeGray, blur, Size(7, 7), 0);
-    Mat eq;   equalizeHist(blur, eq);             // ★ FIX: equalizeHist(blur, eq) (기존 코드 버그)
-    Mat inv;  bitwise_not(eq, inv);
-
-    if (inv.empty() || inv.total() == 0) return false; // ★ FIX: 가드
-    Scalar m, s; meanStdDev(inv, m, s);
-    double t = m[0] + 0.6 * s[0];
-
-    Mat w; threshold(inv, w, t, 255, THRESH_TOZERO);
-    morphologyEx(w, w, MORPH_OPEN, getStructuringElement(MORPH_ELLIPSE, Size(3, 3)));
-    morphologyEx(w, w, MORPH_CLOSE, getStructuringElement(MORPH_ELLIPSE, Size(5, 5)));
-    Moments mu = moments(w, false);
-    if (mu.m00 < 2e4) return false;
-
-    float cx = (float)(mu.m10 / mu.m00);
-    float cy = (float)(mu.m01 / mu.m00);
-    float centerX = (eyeGray.cols - 1) * 0.5f;
-    float centerY = (eyeGray.rows - 1) * 0.5f;
-
-    nx = (cx - centerX) / max(1.f, eyeGray.cols * 0.5f);
-    ny = (cy - centerY) / max(1.f, eyeGray.rows * 0.5f);
-    nx = std::clamp(nx, -1.5f, 1.5f);
-    ny = std::clamp(ny, -1.5f, 1.5f);
-    return true;
-}
-
 // --- Windows 커서 ---
 static void setCursorAbs(int x, int y) { SetCursorPos(x, y); }
 static void clickLeft() {
@@ -89,199 +53,437 @@ static void clickRight() {
     SendInput(2, in, sizeof(INPUT));
 }
 
-int main() {
-    // --- 분류기 ---
-    std::string faceXml = "haarcascade_frontalface_default.xml";
-    std::string eyeXml = "haarcascade_eye_tree_eyeglasses.xml";
-    CascadeClassifier faceC, eyeC;
-    if (!faceC.load(faceXml) || !eyeC.load(eyeXml)) {
-        std::cerr << "Load cascade failed. Check paths.\n"; return -1;
-    }
-
-    // --- 카메라 & 화면 ---
-    VideoCapture cap(0);
-    if (!cap.isOpened()) { std::cerr << "Camera open failed\n"; return -1; }
-    cap.set(CAP_PROP_FRAME_WIDTH, 1280);
-    cap.set(CAP_PROP_FRAME_HEIGHT, 720);
+// 카메라 번호는 숫자로만 (오타 난 옵션, 값이 빠진 옵션이 0번 카메라로 새지 않게)
+static bool isCameraId(const std::string& a) {
+    return !a.empty() && std::all_of(a.begin(), a.end(), [](char c) { return std::isdigit((unsigned char)c) != 0; });
+}
 
-    const int SW = GetSystemMetrics(SM_CXSCREEN);
-    const int SH = GetSystemMetrics(SM_CYSCREEN);
+static void printUsage(const char* prog) {
+    std::cerr << "usage: " << prog << " [camera...] [--stream [path]] [--shm [name]] [--profile file.yml]\n"
+        "    [--detectors file.yml] [--full-frame] [--calib-points 9|16] [--calib-agg median|ransac]\n"
+        "    [--screens WxH+X+Y[@scale],...] [--pupil float|fixed] [--heatmap [prefix]] [--heatmap-halflife sec]\n"
+        "    [--budget ms] [--no-quality] [--no-coarse] [--cursor-rate hz] [--no-upsample]\n"
+        "    [--standby sec] [--pupil-cache off|threshold] [--frame-pool N]" << endl;
+}
 
-    // 9점 타깃
-    POINT targets[9] = {
-        {int(0.10 * SW), int(0.10 * SH)}, {int(0.50 * SW), int(0.10 * SH)}, {int(0.90 * SW), int(0.10 * SH)},
-        {int(0.10 * SW), int(0.50 * SH)}, {int(0.50 * SW), int(0.50 * SH)}, {int(0.90 * SW), int(0.50 * SH)},
-        {int(0.10 * SW), int(0.90 * SH)}, {int(0.50 * SW), int(0.90 * SH)}, {int(0.90 * SW), int(0.90 * SH)}
-    };
+int main(int argc, char** argv) {
+    // 모니터별 DPI 인식: 모든 좌표(모니터 배치, SetCursorPos, 창 위치)를 물리 px로 통일
+    ScreenTopology::enableDpiAwareness();
+    ScreenTopology screens = ScreenTopology::detect();
+
+    // --- 검출기 (기본: 작업 폴더의 Haar XML, --detectors로 LBP/YuNet 등 선택) ---
+    DetectorRegistry registry;
+    std::string detectorsPath;
+
+    // --- 카메라 (인자로 번호 여러 개, 없으면 0번) + 옵션 ---
+    std::vector<int> camIds;
+    bool streamOn = false, shmOn = false;
+    std::string streamPath = GAZE_STREAM_DEFAULT_PATH;
+    std::string shmName = GAZE_SHM_DEFAULT_NAME;
+    DetectorProfile profile;
+    CaptureOptions capture;   // --full-frame: 예전처럼 항상 1280x720 전체 프레임
+    QualityOptions quality;   // --no-quality: 부하와 상관없이 최고 품질 고정
+    AutoCalibOptions autoOpt;
+    PupilImpl pupil = kDefaultPupilImpl;
+    bool coarsePupil = true;   // --no-coarse: 눈 박스 전체에서 동공 추정
+    PupilCacheOptions pupilCache;   // --pupil-cache off: 매 프레임 계산, 숫자: 시그니처 차이 임계값
+    int framePool = 8;              // --frame-pool N: 카메라당 프레임 버퍼 슬랩 수 (0 = 풀 없이 매 프레임 할당)
+    bool heatmapOn = false;
+    std::string heatmapPrefix = "gaze_heatmap";
+    HeatmapOptions heatOpt;
+    CursorOutputOptions cursorOpt;   // --no-upsample: 예전처럼 카메라 프레임마다 바로 커서 이동
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--stream") {
+            streamOn = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-' && !std::isdigit((unsigned char)argv[i + 1][0])) streamPath = argv[++i];
+        }
+        else if (a == "--shm") {
+            shmOn = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-' && !std::isdigit((unsigned char)argv[i + 1][0])) shmName = argv[++i];
+        }
+        else if (a == "--profile" && i + 1 < argc) {
+            if (!profile.load(argv[++i])) return -1;
+        }
+        else if (a == "--full-frame") capture.adaptive = false;
+        else if (a == "--standby" && i + 1 < argc) capture.standbyAfterSec = (float)std::atof(argv[++i]);
+        else if (a == "--no-quality") quality.enabled = false;
+        else if (a == "--no-coarse") coarsePupil = false;
+        else if (a == "--frame-pool" && i + 1 < argc) framePool = std::max(0, std::atoi(argv[++i]));
+        else if (a == "--pupil-cache" && i + 1 < argc) {
+            const std::string v = argv[++i];
+            if (v == "off") pupilCache.enabled = false;
+            else pupilCache.maxDiff = (float)std::atof(v.c_str());
+        }
+        else if (a == "--no-upsample") cursorOpt.enabled = false;
+        else if (a == "--cursor-rate" && i + 1 < argc) cursorOpt.rateHz = (float)std::atof(argv[++i]);
+        else if (a == "--budget" && i + 1 < argc) quality.budgetMs = (float)std::atof(argv[++i]);
+        else if (a == "--calib-points" && i + 1 < argc) autoOpt.grid = std::atoi(argv[++i]) >= 16 ? 4 : 3;
+        else if (a == "--screens" && i + 1 < argc) {
+            if (!ScreenTopology::parse(argv[++i], screens)) return -1;
+        }
+        else if (a == "--heatmap") {
+            heatmapOn = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-' && !std::isdigit((unsigned char)argv[i + 1][0])) heatmapPrefix = argv[++i];
+        }
+        else if (a == "--heatmap-halflife" && i + 1 < argc) heatOpt.halfLifeSec = (float)std::atof(argv[++i]);
+        else if (a == "--pupil" && i + 1 < argc) {
+            pupil = std::string(argv[++i]) == "fixed" ? PupilImpl::Fixed : PupilImpl::Float;
+        }
+        else if (a == "--calib-agg" && i + 1 < argc) {
+            autoOpt.aggregate = std::string(argv[++i]) == "median" ? CalibAggregate::Median : CalibAggregate::Ransac;
+        }
+        else if (a == "--detectors" && i + 1 < argc) {
+            detectorsPath = argv[++i];
+            if (!registry.load(detectorsPath)) return -1;
+        }
+        else if (isCameraId(a)) camIds.push_back(std::atoi(a.c_str()));
+        else {
+            std::cerr << "unknown or incomplete option: " << a << endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (camIds.empty()) camIds.push_back(0);
+
+    // --- 시선 스트림 (다른 로컬 프로그램용, 검출 루프는 큐에 넣기만 함) ---
+    GazePublisher publisher(streamPath);
+    if (streamOn && !publisher.start()) return -1;
+    FixationDetector fixation;
+
+    // --- 공유 메모리 링 (같은 머신 소비자가 락 없이 폴링) ---
+    GazeShmWriter shm(shmName);
+    if (shmOn && !shm.open()) return -1;
+
+    // 현재 검출기 이름 (F 키로 얼굴 검출기 순환, R 키로 설정 파일 다시 읽기)
+    std::string faceDetName = registry.faceName(), eyeDetName = registry.eyeName();
+
+    FrameSignal signal;
+    std::vector<std::unique_ptr<CameraPipeline>> cams;
+    for (int id : camIds) {
+        auto p = std::make_unique<CameraPipeline>(id,
+            registry.create(faceDetName, profile), registry.create(eyeDetName, profile), capture, quality);
+        p->setFramePoolCapacity(framePool);
+        if (!p->open()) return -1;
+        p->setPupilImpl(pupil);
+        p->setCoarsePupil(coarsePupil);
+        p->setPupilCache(pupilCache);
+        cams.push_back(std::move(p));
+    }
+    for (auto& p : cams) p->start(&signal);
+
+    // --- 화면: 커서/캘리브 좌표는 가상 데스크톱 px (모든 모니터) ---
+    for (const MonitorInfo& m : screens.monitors())
+        cout << "[Screen] " << m.name << " " << m.bounds << " x" << m.dpiScale << (m.primary ? " primary" : "") << "\n";
+    const MonitorInfo& primaryMon = screens.monitors()[screens.primary()];
+
+    // --- 시선 히트맵 (H 키 / 종료 시 PNG + 바이너리 + 모니터별 응시 시간) ---
+    heatOpt.area = screens.virtualBounds();
+    GazeHeatmap heatmap(heatOpt);
+    std::shared_ptr<GazeHeatmap::Writer> heatWriter = heatmap.writer();
+    if (heatmapOn) heatmap.start();
+    auto exportHeatmap = [&]() {
+        heatmap.flush();
+        std::shared_ptr<const HeatmapSnapshot> s = heatmap.snapshot();
+        s->savePng(heatmapPrefix + ".png");
+        s->saveBinary(heatmapPrefix + ".bin");
+        cout << "[Heatmap] " << heatmapPrefix << ".png/.bin total " << s->total() << " s, " << s->samples << " samples";
+        if (heatWriter->dropped()) cout << ", dropped " << heatWriter->dropped();
+        cout << "\n";
+        for (const MonitorInfo& m : screens.monitors())
+            cout << "  " << m.name << ": " << s->dwell(m.bounds) << " s\n";
+        };
+
+    // --- 커서 출력 스레드: 카메라 간격과 상관없이 주사율마다 캡처 시각 기준 예측 위치로 ---
+    CursorOutput cursorOut(screens, cursorOpt);
+    if (cursorOpt.enabled) {
+        cursorOut.start();
+        cout << "[Cursor] output " << cursorOut.rateHz() << " Hz\n";
+    }
 
-    // 시선 평균
-    float emaX = 0.f, emaY = 0.f;
-    const float EMA_A = 0.25f;
+    // 카메라별 캘리브레이션 (같은 타깃, 각자의 emaX/emaY로 학습)
+    std::vector<CameraCalib> calib(cams.size());
+    std::vector<CameraGaze> obs(cams.size());
+    const std::chrono::milliseconds ALIGN_WINDOW(50);   // 융합 허용 캡처 시각 차이
 
-    std::vector<Sample> samples;
-    Poly2 model;
     bool modelReady = false, controlOn = false, showDbg = true;
 
-    // 화면 좌표 EMA로 흔들림 억제
-    float emaSX = (float)SW * 0.5f, emaSY = (float)SH * 0.5f;
-    const float EMA_SPOS = 0.35f;
-
-    // ===== 눈 깜빡이 클릭 감지 =====
-    const int BLINK_MISS_FRAMES = 4;       // 연속 미검출 프레임 수
-    const int BLINK_COOLDOWN_MS = 600;     // 클릭 쿨다운
-    int missL = 0, missR = 0;
-    ULONGLONG lastClickTimeL = 0, lastClickTimeR = 0;
-    auto nowMs = []() { return GetTickCount64(); };
+    // 자동 캘리브레이션 (C 키): 전체 화면 타깃 + 타깃별 프레임 묶음 집계
+    AutoCalibrator autoCal(screens, autoOpt);
+    std::vector<std::vector<CameraGaze>> calibBatches(cams.size());   // 카메라별 프레임 결과 (수집 중에만)
+    const std::string calibWin = "Calibration";   // 모니터마다 창 하나 (calibWin + 번호)
+    Mat calibCanvas;
+
+    // 화면 좌표 EMA로 흔들림 억제 (시정수: 30fps에서 α=0.35와 동일)
+    float emaSX = primaryMon.toVirtual(0.5f, 0.5f).x, emaSY = primaryMon.toVirtual(0.5f, 0.5f).y;
+    const float EMA_SPOS_TAU_S = tauFromAlpha(0.35f, 30.f);
+    FrameTime emaST;
+    bool emaSInit = false;
+
+    // ===== 눈 깜빡이 클릭 감지 (모두 캡처 시각 기준) =====
+    const std::chrono::milliseconds BLINK_MISS_MS(133);     // 한쪽 눈 연속 미검출 시간 (30fps 4프레임)
+    const std::chrono::milliseconds BLINK_COOLDOWN_MS(600); // 클릭 쿨다운
+    bool missL = false, missR = false;  // 한쪽 눈만 안 보이는 중
+    FrameTime missSinceL, missSinceR;   // 미검출 시작 시각
+    FrameTime lastClickTimeL, lastClickTimeR;   // 기본값(epoch) = 클릭 이력 없음
+
+    const std::string winName = "Gaze -> Absolute Cursor + Blink Click (Windows)";
+    uint64_t seenSignal = 0;
+    // 카메라별 디버그 프레임 (풀 슬랩을 다음 반복까지 붙잡음, 벡터는 한 번만 할당)
+    std::vector<DebugFrame> dbg(cams.size());
+
+    // 대기 모드 전후 CPU 사용률 (모든 카메라가 대기일 때만 대기로 봄)
+    CpuMeter cpu;
+    bool allStandby = false;
 
     while (true) {
-        Mat frame; cap >> frame; if (frame.empty()) break;
-        flip(frame, frame, 1);
-        Mat gray; cvtColor(frame, gray, COLOR_BGR2GRAY);
-
-        // --- 얼굴 & 눈 ---
-        bool got = false; float nxMean = 0.f, nyMean = 0.f; int used = 0;
-        bool leftSeen = false, rightSeen = false;
-
-        std::vector<Rect> faces;
-        faceC.detectMultiScale(gray, faces, 1.1, 3, 0, Size(120, 120));
-        if (!faces.empty()) {
-            Rect f = *std::max_element(faces.begin(), faces.end(),
-                [](const Rect& a, const Rect& b) {return a.area() < b.area(); });
-            rectangle(frame, f, Scalar(0, 255, 0), 2);
-
-            Rect top(f.x, f.y, f.width, (int)(f.height * 0.6));
-            top &= Rect(0, 0, frame.cols, frame.rows);                       // ★ FIX: 경계 클리핑
-            Mat faceROI = gray(top);
-
-            std::vector<Rect> eyes;
-            eyeC.detectMultiScale(faceROI, eyes, 1.1, 2, 0, Size(28, 28), Size(220, 220));
-            std::sort(eyes.begin(), eyes.end(), [](const Rect& a, const Rect& b) {return a.x < b.x; });
-
-            float faceCenterX = f.x + f.width * 0.5f;
-
-            for (size_t i = 0; i < eyes.size() && i < 2; i++) {
-                Rect e = eyes[i];
-                int sx = (int)(e.width * 0.14);
-                int sy = (int)(e.height * 0.38);
-                Rect et(e.x + sx, e.y + sy, e.width - 2 * sx, e.height - 2 * sy);
-                et &= Rect(0, 0, faceROI.cols, faceROI.rows);                // ★ FIX: faceROI 경계 클리핑
-                if (et.width < 12 || et.height < 12) continue;
-
-                Rect er(et.x + top.x, et.y + top.y, et.width, et.height);
-                er &= Rect(0, 0, gray.cols, gray.rows);                      // ★ FIX: 프레임 경계 재클리핑
-                if (er.width < 8 || er.height < 8) continue;                 // ★ FIX: 최소 크기
-                rectangle(frame, er, Scalar(255, 200, 0), 1);
-
-                Mat eyeGray = gray(er);
-                if (eyeGray.empty() || eyeGray.total() == 0 || eyeGray.type() != CV_8UC1) continue; // ★ FIX
-
-                float nx = 0.f, ny = 0.f;
-                bool ok = false;
-                try {                                                        // ★ FIX: 예외 방지
-                    ok = darkCentroidNorm(eyeGray, nx, ny);
-                }
-                catch (const cv::Exception& ex) {
-                    std::cerr << "[darkCentroidNorm] " << ex.what() << std::endl;
-                    ok = false;
-                }
-
-                bool isLeftSide = (er.x + er.width * 0.5f) < faceCenterX;
+        // 어느 카메라든 새 결과가 나오면 바로 깨어남 (단일 카메라와 같은 지연)
+        bool fresh = signal.wait(seenSignal, std::chrono::milliseconds(100));
 
-                if (ok) {
-                    // 시각화
-                    int cx = er.x + er.width / 2 + (int)(nx * (er.width * 0.5f));
-                    int cy = er.y + er.height / 2 + (int)(ny * (er.height * 0.5f));
-                    line(frame, Point(cx, er.y), Point(cx, er.y + er.height), Scalar(0, 0, 255), 2);
-                    line(frame, Point(er.x, cy), Point(er.x + er.width, cy), Scalar(0, 255, 0), 2);
+        bool anyAlive = false;
+        for (size_t i = 0; i < cams.size(); ++i) {
+            obs[i] = cams[i]->latest();
+            anyAlive = anyAlive || cams[i]->alive();
+        }
+        if (!anyAlive) break;
+
+        bool standbyNow = true;
+        for (auto& p : cams) standbyNow = standbyNow && p->standby();
+        if (standbyNow != allStandby) {
+            float sec = 0.f;
+            const float pct = cpu.lap(&sec);
+            cout << "[Standby] " << (standbyNow ? "enter" : "wake") << ": CPU " << pct << "% over last " << sec
+                << " s " << (standbyNow ? "(active)" : "(standby)") << "\n";
+            allStandby = standbyNow;
+        }
 
-                    nxMean += nx; nyMean += ny; used++;
-                    if (isLeftSide) leftSeen = true; else rightSeen = true;
+        FusedGaze fg;
+        if (fresh) fg = fuseGaze(obs, calib, ALIGN_WINDOW);
+        bool got = fg.got;
 
-                    if (showDbg) {
-                        putText(frame, cv::format("nx=%.2f ny=%.2f", nx, ny),
-                            Point(er.x, er.y - 6), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(0, 255, 255), 1);
-                    }
-                }
-                else {
-                    putText(frame, "pupil?", Point(er.x, er.y - 6),
-                        FONT_HERSHEY_SIMPLEX, 0.45, Scalar(40, 40, 255), 1);
-                }
-            }
+        if (autoCal.collecting()) {
+            for (size_t i = 0; i < cams.size(); ++i) cams[i]->drainRecorded(calibBatches[i]);
+        }
+        if (autoCal.collecting() && autoCal.update(calibBatches, PipelineClock::now())) {
+            for (auto& p : cams) p->setRecording(false);
+            modelReady = autoCal.finish(calib);
+            emaSInit = false;
+        }
 
-            // --- 시선 평균 & 커서 이동 ---
-            if (used > 0) {
-                nxMean /= used; nyMean /= used;
-                emaX = ema1(emaX, nxMean, EMA_A);
-                emaY = ema1(emaY, nyMean, EMA_A);
-                got = true;
-
-                if (controlOn && modelReady) {
-                    float sx, sy;
-                    if (model.map(emaX, emaY, sx, sy)) {
-                        emaSX = ema1(emaSX, sx, EMA_SPOS);
-                        emaSY = ema1(emaSY, sy, EMA_SPOS);
-                        int ix = std::clamp((int)std::lround(emaSX), 0, SW - 1);
-                        int iy = std::clamp((int)std::lround(emaSY), 0, SH - 1);
-                        setCursorAbs(ix, iy);
-                    }
+        // --- 디버그 프레임 (카메라별 창, 첫 카메라 창에 HUD) ---
+        for (size_t i = 0; i < cams.size(); ++i) dbg[i] = cams[i]->takeDebugFrame();
+        DebugFrame* faceFrame = nullptr;   // 얼굴 박스를 고른 카메라의 프레임 (클릭 표시는 여기에)
+        for (size_t i = 0; i < cams.size(); ++i)
+            if (cams[i]->index() == fg.faceCam && !dbg[i].empty()) faceFrame = &dbg[i];
+
+        bool clickedL = false, clickedR = false;
+        if (fg.face) {
+            // --- 융합 시선 & 커서 이동 ---
+            if (got && modelReady && fg.mapped) {
+                float dt = emaSInit ? secondsBetween(emaST, fg.t) : 1.f / 30.f;
+                float a = emaAlpha(dt, EMA_SPOS_TAU_S);
+                emaSX = ema1(emaSX, fg.sx, a);
+                emaSY = ema1(emaSY, fg.sy, a);
+                emaST = fg.t; emaSInit = true;
+                if (heatmapOn) heatWriter->add(Point2f(emaSX, emaSY), fg.t);
+                if (cursorOpt.enabled) cursorOut.push(Point2f(emaSX, emaSY), fg.t);
+                else if (controlOn && !autoCal.collecting()) {
+                    // 모니터 사이 빈 곳(해상도가 다른 모니터 옆)은 가장 가까운 모니터 안으로
+                    Point p = screens.clamp(Point2f(emaSX, emaSY));
+                    setCursorAbs(p.x, p.y);
                 }
             }
 
             // --- 깜빡이 클릭 로직 ---
-            if (leftSeen && !rightSeen) {
-                missR++; missL = 0;
-            }
-            else if (!leftSeen && rightSeen) {
-                missL++; missR = 0;
-            }
-            else {
-                missL = 0; missR = 0; // 양쪽 모두(또는 둘 다 X) → 일반 깜빡임으로 간주
-            }
-
-            ULONGLONG now = nowMs();
-            if (missL >= BLINK_MISS_FRAMES) {
-                if (now - lastClickTimeL > (ULONGLONG)BLINK_COOLDOWN_MS) {
+            // 한쪽 눈만 안 보이는 상태가 BLINK_MISS_MS 이상 지속되면 클릭
+            bool onlyL = fg.leftSeen && !fg.rightSeen;   // 오른쪽 눈 사라짐
+            bool onlyR = !fg.leftSeen && fg.rightSeen;   // 왼쪽 눈 사라짐
+            if (onlyL && !missR) missSinceR = fg.t;
+            if (onlyR && !missL) missSinceL = fg.t;
+            missR = onlyL;
+            missL = onlyR; // 양쪽 모두(또는 둘 다 X) → 일반 깜빡임으로 간주
+
+            const Rect& f = fg.faceBox;
+            const FrameTime now = fg.t;
+            if (missL && now - missSinceL >= BLINK_MISS_MS) {
+                if (now - lastClickTimeL > BLINK_COOLDOWN_MS) {
                     clickLeft();
                     lastClickTimeL = now;
-                    putText(frame, "LEFT CLICK", Point(f.x, f.y - 10),
-                        FONT_HERSHEY_SIMPLEX, 0.8, Scalar(0, 255, 255), 2);
+                    clickedL = true;
+                    if (streamOn) {
+                        gaze_record r = makeGazeRecord(GAZE_REC_BLINK, now);
+                        r.code = GAZE_EYE_LEFT;
+                        publisher.publish(r);
+                    }
+                    if (faceFrame)
+                        putText(faceFrame->mat(), "LEFT CLICK", faceFrame->toFrame(Point(f.x, f.y - 10)),
+                            FONT_HERSHEY_SIMPLEX, 0.8, Scalar(0, 255, 255), 2);
                 }
-                missL = 0;
+                missL = false;
             }
-            if (missR >= BLINK_MISS_FRAMES) {
-                if (now - lastClickTimeR > (ULONGLONG)BLINK_COOLDOWN_MS) {
+            if (missR && now - missSinceR >= BLINK_MISS_MS) {
+                if (now - lastClickTimeR > BLINK_COOLDOWN_MS) {
                     clickRight();
                     lastClickTimeR = now;
-                    putText(frame, "RIGHT CLICK", Point(f.x + f.width / 2, f.y - 10),
-                        FONT_HERSHEY_SIMPLEX, 0.8, Scalar(0, 255, 255), 2);
+                    clickedR = true;
+                    if (streamOn) {
+                        gaze_record r = makeGazeRecord(GAZE_REC_BLINK, now);
+                        r.code = GAZE_EYE_RIGHT;
+                        publisher.publish(r);
+                    }
+                    if (faceFrame)
+                        putText(faceFrame->mat(), "RIGHT CLICK", faceFrame->toFrame(Point(f.x + f.width / 2, f.y - 10)),
+                            FONT_HERSHEY_SIMPLEX, 0.8, Scalar(0, 255, 255), 2);
+                }
+                missR = false;
+            }
+        }
+
+        // 추적이 끊긴 동안은 히트맵에 시간을 넣지 않고 커서도 외삽하지 않음
+        if (!(fg.face && got && modelReady && fg.mapped)) { heatWriter->gap(); cursorOut.gap(); }
+        cursorOut.setActive(controlOn && !autoCal.collecting());
+
+        // --- 공유 메모리: setCursorAbs 직전 값 그대로 프레임별 기록 ---
+        if (shmOn && fresh) {
+            gaze_shm_sample ss = {};
+            ss.t_capture_ns = GazePublisher::toNs(fg.t);
+            ss.left_nx = fg.left.nx;  ss.left_ny = fg.left.ny;
+            ss.right_nx = fg.right.nx; ss.right_ny = fg.right.ny;
+            ss.ema_x = fg.nx; ss.ema_y = fg.ny;
+            ss.screen_x = emaSX; ss.screen_y = emaSY;
+            ss.flags = (fg.leftSeen ? GAZE_FLAG_LEFT_SEEN : 0) | (fg.rightSeen ? GAZE_FLAG_RIGHT_SEEN : 0)
+                | (got ? GAZE_FLAG_VALID : 0) | (got && modelReady && fg.mapped ? GAZE_FLAG_MAPPED : 0);
+            ss.blink = (missL ? GAZE_BLINK_LEFT_CLOSED : 0) | (missR ? GAZE_BLINK_RIGHT_CLOSED : 0)
+                | (clickedL ? GAZE_BLINK_LEFT_CLICK : 0) | (clickedR ? GAZE_BLINK_RIGHT_CLICK : 0);
+            shm.write(ss);
+        }
+
+        // --- 스트림 발행: 프레임별 샘플 + 응시 시작/끝 ---
+        if (streamOn && fresh) {
+            gaze_record r = makeGazeRecord(GAZE_REC_SAMPLE, fg.t);
+            r.flags = (fg.leftSeen ? GAZE_FLAG_LEFT_SEEN : 0) | (fg.rightSeen ? GAZE_FLAG_RIGHT_SEEN : 0)
+                | (got ? GAZE_FLAG_VALID : 0) | (got && modelReady && fg.mapped ? GAZE_FLAG_MAPPED : 0);
+            r.x = fg.nx; r.y = fg.ny;
+            r.sx = emaSX; r.sy = emaSY;
+            publisher.publish(r);
+
+            if (got) {
+                FixationDetector::Event ev = fixation.update(fg.nx, fg.ny, fg.t);
+                if (ev == FixationDetector::Event::Start) {
+                    gaze_record e = makeGazeRecord(GAZE_REC_FIXATION_START, fg.t);
+                    e.x = fixation.centerX(); e.y = fixation.centerY();
+                    publisher.publish(e);
+                }
+                else if (ev == FixationDetector::Event::End) {
+                    gaze_record e = makeGazeRecord(GAZE_REC_FIXATION_END, fg.t);
+                    e.code = (int32_t)fixation.lastDuration().count();
+                    publisher.publish(e);
                 }
-                missR = 0;
             }
         }
 
         // --- HUD ---
-        putText(frame, controlOn ? "Gaze->Cursor: ON" : "Gaze->Cursor: OFF",
-            Point(20, 40), FONT_HERSHEY_SIMPLEX, 0.8, controlOn ? Scalar(0, 255, 0) : Scalar(200, 200, 200), 2);
-        putText(frame, modelReady ? "Model: READY (ENTER to refit)"
-            : "Model: NOT FITTED (1..9 then ENTER)",
-            Point(20, 70), FONT_HERSHEY_SIMPLEX, 0.7, modelReady ? Scalar(0, 255, 255) : Scalar(50, 200, 255), 2);
-        putText(frame, "1..9: add sample  ENTER: fit  G: toggle control  0: clear  Q: quit",
-            Point(20, frame.rows - 20), FONT_HERSHEY_SIMPLEX, 0.6, Scalar(230, 230, 230), 2);
-
-        imshow("Gaze -> Absolute Cursor + Blink Click (Windows)", frame);
+        for (size_t i = 0; i < cams.size(); ++i) {
+            Mat& frame = dbg[i].mat();
+            if (frame.empty()) continue;
+            if (i == 0) {
+                putText(frame, controlOn ? "Gaze->Cursor: ON" : "Gaze->Cursor: OFF",
+                    Point(20, 40), FONT_HERSHEY_SIMPLEX, 0.8, controlOn ? Scalar(0, 255, 0) : Scalar(200, 200, 200), 2);
+                putText(frame, modelReady ? "Model: READY (ENTER to refit)"
+                    : "Model: NOT FITTED (1..9 then ENTER)",
+                    Point(20, 70), FONT_HERSHEY_SIMPLEX, 0.7, modelReady ? Scalar(0, 255, 255) : Scalar(50, 200, 255), 2);
+                putText(frame, "1..9: add sample  ENTER: fit  C: auto calib  G: toggle control  0: clear  F: face model  Q: quit",
+                    Point(20, frame.rows - 20), FONT_HERSHEY_SIMPLEX, 0.6, Scalar(230, 230, 230), 2);
+                imshow(winName, frame);
+            }
+            else {
+                putText(frame, calib[i].ready ? "Model: READY" : "Model: NOT FITTED",
+                    Point(20, 40), FONT_HERSHEY_SIMPLEX, 0.7, calib[i].ready ? Scalar(0, 255, 255) : Scalar(50, 200, 255), 2);
+                imshow(winName + " [cam " + std::to_string(cams[i]->index()) + "]", frame);
+            }
+        }
+
+        if (autoCal.showing()) {
+            for (int m = 0; m < (int)screens.monitors().size(); ++m) {
+                autoCal.draw(calibCanvas, m);
+                imshow(calibWin + std::to_string(m), calibCanvas);
+            }
+        }
+
         int k = waitKey(1);
+        // 캘리브레이션 화면: ESC = 취소, 결과 화면은 아무 키로 닫음
+        if (autoCal.showing() && k >= 0 && (k == 27 || !autoCal.collecting())) {
+            if (autoCal.collecting()) {
+                autoCal.cancel();
+                for (auto& p : cams) p->setRecording(false);
+            }
+            else autoCal.close();
+            for (size_t m = 0; m < screens.monitors().size(); ++m) destroyWindow(calibWin + std::to_string(m));
+            continue;
+        }
         if (k == 'q' || k == 27) break;
+        if ((k == 'c' || k == 'C') && !autoCal.showing()) {
+            // 창을 해당 모니터로 옮긴 뒤 전체 화면 (전체 화면은 창이 있는 모니터 기준)
+            for (size_t m = 0; m < screens.monitors().size(); ++m) {
+                const std::string w = calibWin + std::to_string(m);
+                namedWindow(w, WINDOW_NORMAL);
+                moveWindow(w, screens.monitors()[m].bounds.x, screens.monitors()[m].bounds.y);
+                setWindowProperty(w, WND_PROP_FULLSCREEN, WINDOW_FULLSCREEN);
+            }
+            for (auto& p : cams) p->setRecording(true);
+            autoCal.start(cams.size(), PipelineClock::now());
+        }
         if (k == 'g' || k == 'G') controlOn = !controlOn;
-        if (k == 'v' || k == 'V') showDbg = !showDbg;
-        if (k == '0') { samples.clear(); modelReady = false; }
+        if ((k == 'h' || k == 'H') && heatmapOn) exportHeatmap();
+
+        // 검출기 교체: 카메라 스레드는 멈추지 않고 다음 프레임부터 새 인스턴스 사용
+        // (모델 로드는 여기서 끝내고 넘기므로 검출 루프에는 로드 시간이 안 들어감)
+        // force: 이름이 같아도 다시 생성 (설정 파일에서 모델 경로가 바뀐 경우)
+        auto swapDetectors = [&](const std::string& faceName, const std::string& eyeName, bool force) {
+            const bool newFace = force || faceName != faceDetName, newEye = force || eyeName != eyeDetName;
+            std::vector<std::shared_ptr<ObjectDetector>> faces, eyes;
+            for (size_t i = 0; i < cams.size(); ++i) {
+                faces.push_back(newFace ? registry.create(faceName, profile) : nullptr);
+                eyes.push_back(newEye ? registry.create(eyeName, profile) : nullptr);
+                if ((newFace && !faces.back()) || (newEye && !eyes.back())) {
+                    cout << "[Detector] swap failed, keeping " << faceDetName << " / " << eyeDetName << "\n";
+                    return;
+                }
+            }
+            for (size_t i = 0; i < cams.size(); ++i) cams[i]->setDetectors(faces[i], eyes[i]);
+            faceDetName = faceName; eyeDetName = eyeName;
+            cout << "[Detector] face=" << faceDetName << " eye=" << eyeDetName << "\n";
+            };
+        if (k == 'f' || k == 'F') swapDetectors(registry.next(faceDetName), eyeDetName, false);
+        if ((k == 'r' || k == 'R') && !detectorsPath.empty() && registry.load(detectorsPath))
+            swapDetectors(registry.faceName(), registry.eyeName(), true);
+        if (k == 'v' || k == 'V') {
+            showDbg = !showDbg;
+            for (auto& p : cams) p->setShowDebug(showDbg);
+        }
+        if (k == '0') {
+            for (CameraCalib& c : calib) { c.samples.clear(); c.ready = false; }
+            modelReady = false;
+        }
 
+        // 샘플은 카메라마다 자기 시선으로 등록 (이번에 시선이 유효한 카메라만)
+        // 타깃 = 지금 마우스 커서가 있는 모니터의 9점 격자
         auto addSample = [&](int idx, const char* name) {
             if (!got) return; // ★ FIX: 현재 시선이 유효할 때만 등록
-            Sample s; s.nx = emaX; s.ny = emaY;
-            s.sx = (float)targets[idx].x; s.sy = (float)targets[idx].y;
-            samples.push_back(s);
-            cout << "Add sample " << name << " nx=" << s.nx << " ny=" << s.ny
-                << " -> (" << s.sx << "," << s.sy << ")\n";
+            POINT cur = {};
+            GetCursorPos(&cur);
+            const Point2f target = screens.gridTargets(screens.monitorAt(Point2f((float)cur.x, (float)cur.y)), 3, 0.1f)[idx];
+            for (size_t i = 0; i < cams.size(); ++i) {
+                const CameraGaze& g = obs[i];
+                if (!g.got || fg.t - g.t > ALIGN_WINDOW) continue;
+                Sample s; s.nx = g.emaX; s.ny = g.emaY;
+                s.sx = target.x; s.sy = target.y;
+                s.leftOk = g.left.ok; s.lx = g.left.emaX; s.ly = g.left.emaY;
+                s.rightOk = g.right.ok; s.rx = g.right.emaX; s.ry = g.right.emaY;
+                calib[i].samples.push_back(s);
+                cout << "Add sample " << name << " cam" << cams[i]->index() << " nx=" << s.nx << " ny=" << s.ny
+                    << " -> (" << s.sx << "," << s.sy << ")\n";
+            }
             };
         if (k == '1') addSample(0, "TL");
         if (k == '2') addSample(1, "T");
@@ -294,14 +496,41 @@ int main() {
         if (k == '9') addSample(8, "BR");
 
         if (k == 13) { // ENTER
-            if (samples.size() >= 6) {
-                modelReady = model.fit(samples);
-                cout << (modelReady ? "[Fit] OK (" : "[Fit] FAIL (") << samples.size() << " samples)\n";
-            }
-            else {
-                cout << "[Fit] Need >= 6 samples. Current: " << samples.size() << "\n";
+            modelReady = false;
+            for (size_t i = 0; i < cams.size(); ++i) {
+                CameraCalib& c = calib[i];
+                if (c.samples.size() >= 6) {
+                    c.fit();
+                    cout << "[Fit] cam" << cams[i]->index() << (c.ready ? " OK (" : " FAIL (") << c.samples.size() << " samples"
+                        << ", eye models L" << (c.leftReady ? "+" : "-") << " R" << (c.rightReady ? "+" : "-") << ")\n";
+                }
+                else {
+                    cout << "[Fit] cam" << cams[i]->index() << " Need >= 6 samples. Current: " << c.samples.size() << "\n";
+                }
+                modelReady = modelReady || c.ready;
             }
         }
     }
+
+    {
+        float sec = 0.f;
+        const float pct = cpu.lap(&sec);
+        cout << "[Standby] exit: CPU " << pct << "% over last " << sec << " s " << (allStandby ? "(standby)" : "(active)") << "\n";
+    }
+    for (auto& p : cams) p->stop();
+    for (auto& p : cams) {
+        const PupilCacheStats cs = p->cacheStats();
+        const FramePoolStats fp = p->framePoolStats();
+        if (fp.capacity > 0)
+            cout << "[FramePool] cam" << p->index() << " " << fp.capacity << " slabs, min free " << fp.minFree
+                << ", waits " << fp.waits << " (" << fp.waitMs << " ms), heap fallbacks " << fp.fallbacks
+                << ", oversize " << fp.oversize << ", debug skipped " << fp.dry << " / " << fp.acquires << " acquires\n";
+        cout << "[PupilCache] cam" << p->index() << " hit " << cs.hitRate() * 100.f << "% (" << cs.hits << "/" << cs.lookups
+            << "), audit " << cs.audits << ": mean err " << cs.meanErr() << " max " << cs.maxErr << ", ok flips " << cs.auditFlips << "\n";
+    }
+    cursorOut.stop();
+    if (heatmapOn) { heatmap.stop(); exportHeatmap(); }
+    publisher.stop();
+    shm.close();
     return 0;
 }
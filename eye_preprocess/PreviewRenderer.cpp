@@ -0,0 +1,119 @@
+// PreviewRenderer.cpp
+#include "PreviewRenderer.h"
+
+using namespace cv;
+
+PreviewRenderer::PreviewRenderer(double maxHz)
+{
+    double hz = std::max(1.0, maxHz);
+    period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+    nextDue_.store(0);
+}
+
+PreviewRenderer::~PreviewRenderer()
+{
+    stop();
+}
+
+void PreviewRenderer::start()
+{
+    if (running_.exchange(true)) return;
+    worker_ = std::thread(&PreviewRenderer::run, this);
+}
+
+void PreviewRenderer::stop()
+{
+    if (!running_.exchange(false)) return;
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+bool PreviewRenderer::wantsFrame() const
+{
+    return Clock::now().time_since_epoch().count() >= nextDue_.load(std::memory_order_relaxed);
+}
+
+void PreviewRenderer::submit(PreviewSnapshot&& snap)
+{
+    nextDue_.store((Clock::now() + period_).time_since_epoch().count(), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        pending_ = std::move(snap);
+        hasPending_ = true;
+    }
+    cv_.notify_one();
+}
+
+// 스냅샷 위에 검출 결과를 그리고 눈 패널을 합성
+void PreviewRenderer::draw(PreviewSnapshot& s)
+{
+    for (const Rect& f : s.faces)
+        rectangle(s.frame, f, Scalar(0, 255, 0), 2);
+    for (const PreviewSnapshot::Pupil& p : s.pupils)
+        circle(s.frame, p.center, (int)std::max(2.f, p.radius), Scalar(0, 0, 255), 2);
+    for (const Rect& e : s.missedEyes)
+        putText(s.frame, "pupil?", Point(e.x, e.y - 8),
+            FONT_HERSHEY_SIMPLEX, 0.5, Scalar(50, 50, 255), 1);
+
+    putText(s.frame, "Press 'q' to quit", Point(20, 30),
+        FONT_HERSHEY_SIMPLEX, 0.8, Scalar(255, 255, 255), 2);
+    imshow("Eye Tracker (OpenCV)", s.frame);
+
+    // 🔹 왼/오른쪽 눈 합쳐서 한 화면에 표시
+    if (!s.leftEye.empty() && !s.rightEye.empty()) {
+        Mat origEyes, procEyes;
+        resize(s.leftEye, s.leftEye, Size(200, 100));
+        resize(s.rightEye, s.rightEye, Size(200, 100));
+        resize(s.leftProc, s.leftProc, Size(200, 100));
+        resize(s.rightProc, s.rightProc, Size(200, 100));
+
+        hconcat(s.leftEye, s.rightEye, origEyes);
+        hconcat(s.leftProc, s.rightProc, procEyes);
+
+        putText(origEyes, "Left", Point(10, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
+        putText(origEyes, "Right", Point(210, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
+
+        putText(procEyes, "Left Preproc", Point(10, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
+        putText(procEyes, "Right Preproc", Point(210, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
+
+        imshow("Eyes (Original)", origEyes);
+        imshow("Eyes (Preprocessed)", procEyes);
+    }
+}
+
+void PreviewRenderer::run()
+{
+    // 🔹 창 세팅 (HighGUI는 이 스레드에서만 사용)
+    namedWindow("Eye Tracker (OpenCV)", WINDOW_NORMAL);
+    resizeWindow("Eye Tracker (OpenCV)", 640, 480);
+    moveWindow("Eye Tracker (OpenCV)", 50, 50);
+
+    namedWindow("Eyes (Original)", WINDOW_NORMAL);
+    resizeWindow("Eyes (Original)", 400, 200);
+    moveWindow("Eyes (Original)", 700, 50);
+
+    namedWindow("Eyes (Preprocessed)", WINDOW_NORMAL);
+    resizeWindow("Eyes (Preprocessed)", 400, 200);
+    moveWindow("Eyes (Preprocessed)", 700, 300);
+
+    while (running_.load()) {
+        PreviewSnapshot snap;
+        bool have = false;
+        {
+            // 새 스냅샷이 없어도 주기마다 깨어나 waitKey로 창 이벤트를 처리
+            std::unique_lock<std::mutex> lk(mtx_);
+            cv_.wait_for(lk, period_, [this] { return hasPending_ || !running_.load(); });
+            if (hasPending_) {
+                snap = std::move(pending_);
+                hasPending_ = false;
+                have = true;
+            }
+        }
+
+        if (have && !snap.frame.empty()) draw(snap);
+
+        char key = (char)waitKey(1);
+        if (key == 'q' || key == 27) quit_.store(true);
+    }
+    destroyAllWindows();
+}
@@ -0,0 +1,64 @@
+// PreviewRenderer.h
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 한 프레임의 단계별 결과 스냅샷 (그리기 전 원본 + 검출 결과만 담음)
+struct PreviewSnapshot {
+    struct Pupil { cv::Point center; float radius; };
+
+    cv::Mat frame;                      // 원본 프레임 (BGR, 그리기 전)
+    std::vector<cv::Rect> faces;        // 얼굴 박스
+    std::vector<Pupil> pupils;          // 프레임 좌표계 동공
+    std::vector<cv::Rect> missedEyes;   // 동공 검출 실패한 눈 박스 ("pupil?")
+    cv::Mat leftEye, rightEye;          // 눈 원본 (gray)
+    cv::Mat leftProc, rightProc;        // 눈 전처리 결과
+};
+
+/**
+ * @class PreviewRenderer
+ * @brief 디버그 화면을 별도 스레드에서 제한된 주기(기본 15 Hz)로 그립니다.
+ * 검출 루프는 wantsFrame()이 true일 때만 스냅샷을 만들어 submit()하고,
+ * resize/hconcat/putText/imshow는 모두 렌더 스레드에서 처리합니다.
+ * HighGUI 창 생성과 waitKey도 렌더 스레드에서만 호출합니다.
+ */
+class PreviewRenderer {
+public:
+    explicit PreviewRenderer(double maxHz = 15.0);
+    ~PreviewRenderer();
+
+    void start();
+    void stop();
+
+    // 다음 스냅샷을 받을 시점인지 (아니면 루프는 복사/그리기를 전부 생략)
+    bool wantsFrame() const;
+
+    // 최신 스냅샷 1장만 유지 (렌더가 밀리면 이전 것은 버림)
+    void submit(PreviewSnapshot&& snap);
+
+    // 렌더 창에서 q/ESC가 눌렸는지
+    bool quitRequested() const { return quit_.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    static void draw(PreviewSnapshot& s);
+
+    Clock::duration period_;
+    std::atomic<Clock::rep> nextDue_;   // 다음 스냅샷 허용 시각 (Clock 틱)
+    std::atomic<bool> running_{ false };
+    std::atomic<bool> quit_{ false };
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    PreviewSnapshot pending_;
+    bool hasPending_ = false;
+
+    std::thread worker_;
+};
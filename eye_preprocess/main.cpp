@@ -1,67 +1,39 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <memory>
 #include "BlinkDetector.h"
+#include "DetectorProfile.h"
+#include "FacePreprocessor.h"
+#include "PipelineClock.h"
+#include "PreviewRenderer.h"
+#include "preprocess.h"
 using namespace cv;
 using std::cout; using std::endl;
 
+// SIGINT/SIGTERM -> 루프 종료 (헤드리스에는 창/키 입력이 없어서 이게 유일한 정상 종료 경로)
+static std::atomic<bool> g_stop{ false };
+static void onStopSignal(int) { g_stop = true; }
+
 static Point2f emaPoint(const Point2f& prev, const Point2f& cur, float alpha = 0.25f) {
     return prev * (1.0f - alpha) + cur * alpha;
 }
 
-// pupil 찾기 함수 (전처리 + 컨투어 + 허프)
-// 👉 전처리 결과를 outProc에 반환
-static bool findPupil(const Mat& eyeGray, Point& pupil, float& radius, Mat& outProc)
+int main(int argc, char** argv)
 {
-    Mat proc;
-
-    if (eyeGray.channels() == 3)
-        cvtColor(eyeGray, proc, COLOR_BGR2GRAY);
-    else
-        proc = eyeGray.clone();
-
-    Ptr<CLAHE> clahe = createCLAHE(2.0, Size(8, 8));
-    clahe->apply(proc, proc);
-
-    medianBlur(proc, proc, 5);
-
-    adaptiveThreshold(proc, proc, 255,
-        ADAPTIVE_THRESH_MEAN_C,
-        THRESH_BINARY_INV,
-        19, 5);
-
-    Mat kernel = getStructuringElement(MORPH_ELLIPSE, Size(3, 3));
-    morphologyEx(proc, proc, MORPH_CLOSE, kernel);
-
-    outProc = proc.clone();
-
-    std::vector<std::vector<Point>> contours;
-    findContours(proc, contours, RETR_EXTERNAL, CHAIN_APPROX_SIMPLE);
-
-    if (contours.empty()) {
-        std::vector<Vec3f> circles;
-        HoughCircles(proc, circles, HOUGH_GRADIENT, 1, eyeGray.rows / 8, 200, 15,
-            eyeGray.rows / 16, eyeGray.rows / 3);
-        if (circles.empty()) return false;
-        Vec3f c = circles[0];
-        pupil = Point(cvRound(c[0]), cvRound(c[1]));
-        radius = c[2];
-        return true;
+    // --headless: 키오스크용, HighGUI/그리기 작업을 전부 생략 (종료는 Ctrl+C 또는 SIGTERM)
+    // --profile 파일: 검출 파라미터 프로파일 (없으면 기본값)
+    bool headless = false;
+    DetectorProfile profile;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) headless = true;
+        else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc && !profile.load(argv[++i])) return -1;
     }
 
-    size_t idxMax = 0; double maxA = 0;
-    for (size_t i = 0; i < contours.size(); ++i) {
-        double a = contourArea(contours[i]);
-        if (a > maxA) { maxA = a; idxMax = i; }
-    }
-    Point2f c; float r;
-    minEnclosingCircle(contours[idxMax], c, r);
-    pupil = Point(cvRound(c.x), cvRound(c.y));
-    radius = r;
-    return true;
-}
-
-int main()
-{
     std::string face_cascade_path = "haarcascade_frontalface_default.xml";
     std::string eye_cascade_path = "haarcascade_eye_tree_eyeglasses.xml";
 
@@ -79,42 +51,53 @@ int main()
     cap.set(CAP_PROP_FRAME_WIDTH, 1280);
     cap.set(CAP_PROP_FRAME_HEIGHT, 720);
 
-    BlinkDetector left_eye_detector(5);
-    BlinkDetector right_eye_detector(5);
+    // 5프레임@30fps 와 같은 시간 (프레임 수가 아니라 캡처 시각 기준)
+    BlinkDetector left_eye_detector(std::chrono::milliseconds(167));
+    BlinkDetector right_eye_detector(std::chrono::milliseconds(167));
 
     Point2f emaLeft(-1, -1), emaRight(-1, -1);
+    const float EMA_TAU_S = tauFromAlpha(0.2f, 30.f);   // 30fps에서 α=0.2와 같은 시정수
+    BlinkDetector::Clock::time_point tLeft, tRight; // 눈별 마지막 EMA 갱신 캡처 시각
+
+    // 🔹 미리보기는 별도 스레드에서 15 Hz로 (헤드리스면 생성 안 함)
+    std::unique_ptr<PreviewRenderer> renderer;
+    if (!headless) {
+        renderer = std::make_unique<PreviewRenderer>(15.0);
+        renderer->start();
+    }
 
-    // 🔹 창 세팅
-    namedWindow("Eye Tracker (OpenCV)", WINDOW_NORMAL);
-    resizeWindow("Eye Tracker (OpenCV)", 640, 480);
-    moveWindow("Eye Tracker (OpenCV)", 50, 50);
-
-    namedWindow("Eyes (Original)", WINDOW_NORMAL);
-    resizeWindow("Eyes (Original)", 400, 200);
-    moveWindow("Eyes (Original)", 700, 50);
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
 
-    namedWindow("Eyes (Preprocessed)", WINDOW_NORMAL);
-    resizeWindow("Eyes (Preprocessed)", 400, 200);
-    moveWindow("Eyes (Preprocessed)", 700, 300);
+    // 위쪽 얼굴 CLAHE는 프레임당 한 번 (CLAHE 객체도 재사용), 두 눈은 그 뷰에서 나머지 전처리만
+    FacePreprocessor facePre(FaceNormMode::Clahe);
 
-    while (true) {
-        Mat frame; cap >> frame;
+    while (!g_stop) {
+        // grab 직후 시각을 이 프레임의 캡처 시각으로 사용
+        if (!cap.grab()) break;
+        const auto t = BlinkDetector::Clock::now();
+        Mat frame; cap.retrieve(frame);
         if (frame.empty()) break;
 
         flip(frame, frame, 1);
         Mat gray; cvtColor(frame, gray, COLOR_BGR2GRAY);
 
+        // 이번 프레임을 미리보기로 보낼지 (아니면 복사/그리기 전부 생략)
+        const bool snapOn = renderer && renderer->wantsFrame();
+        PreviewSnapshot snap;
+
         std::vector<Rect> faces;
-        faceCasc.detectMultiScale(gray, faces, 1.1, 3, 0, Size(120, 120));
+        profile.face.detect(faceCasc, gray, faces);
         for (const Rect& f : faces) {
-            rectangle(frame, f, Scalar(0, 255, 0), 2);
+            if (snapOn) snap.faces.push_back(f);
 
-            Rect upperFace = Rect(f.x, f.y, f.width, (int)std::round(f.height * 0.6));
+            Rect upperFace = Rect(f.x, f.y, f.width, (int)std::round(f.height * kUpperFaceRatio));
             upperFace &= Rect(0, 0, frame.cols, frame.rows);
-            Mat faceROI = gray(upperFace);
+            facePre.compute(gray, upperFace);
+            Mat faceROI = facePre.norm();
 
             std::vector<Rect> eyes;
-            eyeCasc.detectMultiScale(faceROI, eyes, 1.1, 2, 0, Size(30, 30));
+            profile.eye.detect(eyeCasc, faceROI, eyes);
 
             const float faceCenterX = f.x + f.width * 0.5f;
             bool foundL = false, foundR = false;
@@ -123,25 +106,24 @@ int main()
             float radL = 0.f, radR = 0.f;
             Rect eyeRectL, eyeRectR;
 
-            Mat leftEye, rightEye, leftProc, rightProc;
-
             for (const Rect& eInFace : eyes) {
                 Rect eyeRect(eInFace.x + upperFace.x, eInFace.y + upperFace.y,
                     eInFace.width, eInFace.height);
-                //rectangle(frame, eyeRect, Scalar(255, 200, 0), 2);
 
-                Mat eyeGray = gray(eyeRect).clone();
+                eyeRect = facePre.clip(eyeRect);
+                if (eyeRect.empty()) continue;
+                Mat eyeGray = gray(eyeRect);   // 미리보기용 원본 뷰
                 Mat eyeProc;
 
                 Point pupil; float r = 0;
-                bool ok = findPupil(eyeGray, pupil, r, eyeProc);
+                bool ok = findPupilPreprocessedPrepared(facePre.norm(eyeRect), pupil, r, snapOn ? &eyeProc : nullptr);
 
                 float eyeCenterX = eyeRect.x + eyeRect.width * 0.5f;
                 isLeftSide = (eyeCenterX < faceCenterX);
 
                 if (ok) {
                     Point pupilInFrame = Point(eyeRect.x + pupil.x, eyeRect.y + pupil.y);
-                    circle(frame, pupilInFrame, (int)std::max(2.f, r), Scalar(0, 0, 255), 2);
+                    if (snapOn) snap.pupils.push_back({ pupilInFrame, r });
 
                     Point2f centerEye(eyeRect.x + eyeRect.width * 0.5f,
                         eyeRect.y + eyeRect.height * 0.5f);
@@ -151,64 +133,38 @@ int main()
 
                     if (isLeftSide) {
                         foundL = true; normL = norm; radL = r; eyeRectL = eyeRect;
-                        leftEye = eyeGray.clone();
-                        leftProc = eyeProc.clone();
+                        if (snapOn) { snap.leftEye = eyeGray.clone(); snap.leftProc = eyeProc; }
                     }
                     else {
                         foundR = true; normR = norm; radR = r; eyeRectR = eyeRect;
-                        rightEye = eyeGray.clone();
-                        rightProc = eyeProc.clone();
+                        if (snapOn) { snap.rightEye = eyeGray.clone(); snap.rightProc = eyeProc; }
                     }
                 }
-                else {
-                    putText(frame, "pupil?", Point(eyeRect.x, eyeRect.y - 8),
-                        FONT_HERSHEY_SIMPLEX, 0.5, Scalar(50, 50, 255), 1);
+                else if (snapOn) {
+                    snap.missedEyes.push_back(eyeRect);
                 }
             }
 
-            // 🔹 왼/오른쪽 눈 합쳐서 한 화면에 표시
-            if (!leftEye.empty() && !rightEye.empty()) {
-                Mat origEyes, procEyes;
-                resize(leftEye, leftEye, Size(200, 100));
-                resize(rightEye, rightEye, Size(200, 100));
-                resize(leftProc, leftProc, Size(200, 100));
-                resize(rightProc, rightProc, Size(200, 100));
-
-                hconcat(leftEye, rightEye, origEyes);
-                hconcat(leftProc, rightProc, procEyes);
-
-                putText(origEyes, "Left", Point(10, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
-                putText(origEyes, "Right", Point(210, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
-
-                putText(procEyes, "Left Preproc", Point(10, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
-                putText(procEyes, "Right Preproc", Point(210, 20), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), 1);
-
-                imshow("Eyes (Original)", origEyes);
-                imshow("Eyes (Preprocessed)", procEyes);
-            }
-
             if (foundL) {
-                emaLeft = (emaLeft.x < -0.5f) ? normL : emaPoint(emaLeft, normL, 0.2f);
-                //putText(frame, format("L(%.2f, %.2f)", emaLeft.x, emaLeft.y),
-                    //Point(eyeRectL.x, eyeRectL.y - 8), FONT_HERSHEY_SIMPLEX, 0.5,
-                    //Scalar(0, 255, 255), 1);
+                emaLeft = (emaLeft.x < -0.5f) ? normL : emaPoint(emaLeft, normL,
+                    emaAlpha(std::chrono::duration<float>(t - tLeft).count(), EMA_TAU_S));
+                tLeft = t;
             }
             if (foundR) {
-                emaRight = (emaRight.x < -0.5f) ? normR : emaPoint(emaRight, normR, 0.2f);
-                //putText(frame, format("R(%.2f, %.2f)", emaRight.x, emaRight.y),
-                    //Point(eyeRectR.x, eyeRectR.y - 8), FONT_HERSHEY_SIMPLEX, 0.5,
-                   // Scalar(0, 255, 255), 1);
+                emaRight = (emaRight.x < -0.5f) ? normR : emaPoint(emaRight, normR,
+                    emaAlpha(std::chrono::duration<float>(t - tRight).count(), EMA_TAU_S));
+                tRight = t;
             }
 
-            left_eye_detector.checkBlink(true);
-            right_eye_detector.checkBlink(true);
+            left_eye_detector.checkBlink(true, t);
+            right_eye_detector.checkBlink(true, t);
         }
 
-        putText(frame, "Press 'q' to quit", Point(20, 30),
-            FONT_HERSHEY_SIMPLEX, 0.8, Scalar(255, 255, 255), 2);
-        imshow("Eye Tracker (OpenCV)", frame);
-        char key = (char)waitKey(1);
-        if (key == 'q' || key == 27) break;
+        if (snapOn) {
+            snap.frame = frame;   // 이번 루프에서 더 이상 쓰지 않으므로 복사 없이 넘김
+            renderer->submit(std::move(snap));
+        }
+        if (renderer && renderer->quitRequested()) break;
     }
     return 0;
 }
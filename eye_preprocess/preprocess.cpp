@@ -1,7 +1,8 @@
 #include "preprocess.h"
 #include <opencv2/opencv.hpp>
 
-cv::Mat preprocessEye(const cv::Mat& eyeGray)
+// 1~2단계: 그레이 + CLAHE (preprocessEye / findPupilPreprocessed 공통)
+static cv::Mat claheEye(const cv::Mat& eyeGray)
 {
     cv::Mat proc;
 
@@ -14,9 +15,20 @@ cv::Mat preprocessEye(const cv::Mat& eyeGray)
     // 2. CLAHE (국소 대비 향상) → 어두운 환경에서도 pupil 강조
     cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE(2.0, cv::Size(8, 8));
     clahe->apply(proc, proc);
+    return proc;
+}
+
+cv::Mat preprocessEye(const cv::Mat& eyeGray)
+{
+    return preprocessEyePrepared(claheEye(eyeGray));
+}
+
+cv::Mat preprocessEyePrepared(const cv::Mat& eyeClahe)
+{
+    cv::Mat proc;
 
     // 3. Median Blur → 동공 경계는 살리고 노이즈만 제거
-    cv::medianBlur(proc, proc, 5);
+    cv::medianBlur(eyeClahe, proc, 5);
 
     // 4. Adaptive Threshold (조명 변화에 강함)
     cv::adaptiveThreshold(proc, proc, 255,
@@ -31,3 +43,39 @@ cv::Mat preprocessEye(const cv::Mat& eyeGray)
 
     return proc; // resize는 빼고 원본 크기 유지
 }
+
+bool findPupilPreprocessed(const cv::Mat& eyeGray, cv::Point& pupil, float& radius, cv::Mat* outProc)
+{
+    return findPupilPreprocessedPrepared(claheEye(eyeGray), pupil, radius, outProc);
+}
+
+bool findPupilPreprocessedPrepared(const cv::Mat& eyeClahe, cv::Point& pupil, float& radius, cv::Mat* outProc)
+{
+    cv::Mat proc = preprocessEyePrepared(eyeClahe);
+    if (outProc) *outProc = proc;   // findContours는 입력을 바꾸지 않음 (OpenCV 3.2+)
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(proc, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+    if (contours.empty()) {
+        std::vector<cv::Vec3f> circles;
+        cv::HoughCircles(proc, circles, cv::HOUGH_GRADIENT, 1, eyeClahe.rows / 8, 200, 15,
+            eyeClahe.rows / 16, eyeClahe.rows / 3);
+        if (circles.empty()) return false;
+        cv::Vec3f c = circles[0];
+        pupil = cv::Point(cvRound(c[0]), cvRound(c[1]));
+        radius = c[2];
+        return true;
+    }
+
+    size_t idxMax = 0; double maxA = 0;
+    for (size_t i = 0; i < contours.size(); ++i) {
+        double a = cv::contourArea(contours[i]);
+        if (a > maxA) { maxA = a; idxMax = i; }
+    }
+    cv::Point2f c; float r;
+    cv::minEnclosingCircle(contours[idxMax], c, r);
+    pupil = cv::Point(cvRound(c.x), cvRound(c.y));
+    radius = r;
+    return true;
+}
@@ -4,3 +4,11 @@
 
 // 전처리 함수 선언
 cv::Mat preprocessEye(const cv::Mat& eyeGray);
+// 이미 CLAHE가 적용된 눈 ROI (FacePreprocessor(Clahe)의 뷰) -> CLAHE 생략, 나머지 단계만
+cv::Mat preprocessEyePrepared(const cv::Mat& eyeClahe);
+
+// pupil 찾기 (preprocessEye + 가장 큰 컨투어, 실패 시 허프원)
+// 👉 outProc이 주어지면 전처리 결과를 반환 (미리보기용, 아니면 생략)
+bool findPupilPreprocessed(const cv::Mat& eyeGray, cv::Point& pupil, float& radius, cv::Mat* outProc = nullptr);
+// 이미 CLAHE가 적용된 눈 ROI (FacePreprocessor(Clahe)의 뷰) -> preprocessEyePrepared 사용
+bool findPupilPreprocessedPrepared(const cv::Mat& eyeClahe, cv::Point& pupil, float& radius, cv::Mat* outProc = nullptr);
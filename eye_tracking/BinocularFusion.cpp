@@ -0,0 +1,34 @@
+// BinocularFusion.cpp
+#include "BinocularFusion.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace cv;
+
+bool BinocularFusion::fuse(bool lOk, Point2f l, float lConf, bool rOk, Point2f r, float rConf,
+    float dtSec, Point2f& out)
+{
+    if (!lOk && !rOk) return false;
+
+    // 오프셋은 두 눈이 다 믿을 만할 때만 갱신 (한쪽이 반쯤 감긴 프레임은 제외)
+    if (lOk && rOk && lConf >= minConf_ && rConf >= minConf_) {
+        const Point2f d = l - r;
+        if (!init_) { d_ = d; init_ = true; }
+        else {
+            const float a = dtSec <= 0.f ? 0.f : 1.f - std::exp(-dtSec / tau_);
+            d_ += (d - d_) * a;
+        }
+    }
+
+    // 눈별 가운데 추정값 (오프셋을 아직 모르면 그대로)
+    const Point2f half = d_ * 0.5f;
+    const Point2f lc = l - half, rc = r + half;
+    if (lOk && rOk) {
+        const float wl = std::max(lConf, 1e-3f), wr = std::max(rConf, 1e-3f);
+        out = (lc * wl + rc * wr) * (1.f / (wl + wr));
+    }
+    else {
+        out = lOk ? lc : rc;
+    }
+    return true;
+}
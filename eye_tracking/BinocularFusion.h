@@ -0,0 +1,35 @@
+// BinocularFusion.h
+// 양눈 시선 융합: 신뢰도 가중 + 눈 사이 오프셋(버전스) 보정으로 한쪽 눈만 보일 때도 값이 튀지 않게
+#pragma once
+#include <opencv2/opencv.hpp>
+
+/**
+ * @class BinocularFusion
+ * @brief 두 눈의 정규화 시선은 눈마다 오프셋이 달라서(ROI 위치, 버전스) 단순 평균은
+ * 한쪽 눈이 빠지는 순간 오프셋의 절반만큼 점프합니다.
+ * 두 눈이 다 보일 때 d = 왼눈 - 오른눈을 느린 EMA로 추적해 두고, 각 눈을 "가운데 추정값"
+ * (왼눈 - d/2, 오른눈 + d/2)으로 바꾼 뒤 신뢰도로 가중 평균합니다. 한쪽만 보이면 그 눈의 추정값만 씁니다.
+ * d는 거리/응시 깊이에 따라 천천히 바뀌므로 시정수 tauSec(기본 1초)로 따라갑니다.
+ */
+class BinocularFusion {
+public:
+    explicit BinocularFusion(float tauSec = 1.0f, float minConf = 0.15f) : tau_(tauSec), minConf_(minConf) {}
+
+    /**
+     * @brief 한 프레임의 두 눈 관측을 융합합니다.
+     * @param dtSec 직전 호출 이후 경과 시간 (오프셋 EMA용)
+     * @return 한쪽 눈 이상 보이면 true, out = 가운데 시선
+     */
+    bool fuse(bool lOk, cv::Point2f l, float lConf, bool rOk, cv::Point2f r, float rConf,
+        float dtSec, cv::Point2f& out);
+
+    void reset() { init_ = false; d_ = cv::Point2f(); }
+
+    bool ready() const { return init_; }
+    cv::Point2f offset() const { return d_; }   // 왼눈 - 오른눈
+
+private:
+    float tau_, minConf_;
+    bool init_ = false;     // 두 눈이 함께 보인 적 있음
+    cv::Point2f d_;
+};
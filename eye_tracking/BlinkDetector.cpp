@@ -2,37 +2,41 @@
 
 #include "BlinkDetector.h"
 
-// ������: �ʿ��� ���� ������ ���� �ʱ�ȭ�մϴ�.
-BlinkDetector::BlinkDetector(int required_frames) {
-    required_consecutive_frames = required_frames;
-    reset(); // ��� ���� ������ �ʱ� ���·� ����
+// 생성자: 깜빡임으로 판단할 최소 미검출 시간을 초기화합니다.
+BlinkDetector::BlinkDetector(std::chrono::milliseconds required_duration)
+    : required_duration(required_duration) {
+    reset(); // 모든 상태 변수를 초기 상태로 설정
 }
 
-// �� ������ ������ ���� ����� ������� ���¸� ������Ʈ�ϴ� �Լ�
-void BlinkDetector::checkBlink(bool is_pupil_detected) {
+// 각 프레임의 동공 검출 결과와 캡처 시각으로 상태를 갱신하는 함수
+void BlinkDetector::checkBlink(bool is_pupil_detected, Clock::time_point capture_time) {
     if (!is_pupil_detected) {
-        // �����ڰ� �������� ������ ī���͸� 1 ������ŵ�ϴ�.
-        blink_counter++;
+        // 동공이 처음 사라진 시각을 기록합니다.
+        if (!missing) {
+            missing = true;
+            missing_since = capture_time;
+        }
     }
     else {
-        // �����ڰ� �ٽ� �����Ǹ�, ���Ӽ��� �������Ƿ� ī���͸� 0���� �����մϴ�.
-        blink_counter = 0;
+        // 동공이 다시 검출되면 연속성이 끊어지므로 미검출 구간을 종료합니다.
+        missing = false;
     }
 
-    // ī���Ͱ� ������ ������ ���� �����߰�, ���� ����� ���°� �ƴ϶��
-    if (blink_counter >= required_consecutive_frames && !blinking_state) {
-        // ����� ���¸� true�� �����մϴ�.
+    // 미검출이 필요 시간 이상 지속되었고, 아직 깜빡임 상태가 아니라면
+    if (missing && capture_time - missing_since >= required_duration && !blinking_state) {
+        // 깜빡임 상태를 true로 설정합니다.
         blinking_state = true;
     }
 }
 
-// ���� ����� ���¸� ��ȯ�ϴ� �Լ�
+// 현재 깜빡임 상태를 반환하는 함수
 bool BlinkDetector::isBlinking() {
     return blinking_state;
 }
 
-// ��� ���¸� �ʱ�ȭ�ϴ� �Լ�. Ŭ�� �̺�Ʈ ó�� �� �ݵ�� ȣ���ؾ� �մϴ�.
+// 모든 상태를 초기화하는 함수. 클릭 이벤트 처리 후 반드시 호출해야 합니다.
 void BlinkDetector::reset() {
-    blink_counter = 0;
+    missing = false;
+    missing_since = Clock::time_point();
     blinking_state = false;
-}
\ No newline at end of file
+}
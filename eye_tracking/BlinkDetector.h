@@ -1,39 +1,45 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include <chrono>
 
 /**
  * @class BlinkDetector
- * @brief   Ͽ Ŭ ̺Ʈ ϴ ŬԴϴ.
- *   (ڰ  )   ̻ ӵǴ մϴ.
+ * @brief 눈 깜빡임을 감지하여 클릭 이벤트를 만드는 클래스입니다.
+ * 동공 미검출 상태(눈을 감은 상태)가 지정한 시간 이상 지속되는지 확인합니다.
+ * 프레임 수가 아니라 캡처 시각 기준이므로 FPS가 바뀌어도 동작이 같습니다.
  */
 class BlinkDetector {
 public:
+    using Clock = std::chrono::steady_clock;
+
     /**
-     * @brief BlinkDetector 
-     * @param required_frames     ܾ   մϴ.
+     * @brief BlinkDetector 생성자
+     * @param required_duration 이 시간 이상 연속으로 동공이 안 보여야 깜빡임으로 판단합니다.
      */
-    BlinkDetector(int required_frames = 5);
+    explicit BlinkDetector(std::chrono::milliseconds required_duration = std::chrono::milliseconds(167));
 
     /**
-     * @brief  Ӹ   θ ƮϿ  ¸ Ȯմϴ.
-     * @param is_pupil_detected  ӿ ڰ Ǿ  (true/false)
+     * @brief 매 프레임마다 동공 검출 여부를 반영하여 깜빡임 상태를 갱신합니다.
+     * @param is_pupil_detected 현재 프레임에서 동공이 검출되었는지 여부 (true/false)
+     * @param capture_time 현재 프레임의 캡처 시각
      */
-    void checkBlink(bool is_pupil_detected);
+    void checkBlink(bool is_pupil_detected, Clock::time_point capture_time);
 
     /**
-     * @brief   Ǿ Ȯմϴ.
-     * @return  Ǿ true, ƴϸ false ȯմϴ.
+     * @brief 현재 깜빡임이 감지되었는지 확인합니다.
+     * @return 깜빡임이 감지되었으면 true, 아니면 false를 반환합니다.
      */
     bool isBlinking();
 
     /**
-     * @brief  īͿ ¸ ʱȭմϴ. Ŭ ó  ȣؾ մϴ.
+     * @brief 미검출 시작 시각과 상태를 초기화합니다. 클릭 처리 후 호출해야 합니다.
      */
     void reset();
 
 private:
-    int blink_counter;                  //       ī
-    int required_consecutive_frames;    //  ϱ  ʿ   
-    bool blinking_state;                //   Ǿ ¸ ϴ ÷
-};
\ No newline at end of file
+    bool missing;                                   // 동공 미검출 구간 진행 중
+    Clock::time_point missing_since;                // 미검출이 시작된 캡처 시각
+    std::chrono::milliseconds required_duration;    // 깜빡임으로 판단하기 위한 최소 미검출 시간
+    bool blinking_state;                            // 현재 깜빡임이 감지되었는지 상태를 저장하는 플래그
+};
@@ -0,0 +1,26 @@
+// Calib.h
+// 5방향(LRUD) 캘리브레이션: 축별 중앙/음(좌·위)/양(우·아래) 기준점으로 구간 선형 정규화
+#pragma once
+#include <algorithm>
+
+struct Calib1D {
+    bool hasC = false, hasN = false, hasP = false; // C=Center, N=Negative(L/Up), P=Positive(R/Down)
+    float C = 0.f, N = 0.f, P = 0.f;
+    float map(float x) const {
+        if (!(hasC && hasN && hasP)) return x;
+        if (x <= C) {
+            float d = std::max(1e-4f, C - N);
+            return std::clamp((x - C) / d, -1.5f, 0.f);
+        }
+        else {
+            float d = std::max(1e-4f, P - C);
+            return std::clamp((x - C) / d, 0.f, 1.5f);
+        }
+    }
+    bool ready() const { return hasC && hasN && hasP && N < C && C < P; }
+};
+
+struct Calib2D {
+    Calib1D X, Y; // X: Left(-)/Right(+), Y: Up(-)/Down(+)
+    bool ready() const { return X.ready() && Y.ready(); }
+};
@@ -0,0 +1,50 @@
+// CoarsePupil.cpp
+#include "CoarsePupil.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace cv;
+
+// 적분 영상(CV_32S, (rows+1)x(cols+1))에서 사각형 합
+static inline int boxSum(const Mat& I, int x0, int y0, int x1, int y1) {
+    return I.at<int>(y1, x1) - I.at<int>(y0, x1) - I.at<int>(y1, x0) + I.at<int>(y0, x0);
+}
+
+bool coarsePupilWindow(const Mat& eye, Rect& window, Point2f* center, const CoarsePupilOptions& opt)
+{
+    window = Rect(0, 0, eye.cols, eye.rows);
+    if (eye.empty() || eye.type() != CV_8UC1) return false;
+
+    const float r = opt.radiusPx > 0.f ? opt.radiusPx : eye.cols * opt.radiusFrac;
+    const int b = std::max(3, (int)std::lround(2.f * r));   // 박스 한 변 = 예상 지름
+    if (eye.cols < 2 * b || eye.rows < 2 * b) return false;
+
+    Mat I; integral(eye, I, CV_32S);   // 255 * 1000 * 1000 < 2^31 이므로 눈 ROI는 32비트로 충분
+    const int step = std::max(1, b / 4);
+    const float inA = (float)(b * b);
+
+    float best = 1e9f;
+    Point bestTl;
+    for (int y = 0; y + b <= eye.rows; y += step) {
+        const int sy0 = std::max(0, y - b / 2), sy1 = std::min(eye.rows, y + b + b / 2);
+        for (int x = 0; x + b <= eye.cols; x += step) {
+            const int in = boxSum(I, x, y, x + b, y + b);
+            const int sx0 = std::max(0, x - b / 2), sx1 = std::min(eye.cols, x + b + b / 2);
+            const int ringA = (sx1 - sx0) * (sy1 - sy0) - b * b;
+            const float meanIn = in / inA;
+            const float meanRing = ringA > 0 ? (boxSum(I, sx0, sy0, sx1, sy1) - in) / (float)ringA : meanIn;
+            const float score = meanIn - opt.surround * meanRing;
+            if (score < best) { best = score; bestTl = Point(x, y); }
+        }
+    }
+
+    const Point2f c(bestTl.x + b * 0.5f, bestTl.y + b * 0.5f);
+    if (center) *center = c;
+
+    const int side = std::max(opt.minWindow, (int)std::lround(b * opt.grow));
+    const int w = std::min(side, eye.cols), h = std::min(side, eye.rows);
+    const int x0 = std::clamp((int)std::lround(c.x - w * 0.5f), 0, eye.cols - w);
+    const int y0 = std::clamp((int)std::lround(c.y - h * 0.5f), 0, eye.rows - h);
+    window = Rect(x0, y0, w, h);
+    return true;
+}
@@ -0,0 +1,24 @@
+// CoarsePupil.h
+// 동공 대략 위치: 눈 ROI 적분 영상 한 번 + 동공 크기 박스 슬라이딩(위치당 O(1))으로 가장 어두운 원판 자리를 찾고
+// 정밀 추정기(darkCentroidNorm, findPupil)가 돌 작은 창을 돌려줌 -> 눈썹/눈꺼풀 그림자를 창 밖으로
+#pragma once
+#include <opencv2/opencv.hpp>
+
+struct CoarsePupilOptions {
+    float radiusFrac = 0.08f;   // 예상 동공 반지름 = ROI 폭 x 비율 (radiusPx가 0일 때)
+    float radiusPx = 0.f;       // 예상 동공 반지름 px (0 = radiusFrac 사용)
+    float surround = 0.5f;      // 점수 = 안쪽 평균 - surround x 둘레 평균 (주변보다 어두운 곳 우대 -> 눈꺼풀 띠 억제)
+    float grow = 3.f;           // 창 한 변 = 예상 지름 x grow
+    int minWindow = 16;         // 창 최소 한 변 px (ROI보다 크면 ROI)
+};
+
+/**
+ * @brief 가장 어두운 동공 크기 박스를 찾아 그 주변 창을 ROI 좌표로 돌려줍니다.
+ * 박스 한 변 = 예상 지름, 둘레 = 박스 중심의 두 배 크기 사각형에서 박스를 뺀 부분 (ROI 밖은 잘라냄).
+ * 스트라이드는 박스 한 변의 1/4 (최소 1px). 모든 합은 적분 영상 조회 4번.
+ * @param eye 8비트 그레이 ROI (뷰 가능)
+ * @param center 선택: 가장 좋은 박스 중심 (ROI 좌표)
+ * @return ROI가 너무 작으면(예상 지름의 2배 미만) false, window = 전체 ROI
+ */
+bool coarsePupilWindow(const cv::Mat& eye, cv::Rect& window, cv::Point2f* center = nullptr,
+    const CoarsePupilOptions& opt = CoarsePupilOptions());
@@ -0,0 +1,62 @@
+// DetectorProfile.cpp
+#include "DetectorProfile.h"
+#include <iostream>
+
+using namespace cv;
+
+static void writeParams(FileStorage& fs, const char* key, const CascadeParams& p) {
+    fs << key << "{"
+        << "scaleFactor" << p.scaleFactor
+        << "minNeighbors" << p.minNeighbors
+        << "minSize" << p.minSize
+        << "maxSize" << p.maxSize
+        << "}";
+}
+
+static void readParams(const FileNode& n, CascadeParams& p) {
+    if (n.empty()) return;
+    if (!n["scaleFactor"].empty()) p.scaleFactor = (double)n["scaleFactor"];
+    if (!n["minNeighbors"].empty()) p.minNeighbors = (int)n["minNeighbors"];
+    if (!n["minSize"].empty()) n["minSize"] >> p.minSize;
+    if (!n["maxSize"].empty()) n["maxSize"] >> p.maxSize;
+}
+
+bool DetectorProfile::load(const std::string& path)
+{
+    FileStorage fs;
+    try {
+        if (!fs.open(path, FileStorage::READ)) {
+            std::cerr << "Detector profile open failed: " << path << "\n";
+            return false;
+        }
+        if (!fs["name"].empty()) name = (std::string)fs["name"];
+        if (!fs["camera"].empty()) camera = (std::string)fs["camera"];
+        readParams(fs["face"], face);
+        readParams(fs["eye"], eye);
+    }
+    catch (const cv::Exception& e) {
+        std::cerr << "Detector profile parse failed: " << path << " (" << e.what() << ")\n";
+        return false;
+    }
+
+    // scaleFactor <= 1 이면 detectMultiScale가 끝나지 않음
+    if (face.scaleFactor <= 1.0 || eye.scaleFactor <= 1.0 || face.minNeighbors < 0 || eye.minNeighbors < 0) {
+        std::cerr << "Detector profile invalid values: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool DetectorProfile::save(const std::string& path) const
+{
+    FileStorage fs(path, FileStorage::WRITE);
+    if (!fs.isOpened()) {
+        std::cerr << "Detector profile write failed: " << path << "\n";
+        return false;
+    }
+    fs << "name" << name;
+    fs << "camera" << camera;
+    writeParams(fs, "face", face);
+    writeParams(fs, "eye", eye);
+    return true;
+}
@@ -0,0 +1,35 @@
+// DetectorProfile.h
+// Haar 캐스케이드 검출 파라미터 프로파일 (카메라 모델별 YAML/JSON 파일로 배포)
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+// detectMultiScale 한 번에 넘기는 값들
+struct CascadeParams {
+    double scaleFactor = 1.1;
+    int minNeighbors = 3;
+    cv::Size minSize;   // (0,0) = 제한 없음
+    cv::Size maxSize;   // (0,0) = 제한 없음
+
+    void detect(cv::CascadeClassifier& c, const cv::Mat& gray, std::vector<cv::Rect>& out) const {
+        c.detectMultiScale(gray, out, scaleFactor, minNeighbors, 0, minSize, maxSize);
+    }
+};
+
+/**
+ * @struct DetectorProfile
+ * @brief 얼굴/눈 캐스케이드 파라미터 묶음. 기본값은 커서 파이프라인에서 쓰던 값입니다.
+ * (얼굴 1.1/3/120px, 눈 1.1/2/28~220px)
+ * tune_cascade(eye_bench)가 녹화 영상으로 찾아낸 값을 파일로 저장하면 시작할 때 --profile로 읽습니다.
+ */
+struct DetectorProfile {
+    std::string name = "default";
+    std::string camera;   // 어떤 카메라 모델/해상도용인지 (설명용)
+    CascadeParams face{ 1.1, 3, cv::Size(120, 120), cv::Size() };
+    CascadeParams eye{ 1.1, 2, cv::Size(28, 28), cv::Size(220, 220) };
+
+    // cv::FileStorage (확장자 .yml/.yaml/.json/.xml). 없는 키는 기본값 유지. 실패 시 false + stderr
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+};
@@ -0,0 +1,133 @@
+// DetectorRegistry.cpp
+#include "DetectorRegistry.h"
+#include "TiledDetector.h"
+#include <iostream>
+
+using namespace cv;
+
+static bool isAbsolute(const std::string& p) {
+    return !p.empty() && (p[0] == '/' || p[0] == '\\' || (p.size() > 1 && p[1] == ':'));
+}
+
+DetectorRegistry::DetectorRegistry()
+{
+    DetectorSpec f; f.name = "haar-face"; f.role = "face"; f.type = "haar"; f.model = "haarcascade_frontalface_default.xml";
+    DetectorSpec e; e.name = "haar-eye"; e.role = "eye"; e.type = "haar"; e.model = "haarcascade_eye_tree_eyeglasses.xml";
+    specs_ = { f, e };
+    face_ = f.name;
+    eye_ = e.name;
+}
+
+bool DetectorRegistry::load(const std::string& path)
+{
+    std::vector<DetectorSpec> specs;
+    std::string face, eye;
+    try {
+        FileStorage fs(path, FileStorage::READ);
+        if (!fs.isOpened()) {
+            std::cerr << "Detector config open failed: " << path << "\n";
+            return false;
+        }
+        const size_t slash = path.find_last_of("/\\");
+        const std::string dir = slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+
+        FileNode list = fs["detectors"];
+        for (FileNodeIterator it = list.begin(); it != list.end(); ++it) {
+            FileNode n = *it;
+            DetectorSpec s;
+            s.name = (std::string)n["name"];
+            s.role = (std::string)n["role"];
+            s.type = (std::string)n["type"];
+            s.model = (std::string)n["model"];
+            if (!n["score"].empty()) s.scoreThreshold = (float)n["score"];
+            if (!n["nms"].empty()) s.nmsThreshold = (float)n["nms"];
+            if (!n["topK"].empty()) s.topK = (int)n["topK"];
+            if (!n["tiles"].empty()) s.tiles = (int)n["tiles"];
+            if (!n["maxFace"].empty()) s.maxFace = (int)n["maxFace"];
+            if (s.name.empty() || s.model.empty() || (s.role != "face" && s.role != "eye")
+                || (s.type != "haar" && s.type != "lbp" && s.type != "yunet")) {
+                std::cerr << "Detector config: skipping invalid entry '" << s.name << "'\n";
+                continue;
+            }
+            if (s.type == "yunet" && s.role != "face") {
+                std::cerr << "Detector config: " << s.name << ": yunet is face-only\n";
+                continue;
+            }
+            if (s.tiles > 1 && s.role != "face") {
+                std::cerr << "Detector config: " << s.name << ": tiles only applies to face detectors\n";
+                s.tiles = 0;
+            }
+            if (!isAbsolute(s.model)) s.model = dir + s.model;
+            specs.push_back(s);
+        }
+        face = (std::string)fs["face"];
+        eye = (std::string)fs["eye"];
+    }
+    catch (const cv::Exception& e) {
+        std::cerr << "Detector config parse failed: " << path << " (" << e.what() << ")\n";
+        return false;
+    }
+
+    // 선택이 없으면 역할별 첫 항목
+    auto pick = [&](std::string& sel, const char* role) {
+        for (const DetectorSpec& s : specs) if (s.name == sel && s.role == role) return true;
+        for (const DetectorSpec& s : specs) if (s.role == role) { sel = s.name; return true; }
+        return false;
+    };
+    if (!pick(face, "face") || !pick(eye, "eye")) {
+        std::cerr << "Detector config needs at least one face and one eye detector: " << path << "\n";
+        return false;
+    }
+    specs_ = std::move(specs);
+    face_ = face;
+    eye_ = eye;
+    return true;
+}
+
+const DetectorSpec* DetectorRegistry::find(const std::string& name) const
+{
+    for (const DetectorSpec& s : specs_) if (s.name == name) return &s;
+    return nullptr;
+}
+
+std::shared_ptr<ObjectDetector> DetectorRegistry::create(const std::string& name, const DetectorProfile& profile) const
+{
+    const DetectorSpec* s = find(name);
+    if (!s) {
+        std::cerr << "Unknown detector: " << name << "\n";
+        return nullptr;
+    }
+    const CascadeParams& params = s->role == "face" ? profile.face : profile.eye;
+    if (s->tiles > 1) {
+        const DetectorSpec spec = *s;
+        int maxFace = spec.maxFace > 0 ? spec.maxFace : params.maxSize.height;
+        return TiledDetector::create(spec.name, [this, spec, params]() { return createOne(spec, params); },
+            spec.tiles, maxFace);
+    }
+    return createOne(*s, params);
+}
+
+std::unique_ptr<ObjectDetector> DetectorRegistry::createOne(const DetectorSpec& s, const CascadeParams& params) const
+{
+    if (s.type == "yunet") {
+#ifdef EYE_HAVE_YUNET
+        return YuNetDetector::create(s.name, s.model, params, s.scoreThreshold, s.nmsThreshold, s.topK);
+#else
+        std::cerr << s.name << ": FaceDetectorYN needs OpenCV 4.5.4+\n";
+        return nullptr;
+#endif
+    }
+    return CascadeDetector::create(s.name, s.model, params, s.type == "lbp");
+}
+
+std::string DetectorRegistry::next(const std::string& current) const
+{
+    const DetectorSpec* cur = find(current);
+    if (!cur) return current;
+    size_t i = (size_t)(cur - specs_.data());
+    for (size_t k = 1; k <= specs_.size(); ++k) {
+        const DetectorSpec& s = specs_[(i + k) % specs_.size()];
+        if (s.role == cur->role) return s.name;
+    }
+    return current;
+}
@@ -0,0 +1,59 @@
+// DetectorRegistry.h
+// 이름 -> 검출기 설정 목록. 설정 파일에서 얼굴/눈 검출기를 이름으로 골라 생성
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "DetectorProfile.h"
+#include "ObjectDetector.h"
+
+struct DetectorSpec {
+    std::string name;             // 설정에서 부르는 이름
+    std::string role;             // "face" | "eye"
+    std::string type;             // "haar" | "lbp" | "yunet"(얼굴 전용)
+    std::string model;            // XML/ONNX 경로 (상대 경로는 설정 파일 폴더 기준)
+    float scoreThreshold = 0.8f;  // yunet
+    float nmsThreshold = 0.3f;    // yunet
+    int topK = 20;                // yunet
+    int tiles = 0;                // 얼굴: 2 이상이면 프레임을 띠로 나눠 이 수만큼 스레드로 검출 (TiledDetector)
+    int maxFace = 0;              // tiles용 최대 얼굴 높이 px (0이면 프로파일 maxSize, 그것도 없으면 프레임 높이의 절반)
+};
+
+/**
+ * @class DetectorRegistry
+ * @brief 검출기 목록과 현재 선택(얼굴/눈)을 들고 있다가 create()로 새 인스턴스를 만듭니다.
+ * 설정 파일이 없으면 기존 Haar 두 개("haar-face", "haar-eye", 작업 폴더의 XML)만 등록됩니다.
+ *
+ * 설정 예 (cv::FileStorage YAML):
+ *   face: "face-lbp"
+ *   eye: "eye-haar"
+ *   detectors:
+ *     - { name: "face-lbp", role: "face", type: "lbp", model: "lbpcascade_frontalface_improved.xml" }
+ *     - { name: "face-yunet", role: "face", type: "yunet", model: "face_detection_yunet_2023mar.onnx", score: 0.8 }
+ *     - { name: "face-haar-x8", role: "face", type: "haar", model: "haarcascade_frontalface_default.xml", tiles: 8, maxFace: 360 }
+ *     - { name: "eye-haar", role: "eye", type: "haar", model: "haarcascade_eye_tree_eyeglasses.xml" }
+ */
+class DetectorRegistry {
+public:
+    DetectorRegistry();
+
+    // 목록을 통째로 바꿈 (실패 시 기존 목록 유지, false + stderr)
+    bool load(const std::string& path);
+
+    const std::vector<DetectorSpec>& specs() const { return specs_; }
+    const std::string& faceName() const { return face_; }
+    const std::string& eyeName() const { return eye_; }
+
+    // name 검출기 새 인스턴스 (params = 역할에 맞는 DetectorProfile 값). 실패 시 nullptr + stderr
+    std::shared_ptr<ObjectDetector> create(const std::string& name, const DetectorProfile& profile) const;
+
+    // 같은 역할에서 current 다음 검출기 이름 (순환). 하나뿐이면 current
+    std::string next(const std::string& current) const;
+
+private:
+    const DetectorSpec* find(const std::string& name) const;
+    std::unique_ptr<ObjectDetector> createOne(const DetectorSpec& s, const CascadeParams& params) const;
+
+    std::vector<DetectorSpec> specs_;
+    std::string face_, eye_;
+};
@@ -0,0 +1,40 @@
+// FacePreprocessor.cpp
+#include "FacePreprocessor.h"
+
+using namespace cv;
+
+FacePreprocessor::FacePreprocessor(FaceNormMode mode) : mode_(mode)
+{
+    if (mode_ == FaceNormMode::Clahe) clahe_ = createCLAHE(2.0, Size(8, 8));
+}
+
+void FacePreprocessor::compute(const Mat& gray, const Rect& region)
+{
+    region_ = region & Rect(0, 0, gray.cols, gray.rows);
+    if (region_.empty() || gray.type() != CV_8UC1) { norm_.release(); smooth_.release(); region_ = Rect(); return; }
+
+    const Mat src = gray(region_);
+    norm_ = fit(normBuf_, region_.size());
+    if (mode_ == FaceNormMode::Clahe) {
+        clahe_->apply(src, norm_);
+        smooth_ = norm_;   // preprocessEye는 자체 medianBlur
+        return;
+    }
+    equalizeHist(src, norm_);
+    smooth_ = fit(smoothBuf_, region_.size());
+    GaussianBlur(norm_, smooth_, Size(7, 7), 0);
+}
+
+Mat FacePreprocessor::fit(Mat& buf, Size size)
+{
+    const size_t need = (size_t)size.area();
+    if (buf.total() < need) buf.create(1, (int)(need + need / 4), CV_8UC1);   // 25% 여유 (얼굴이 조금씩 커질 때 반복 재할당 방지)
+    return Mat(size, CV_8UC1, buf.data);
+}
+
+Mat FacePreprocessor::view(const Mat& m, const Rect& frameRect) const
+{
+    const Rect r = clip(frameRect);
+    if (m.empty() || r.empty()) return Mat();
+    return m(r - region_.tl());
+}
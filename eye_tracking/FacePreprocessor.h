@@ -0,0 +1,63 @@
+// FacePreprocessor.h
+// 얼굴 단위 전처리: 위쪽 얼굴 영역 대비 정규화(equalizeHist 또는 CLAHE) + 평활을 프레임당 한 번 계산하고
+// 눈 캐스케이드와 두 눈의 동공 추정기는 그 결과의 뷰만 받아 씀
+#pragma once
+#include <opencv2/opencv.hpp>
+
+enum class FaceNormMode {
+    Equalize,   // equalizeHist (darkCentroidNorm / findPupil 계열)
+    Clahe       // CLAHE 2.0 / 8x8 (preprocessEye 계열)
+};
+
+// 얼굴/눈 박스 기하 (검출 파이프라인 공통)
+constexpr double kUpperFaceRatio = 0.6;             // 눈을 찾는 위쪽 얼굴 = 얼굴 박스 위 60%
+constexpr double kEyeCropX = 0.14, kEyeCropY = 0.38;   // 눈 박스에서 좌우/상하로 잘라낼 비율 (상하도 중요하므로 위쪽을 좀 더)
+
+inline cv::Rect upperFaceRect(const cv::Rect& face) {
+    return cv::Rect(face.x, face.y, face.width, (int)(face.height * kUpperFaceRatio));
+}
+
+// 눈 캐스케이드 박스 -> 동공 추정 ROI (같은 좌표계, 클리핑은 호출 쪽에서)
+inline cv::Rect eyeCropRect(const cv::Rect& eye) {
+    const int sx = (int)(eye.width * kEyeCropX), sy = (int)(eye.height * kEyeCropY);
+    return cv::Rect(eye.x + sx, eye.y + sy, eye.width - 2 * sx, eye.height - 2 * sy);
+}
+
+/**
+ * @class FacePreprocessor
+ * @brief 눈 ROI마다 따로 하던 대비 정규화를 위쪽 얼굴 영역에서 한 번만 합니다.
+ * 두 눈이 같은 히스토그램/CLAHE 타일을 공유하므로 눈 사이 대비가 일관되고, 겹치는 픽셀을 두 번 처리하지 않습니다.
+ * compute() 후 norm(r) / smooth(r)는 프레임 좌표 사각형 r을 영역 안으로 잘라 복사 없이 뷰로 돌려줍니다.
+ * CLAHE 객체와 결과 저장소는 인스턴스가 재사용합니다 (스레드 하나 전용). 얼굴 크기가 프레임마다 달라도
+ * 저장소는 지금까지 가장 큰 영역에 맞춰 한 번만 늘리므로 매 프레임 할당이 없습니다 (뷰는 다음 compute 전까지 유효).
+ */
+class FacePreprocessor {
+public:
+    explicit FacePreprocessor(FaceNormMode mode = FaceNormMode::Equalize);
+
+    // gray: 프레임 전체 그레이, region: 프레임 좌표 위쪽 얼굴 (프레임 밖은 잘라냄)
+    void compute(const cv::Mat& gray, const cv::Rect& region);
+
+    const cv::Rect& region() const { return region_; }
+    bool empty() const { return norm_.empty(); }
+
+    // 대비 정규화 영상 (눈 캐스케이드 입력)
+    cv::Mat norm() const { return norm_; }
+    cv::Mat norm(const cv::Rect& frameRect) const { return view(norm_, frameRect); }
+    // norm의 7x7 가우시안 (동공 추정기 입력). Clahe 모드는 평활 없이 norm과 같음
+    cv::Mat smooth(const cv::Rect& frameRect) const { return view(smooth_, frameRect); }
+
+    // 프레임 좌표 사각형 -> 영역 안으로 자른 프레임 좌표
+    cv::Rect clip(const cv::Rect& frameRect) const { return frameRect & region_; }
+
+private:
+    cv::Mat view(const cv::Mat& m, const cv::Rect& frameRect) const;
+    // buf 저장소 위의 size 8비트 헤더 (모자라면 buf만 늘림)
+    static cv::Mat fit(cv::Mat& buf, cv::Size size);
+
+    FaceNormMode mode_;
+    cv::Ptr<cv::CLAHE> clahe_;
+    cv::Rect region_;
+    cv::Mat norm_, smooth_;
+    cv::Mat normBuf_, smoothBuf_;   // norm_/smooth_ 저장소 (늘기만 함)
+};
@@ -0,0 +1,20 @@
+// MotionDetector.cpp
+#include "MotionDetector.h"
+
+using namespace cv;
+
+bool MotionDetector::update(const Mat& gray)
+{
+    frac_ = 0.f;
+    if (gray.empty()) return false;
+    resize(gray, small_, opt_.size, 0, 0, INTER_AREA);
+    if (prev_.empty() || warm_ < opt_.warmupFrames) {
+        ++warm_;
+        small_.copyTo(prev_);
+        return false;
+    }
+    absdiff(small_, prev_, diff_);
+    std::swap(small_, prev_);
+    frac_ = countNonZero(diff_ > opt_.pixelThresh) / (float)diff_.total();
+    return frac_ > opt_.areaFrac;
+}
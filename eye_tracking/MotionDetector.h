@@ -0,0 +1,34 @@
+// MotionDetector.h
+// 대기(standby) 모드용 값싼 움직임 감지: 프레임을 아주 작게 줄여 직전 프레임과 차분, 바뀐 픽셀 비율로 판단
+#pragma once
+#include <opencv2/opencv.hpp>
+
+struct MotionOptions {
+    cv::Size size = cv::Size(80, 45);   // 비교 해상도 (입력을 INTER_AREA로 축소 -> 센서 노이즈도 평균됨)
+    int pixelThresh = 18;               // 이만큼 넘게 바뀐 픽셀을 "움직임"으로
+    float areaFrac = 0.005f;            // 움직인 픽셀 비율이 이보다 크면 true (80x45에서 18px)
+    int warmupFrames = 3;               // reset 후 처음 N프레임은 기준만 갱신 (해상도 전환 직후 자동 노출 흔들림)
+};
+
+/**
+ * @class MotionDetector
+ * @brief update()마다 축소 그레이를 직전 축소 그레이와 비교합니다. 프레임당 비용은 축소 + 3600픽셀 차분 정도라
+ * 얼굴 캐스케이드보다 수백 배 쌉니다. 천천히 변하는 조명은 연속 프레임 차이가 작아서 걸리지 않습니다.
+ */
+class MotionDetector {
+public:
+    explicit MotionDetector(MotionOptions opt = MotionOptions()) : opt_(opt) {}
+
+    // gray: 8비트 그레이 (크기는 상관없음). 움직임이 있으면 true
+    bool update(const cv::Mat& gray);
+    // 다음 update부터 기준을 새로 잡음
+    void reset() { prev_.release(); warm_ = 0; }
+    // 마지막 update의 움직인 픽셀 비율 (0..1)
+    float fraction() const { return frac_; }
+
+private:
+    MotionOptions opt_;
+    cv::Mat small_, prev_, diff_;
+    int warm_ = 0;
+    float frac_ = 0.f;
+};
@@ -0,0 +1,72 @@
+// ObjectDetector.cpp
+#include "ObjectDetector.h"
+#include <iostream>
+
+using namespace cv;
+
+std::unique_ptr<CascadeDetector> CascadeDetector::create(const std::string& name, const std::string& xml,
+    const CascadeParams& params, bool expectLbp)
+{
+    std::unique_ptr<CascadeDetector> d(new CascadeDetector(name, params));
+    if (!d->cascade_.load(xml)) {
+        std::cerr << "Load cascade failed: " << xml << "\n";
+        return nullptr;
+    }
+    const bool isLbp = d->cascade_.getFeatureType() == CascadeClassifier::LBP;
+    if (isLbp != expectLbp)
+        std::cerr << "Warning: " << name << " (" << xml << ") is " << (isLbp ? "an LBP" : "not an LBP") << " cascade\n";
+    return d;
+}
+
+void CascadeDetector::detect(const Mat& image, std::vector<Rect>& out)
+{
+    const CascadeParams p = scaled(params_);
+    if (image.channels() == 1) { p.detect(cascade_, image, out); return; }
+    cvtColor(image, gray_, COLOR_BGR2GRAY);
+    p.detect(cascade_, gray_, out);
+}
+
+#ifdef EYE_HAVE_YUNET
+std::unique_ptr<YuNetDetector> YuNetDetector::create(const std::string& name, const std::string& onnx,
+    const CascadeParams& sizeLimits, float scoreThreshold, float nmsThreshold, int topK)
+{
+    std::unique_ptr<YuNetDetector> d(new YuNetDetector(name, sizeLimits));
+    try {
+        // 입력 크기는 첫 프레임에서 맞춤. CPU 백엔드 고정
+        d->net_ = FaceDetectorYN::create(onnx, "", Size(320, 320), scoreThreshold, nmsThreshold, topK,
+            dnn::DNN_BACKEND_OPENCV, dnn::DNN_TARGET_CPU);
+    }
+    catch (const cv::Exception& e) {
+        std::cerr << "Load YuNet model failed: " << onnx << " (" << e.what() << ")\n";
+        return nullptr;
+    }
+    if (d->net_.empty()) {
+        std::cerr << "Load YuNet model failed: " << onnx << "\n";
+        return nullptr;
+    }
+    return d;
+}
+
+void YuNetDetector::detect(const Mat& image, std::vector<Rect>& out)
+{
+    out.clear();
+    const Mat* in = &image;
+    if (image.channels() == 1) { cvtColor(image, bgr_, COLOR_GRAY2BGR); in = &bgr_; }
+    if (in->size() != inputSize_) {
+        inputSize_ = in->size();
+        net_->setInputSize(inputSize_);
+    }
+    net_->detect(*in, faces_);
+
+    // faces_: N x 15 (x, y, w, h, 눈/코/입 랜드마크 10개, 점수)
+    const Rect bounds(0, 0, in->cols, in->rows);
+    const CascadeParams lim = scaled(limits_);
+    for (int i = 0; i < faces_.rows; ++i) {
+        const float* r = faces_.ptr<float>(i);
+        Rect box = Rect(cvRound(r[0]), cvRound(r[1]), cvRound(r[2]), cvRound(r[3])) & bounds;
+        if (box.width < lim.minSize.width || box.height < lim.minSize.height) continue;
+        if (lim.maxSize.width > 0 && (box.width > lim.maxSize.width || box.height > lim.maxSize.height)) continue;
+        out.push_back(box);
+    }
+}
+#endif
@@ -0,0 +1,89 @@
+// ObjectDetector.h
+// 얼굴/눈 검출기 공통 인터페이스 + 구현 (Haar/LBP 캐스케이드, YuNet = cv::FaceDetectorYN + ONNX)
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "DetectorProfile.h"
+
+// FaceDetectorYN은 OpenCV 4.5.4부터
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && (CV_VERSION_MINOR > 5 || (CV_VERSION_MINOR == 5 && CV_VERSION_REVISION >= 4)))
+#define EYE_HAVE_YUNET 1
+#endif
+
+/**
+ * @class ObjectDetector
+ * @brief 검출기 하나 = 모델 하나. 인스턴스는 스레드 하나에서만 씁니다 (카메라 스레드마다 따로 생성).
+ */
+class ObjectDetector {
+public:
+    virtual ~ObjectDetector() = default;
+
+    // image: 8비트 그레이 또는 BGR. out: image 좌표계 박스
+    virtual void detect(const cv::Mat& image, std::vector<cv::Rect>& out) = 0;
+
+    // 설정에서 부르는 이름 (예: "face-lbp")
+    const std::string& name() const { return name_; }
+
+    // 입력 이미지 px / 프로파일 기준 px. 저해상도로 받은 프레임이면 <1 -> 최소/최대 크기도 그만큼 줄임
+    virtual void setSizeScale(double s) { sizeScale_ = s; }
+    // 피라미드 배율 하한 (부하가 클 때 QualityController가 올림). 프로파일 값이 더 크면 그대로
+    virtual void setMinScaleFactor(double f) { minScaleFactor_ = f; }
+
+protected:
+    explicit ObjectDetector(std::string name) : name_(std::move(name)) {}
+
+    // 프로파일 크기 제한에 sizeScale_, 배율에 minScaleFactor_ 적용
+    CascadeParams scaled(const CascadeParams& p) const {
+        if (sizeScale_ == 1.0 && minScaleFactor_ <= p.scaleFactor) return p;
+        CascadeParams q = p;
+        q.scaleFactor = std::max(p.scaleFactor, minScaleFactor_);
+        q.minSize = cv::Size(cvRound(p.minSize.width * sizeScale_), cvRound(p.minSize.height * sizeScale_));
+        q.maxSize = cv::Size(cvRound(p.maxSize.width * sizeScale_), cvRound(p.maxSize.height * sizeScale_));
+        return q;
+    }
+
+    double sizeScale_ = 1.0;
+    double minScaleFactor_ = 0.0;
+
+private:
+    std::string name_;
+};
+
+// Haar/LBP 캐스케이드 (XML 안의 특징 종류로 자동 구분, 파라미터는 DetectorProfile)
+class CascadeDetector : public ObjectDetector {
+public:
+    // 로드 실패 시 nullptr + stderr. expectLbp면 LBP가 아닌 XML일 때 경고
+    static std::unique_ptr<CascadeDetector> create(const std::string& name, const std::string& xml,
+        const CascadeParams& params, bool expectLbp);
+
+    void detect(const cv::Mat& image, std::vector<cv::Rect>& out) override;
+
+private:
+    CascadeDetector(std::string name, const CascadeParams& params) : ObjectDetector(std::move(name)), params_(params) {}
+
+    cv::CascadeClassifier cascade_;
+    CascadeParams params_;
+    cv::Mat gray_;   // BGR 입력 변환 버퍼
+};
+
+#ifdef EYE_HAVE_YUNET
+// YuNet 얼굴 검출 (CPU, ONNX). 점수/NMS 임계값은 설정, 최소/최대 크기는 DetectorProfile로 거름
+class YuNetDetector : public ObjectDetector {
+public:
+    static std::unique_ptr<YuNetDetector> create(const std::string& name, const std::string& onnx,
+        const CascadeParams& sizeLimits, float scoreThreshold, float nmsThreshold, int topK);
+
+    void detect(const cv::Mat& image, std::vector<cv::Rect>& out) override;
+
+private:
+    YuNetDetector(std::string name, const CascadeParams& sizeLimits) : ObjectDetector(std::move(name)), limits_(sizeLimits) {}
+
+    cv::Ptr<cv::FaceDetectorYN> net_;
+    CascadeParams limits_;
+    cv::Size inputSize_;
+    cv::Mat bgr_, faces_;
+};
+#endif
@@ -0,0 +1,66 @@
+// PupilCache.cpp
+#include "PupilCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace cv;
+
+void PupilCacheStats::merge(const PupilCacheStats& o)
+{
+    lookups += o.lookups; hits += o.hits;
+    audits += o.audits; auditFlips += o.auditFlips;
+    sumErr += o.sumErr;
+    maxErr = std::max(maxErr, o.maxErr);
+}
+
+bool PupilCache::lookup(const Mat& eye, PupilResult& out)
+{
+    ++stats_.lookups;
+    pending_ = true;
+    auditing_ = false;
+    diff_ = -1.f;
+    if (eye.empty()) { valid_ = false; return false; }
+    resize(eye, cand_, opt_.sigSize, 0, 0, INTER_AREA);
+    candSize_ = eye.size();
+    if (!opt_.enabled || !valid_) return false;
+    if (std::abs(eye.cols - roiSize_.width) > 1 || std::abs(eye.rows - roiSize_.height) > 1) return false;
+
+    diff_ = (float)(norm(cand_, sig_, NORM_L1) / (double)cand_.total());
+    if (diff_ > opt_.maxDiff || age_ >= opt_.maxAge) return false;
+
+    if (opt_.auditEvery > 0 && ++sinceAudit_ >= opt_.auditEvery) {
+        // 감사: 적중이지만 실제로 계산하게 하고 store에서 차이를 잼 (기준 시그니처/나이는 그대로)
+        sinceAudit_ = 0;
+        auditing_ = true;
+        return false;
+    }
+    ++stats_.hits;
+    ++age_;
+    pending_ = false;
+    out = cached_;
+    return true;
+}
+
+void PupilCache::store(const PupilResult& r)
+{
+    if (!pending_) return;
+    pending_ = false;
+    if (auditing_) {
+        auditing_ = false;
+        ++stats_.audits;
+        if (r.ok != cached_.ok) ++stats_.auditFlips;
+        else if (r.ok) {
+            const float e = std::hypot(r.nx - cached_.nx, r.ny - cached_.ny);
+            stats_.sumErr += e;
+            stats_.maxErr = std::max(stats_.maxErr, e);
+        }
+        ++age_;
+        return;   // 적중과 같은 취급: 캐시 값/기준은 유지 (감사가 결과를 바꾸지 않음)
+    }
+    cached_ = r;
+    std::swap(sig_, cand_);
+    roiSize_ = candSize_;
+    valid_ = !sig_.empty();
+    age_ = 0;
+}
@@ -0,0 +1,68 @@
+// PupilCache.h
+// 눈별 동공 결과 캐시: 눈 ROI를 16x8로 줄인 시그니처가 마지막으로 실제 계산한 프레임과 거의 같으면
+// (평균 절대 차 <= maxDiff) darkCentroidNorm/findPupil을 건너뛰고 이전 서브픽셀 중심을 그대로 씀 (응시 중 대부분의 프레임)
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+
+struct PupilCacheOptions {
+    bool enabled = true;
+    cv::Size sigSize = cv::Size(16, 8);   // 시그니처 크기 (INTER_AREA 축소 한 번 = 벡터화된 한 패스)
+    float maxDiff = 2.5f;                 // 시그니처 평균 절대 차 (그레이 레벨) 이하면 재사용
+    int maxAge = 15;                      // 연속 재사용 상한 (프레임), 넘으면 강제 재계산
+    int auditEvery = 16;                  // 재사용 N번마다 한 번은 실제로 계산해 캐시 오차를 잼 (0 = 안 잼)
+};
+
+// 동공 추정 결과 하나 (정규화 좌표, darkCentroidNorm 규약)
+struct PupilResult {
+    bool ok = false;
+    float nx = 0.f, ny = 0.f, conf = 0.f;
+};
+
+// 임계값 튜닝용 지표: 적중률 + 감사(재사용했을 프레임을 실제로 계산)로 잰 오차
+struct PupilCacheStats {
+    uint64_t lookups = 0, hits = 0;
+    uint64_t audits = 0;
+    uint64_t auditFlips = 0;    // 감사에서 검출 여부(ok)가 캐시와 달랐던 수
+    double sumErr = 0.0;        // 감사 오차 합 (정규화 단위, 유클리드, 둘 다 ok일 때만)
+    float maxErr = 0.f;
+
+    float hitRate() const { return lookups ? (float)hits / lookups : 0.f; }
+    float meanErr() const { return audits > auditFlips ? (float)(sumErr / (audits - auditFlips)) : 0.f; }
+    void merge(const PupilCacheStats& o);
+};
+
+/**
+ * @class PupilCache
+ * @brief lookup()이 true면 out에 캐시 결과가 들어 있고 추정기를 건너뜁니다. false면 추정기를 돌려 store()로 넘깁니다.
+ * 비교 기준은 마지막으로 "실제 계산한" 프레임의 시그니처라서 재사용 중 조금씩 쌓이는 변화도 결국 재계산을 부릅니다.
+ * ROI 크기가 1px 넘게 바뀌면(정규화 기준이 달라짐) 항상 재계산. 감사 차례의 적중은 false를 돌려주고
+ * store() 값과 캐시 값의 차이를 stats()에 쌓습니다. 인스턴스는 눈 하나, 스레드 하나 전용.
+ */
+class PupilCache {
+public:
+    explicit PupilCache(PupilCacheOptions opt = PupilCacheOptions()) : opt_(opt) {}
+
+    bool lookup(const cv::Mat& eye, PupilResult& out);
+    void store(const PupilResult& r);
+    // 추정기 설정이 바뀌었거나 눈을 놓침: 다음 lookup은 무조건 재계산
+    void reset() { valid_ = false; pending_ = false; }
+
+    const PupilCacheStats& stats() const { return stats_; }
+    void resetStats() { stats_ = PupilCacheStats(); }
+    // 마지막 lookup의 시그니처 차이 (평균 절대 차, 비교 못 했으면 -1)
+    float lastDiff() const { return diff_; }
+    const PupilCacheOptions& options() const { return opt_; }
+
+private:
+    PupilCacheOptions opt_;
+    cv::Mat sig_, cand_;        // 기준 시그니처 (마지막 계산 프레임), 이번 프레임
+    cv::Size roiSize_, candSize_;   // 기준 / 이번 ROI 크기
+    PupilResult cached_;
+    bool valid_ = false;
+    bool pending_ = false;      // lookup이 false를 돌려줌 -> store 대기
+    bool auditing_ = false;     // 이번 store는 감사
+    int age_ = 0, sinceAudit_ = 0;
+    float diff_ = -1.f;
+    PupilCacheStats stats_;
+};
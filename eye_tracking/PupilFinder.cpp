@@ -0,0 +1,70 @@
+// PupilFinder.cpp
+#include "PupilFinder.h"
+#include "CoarsePupil.h"
+
+using namespace cv;
+
+static bool findPupilBinarize(const Mat& eq, const Mat& blurImg, Point& pupil, float& radius);
+
+bool findPupil(const Mat& eyeGray, Point& pupil, float& radius)
+{
+    // 1) 전처리
+    Mat blurImg; GaussianBlur(eyeGray, blurImg, Size(7, 7), 0);
+    // 눈꺼풀/하이라이트 제거를 위해 상위 톤 억제
+    Mat eq; equalizeHist(blurImg, eq);
+    return findPupilBinarize(eq, blurImg, pupil, radius);
+}
+
+bool findPupilPrepared(const Mat& eyeSmooth, Point& pupil, float& radius)
+{
+    if (eyeSmooth.empty() || eyeSmooth.type() != CV_8UC1) return false;
+    return findPupilBinarize(eyeSmooth, eyeSmooth, pupil, radius);
+}
+
+// eq: 이진화 입력, blurImg: 허프원 입력 (둘 다 eyeGray 크기)
+static bool findPupilBinarize(const Mat& eq, const Mat& blurImg, Point& pupil, float& radius)
+{
+    const Mat& eyeGray = eq;   // 허프 파라미터는 ROI 크기만 씀
+    // 2) 동공은 어두움: Otsu + 반전
+    Mat bin;
+    threshold(eq, bin, 0, 255, THRESH_BINARY_INV | THRESH_OTSU);
+
+    // 3) 열림 연산으로 잡티 제거
+    morphologyEx(bin, bin, MORPH_OPEN, getStructuringElement(MORPH_ELLIPSE, Size(3, 3)));
+
+    // 4) 큰 컨투어 중심을 후보로
+    std::vector<std::vector<Point>> contours;
+    findContours(bin, contours, RETR_EXTERNAL, CHAIN_APPROX_SIMPLE);
+    if (contours.empty()) {
+        // 실패하면 허프원 시도
+        std::vector<Vec3f> circles;
+        HoughCircles(blurImg, circles, HOUGH_GRADIENT, 1, eyeGray.rows / 8, 200, 15, eyeGray.rows / 16, eyeGray.rows / 3);
+        if (circles.empty()) return false;
+        Vec3f c = circles[0];
+        pupil = Point(cvRound(c[0]), cvRound(c[1]));
+        radius = c[2];
+        return true;
+    }
+    // 가장 큰 컨투어 선택
+    size_t idxMax = 0; double maxA = 0;
+    for (size_t i = 0; i < contours.size(); ++i) {
+        double a = contourArea(contours[i]);
+        if (a > maxA) { maxA = a; idxMax = i; }
+    }
+    Point2f c; float r;
+    minEnclosingCircle(contours[idxMax], c, r);
+    pupil = Point(cvRound(c.x), cvRound(c.y));
+    radius = r;
+    return true;
+}
+
+bool findPupilCoarse(const Mat& eye, bool prepared, Point& pupil, float& radius)
+{
+    if (eye.empty() || eye.type() != CV_8UC1) return false;
+    Rect win;
+    coarsePupilWindow(eye, win);
+    const Mat sub = eye(win);
+    if (!(prepared ? findPupilPrepared(sub, pupil, radius) : findPupil(sub, pupil, radius))) return false;
+    pupil += win.tl();
+    return true;
+}
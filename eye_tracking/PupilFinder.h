@@ -0,0 +1,13 @@
+// PupilFinder.h
+#pragma once
+#include <opencv2/opencv.hpp>
+
+// pupil 찾기 (Otsu 이진화 + 가장 큰 컨투어, 실패 시 허프원)
+// pupil/radius는 eyeGray 좌표계
+bool findPupil(const cv::Mat& eyeGray, cv::Point& pupil, float& radius);
+
+// 이미 정규화 + 평활된 눈 ROI (FacePreprocessor::smooth 뷰)에서 시작. ROI별 blur/equalizeHist 생략
+bool findPupilPrepared(const cv::Mat& eyeSmooth, cv::Point& pupil, float& radius);
+
+// 대략 위치(CoarsePupil) 창 안에서만 findPupil / findPupilPrepared. pupil은 eye 좌표계
+bool findPupilCoarse(const cv::Mat& eye, bool prepared, cv::Point& pupil, float& radius);
@@ -0,0 +1,127 @@
+// TiledDetector.cpp
+#include "TiledDetector.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace cv;
+
+// 띠 경계에서 같은 얼굴이 두 번 잡힌 것 제거: 큰 박스 우선, 겹침이 크거나 거의 포함되면 버림
+static void mergeNms(std::vector<Rect>& boxes) {
+    std::sort(boxes.begin(), boxes.end(), [](const Rect& a, const Rect& b) { return a.area() > b.area(); });
+    std::vector<Rect> kept;
+    for (const Rect& b : boxes) {
+        bool dup = false;
+        for (const Rect& k : kept) {
+            double inter = (double)(b & k).area();
+            double iou = inter / ((double)b.area() + (double)k.area() - inter);
+            if (iou > 0.4 || inter > 0.7 * std::min(b.area(), k.area())) { dup = true; break; }
+        }
+        if (!dup) kept.push_back(b);
+    }
+    boxes.swap(kept);
+}
+
+std::unique_ptr<TiledDetector> TiledDetector::create(const std::string& name, const Factory& factory,
+    int threads, int maxFace)
+{
+    std::unique_ptr<TiledDetector> t(new TiledDetector(name, std::max(0, maxFace)));
+    threads = std::max(1, threads);
+    for (int i = 0; i < threads; ++i) {
+        std::unique_ptr<ObjectDetector> d = factory();
+        if (!d) return nullptr;
+        t->dets_.push_back(std::move(d));
+    }
+    for (int i = 1; i < threads; ++i)
+        t->workers_.emplace_back(&TiledDetector::workerLoop, t.get(), i);
+    return t;
+}
+
+TiledDetector::~TiledDetector()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        quit_ = true;
+    }
+    startCv_.notify_all();
+    for (std::thread& th : workers_) th.join();
+}
+
+void TiledDetector::runStripes(int idx)
+{
+    for (size_t i = next_++; i < stripes_.size(); i = next_++) {
+        dets_[idx]->detect(image_(stripes_[i]), found_[i]);
+        for (Rect& r : found_[i]) r.y += stripes_[i].y;   // 띠 좌표 -> 프레임 좌표
+    }
+}
+
+void TiledDetector::workerLoop(int idx)
+{
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            startCv_.wait(lk, [&] { return quit_ || generation_ != seen; });
+            if (quit_) return;
+            seen = generation_;
+        }
+        runStripes(idx);
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (--busy_ == 0) doneCv_.notify_one();
+        }
+    }
+}
+
+void TiledDetector::setSizeScale(double s)
+{
+    sizeScale_ = s;
+    for (auto& d : dets_) d->setSizeScale(s);
+}
+
+void TiledDetector::setMinScaleFactor(double f)
+{
+    minScaleFactor_ = f;
+    for (auto& d : dets_) d->setMinScaleFactor(f);
+}
+
+void TiledDetector::detect(const Mat& image, std::vector<Rect>& out)
+{
+    out.clear();
+    const int H = image.rows;
+    const int overlap = std::min(H, maxFace_ > 0 ? (int)(maxFace_ * sizeScale_) : H / 2);
+
+    // 띠 개수: 워커 수만큼. 단, 띠 고유 높이가 겹침의 절반보다 작아지면(중복 계산이 3배 넘게) 줄임
+    int n = (int)dets_.size();
+    n = std::min(n, std::max(1, (2 * H) / std::max(1, overlap)));
+    if (n <= 1 || overlap >= H) {
+        dets_[0]->detect(image, out);
+        return;
+    }
+
+    const int base = (H + n - 1) / n;
+    stripes_.clear();
+    for (int y = 0; y < H; y += base) {
+        int h = std::min(H - y, base + overlap);
+        stripes_.push_back(Rect(0, y, image.cols, h));
+        if (y + h >= H) break;
+    }
+    found_.assign(stripes_.size(), std::vector<Rect>());
+    image_ = image;
+    next_.store(0);
+
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        busy_ = (int)workers_.size();
+        ++generation_;
+    }
+    startCv_.notify_all();
+    runStripes(0);
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        doneCv_.wait(lk, [&] { return busy_ == 0; });
+    }
+    image_.release();
+
+    for (const std::vector<Rect>& f : found_) out.insert(out.end(), f.begin(), f.end());
+    mergeNms(out);
+}
@@ -0,0 +1,58 @@
+// TiledDetector.h
+// 프레임 한 장의 얼굴 검출을 가로 띠(stripe) 여러 개로 나눠 스레드 풀에서 병렬 실행
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ObjectDetector.h"
+
+/**
+ * @class TiledDetector
+ * @brief 그레이 프레임을 최대 얼굴 높이만큼 겹치는 가로 띠로 나눠 띠마다 안쪽 검출기를 돌리고,
+ * 결과를 프레임 좌표로 옮겨 NMS로 합칩니다. 겹침이 최대 얼굴 높이 이상이므로
+ * 그보다 작은 얼굴은 반드시 어느 한 띠 안에 통째로 들어갑니다.
+ * 워커(스레드)마다 안쪽 검출기 인스턴스를 따로 갖고, 띠는 원자 인덱스로 먼저 끝난 워커가 가져갑니다.
+ * 호출 스레드도 워커 0으로 참여합니다.
+ */
+class TiledDetector : public ObjectDetector {
+public:
+    using Factory = std::function<std::unique_ptr<ObjectDetector>()>;
+
+    // threads: 워커 수(호출 스레드 포함). maxFace: 찾을 최대 얼굴 높이 px (0이면 프레임 높이의 절반)
+    // 안쪽 검출기 생성이 하나라도 실패하면 nullptr
+    static std::unique_ptr<TiledDetector> create(const std::string& name, const Factory& factory,
+        int threads, int maxFace);
+    ~TiledDetector() override;
+
+    void detect(const cv::Mat& image, std::vector<cv::Rect>& out) override;
+    void setSizeScale(double s) override;
+    void setMinScaleFactor(double f) override;
+
+private:
+    TiledDetector(std::string name, int maxFace) : ObjectDetector(std::move(name)), maxFace_(maxFace) {}
+
+    void workerLoop(int idx);
+    void runStripes(int idx);   // 남은 띠가 없을 때까지 가져가서 처리
+
+    int maxFace_;
+    std::vector<std::unique_ptr<ObjectDetector>> dets_;   // dets_[i] = 워커 i 전용
+    std::vector<std::thread> workers_;                    // 워커 1..N-1
+
+    std::mutex mtx_;
+    std::condition_variable startCv_, doneCv_;
+    uint64_t generation_ = 0;   // detect() 호출마다 증가 -> 워커 깨움
+    int busy_ = 0;              // 이번 회차에 아직 안 끝난 워커 수
+    bool quit_ = false;
+
+    // 이번 회차 작업 (detect()가 채우고 워커는 읽기만, 결과는 띠별 슬롯에)
+    cv::Mat image_;
+    std::vector<cv::Rect> stripes_;
+    std::vector<std::vector<cv::Rect>> found_;
+    std::atomic<size_t> next_{ 0 };
+};
@@ -0,0 +1,250 @@
+// ZoneClassifier.cpp
+#include "ZoneClassifier.h"
+#include "gaze_protocol.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace cv;
+
+ZoneMap::ZoneMap(Rect2f bounds, int resolution)
+    : bounds_(bounds), res_(std::max(8, resolution)), index_(res_, res_, CV_16SC1, Scalar(-1))
+{
+    CV_Assert(bounds_.width > 0 && bounds_.height > 0);
+}
+
+int ZoneMap::addZone(const ZoneDef& z)
+{
+    if ((int)zones_.size() >= kMaxZones || indexOf(z.id) >= 0) return -1;
+    zones_.push_back(z);
+    built_ = false;
+    return (int)zones_.size() - 1;
+}
+
+int ZoneMap::indexOf(int32_t id) const
+{
+    for (size_t i = 0; i < zones_.size(); ++i)
+        if (zones_[i].id == id) return (int)i;
+    return -1;
+}
+
+bool ZoneMap::fillGrid(const std::vector<float>& xEdges, const std::vector<float>& yEdges, const std::vector<int32_t>& cellIds)
+{
+    const size_t nx = xEdges.size() + 1, ny = yEdges.size() + 1;
+    if (cellIds.size() != nx * ny || !std::is_sorted(xEdges.begin(), xEdges.end()) || !std::is_sorted(yEdges.begin(), yEdges.end()))
+        return false;
+
+    // 셀 중심이 어느 열/행인지 미리 계산
+    const float cw = bounds_.width / res_, ch = bounds_.height / res_;
+    std::vector<int> col(res_), row(res_);
+    for (int i = 0; i < res_; ++i) {
+        col[i] = (int)(std::upper_bound(xEdges.begin(), xEdges.end(), bounds_.x + (i + 0.5f) * cw) - xEdges.begin());
+        row[i] = (int)(std::upper_bound(yEdges.begin(), yEdges.end(), bounds_.y + (i + 0.5f) * ch) - yEdges.begin());
+    }
+    std::vector<short> idx(cellIds.size());
+    for (size_t i = 0; i < cellIds.size(); ++i) idx[i] = (short)indexOf(cellIds[i]);
+
+    for (int r = 0; r < res_; ++r) {
+        short* p = index_.ptr<short>(r);
+        for (int c = 0; c < res_; ++c) p[c] = idx[row[r] * nx + col[c]];
+    }
+    built_ = false;
+    return true;
+}
+
+bool ZoneMap::fillPolygon(int32_t id, const std::vector<Point2f>& pts)
+{
+    const int zi = indexOf(id);
+    if (zi < 0 || pts.size() < 3) return false;
+
+    // 시선 좌표 -> 래스터 좌표 (셀 중심 기준, 8비트 소수부)
+    const float kx = res_ / bounds_.width, ky = res_ / bounds_.height;
+    std::vector<Point> poly;
+    poly.reserve(pts.size());
+    for (const Point2f& p : pts)
+        poly.push_back(Point(cvRound(((p.x - bounds_.x) * kx - 0.5f) * 256.f), cvRound(((p.y - bounds_.y) * ky - 0.5f) * 256.f)));
+    fillPoly(index_, std::vector<std::vector<Point>>{ poly }, Scalar(zi), LINE_8, 8);
+    built_ = false;
+    return true;
+}
+
+void ZoneMap::build()
+{
+    hold_.assign((size_t)res_ * res_, 0);
+    const float cw = bounds_.width / res_, ch = bounds_.height / res_;
+    Mat mask;
+    for (int zi = 0; zi < (int)zones_.size(); ++zi) {
+        compare(index_, Scalar(zi), mask, CMP_EQ);
+        const int rx = (int)std::ceil(std::max(0.f, zones_[zi].hysteresis.x) / cw - 1e-3f);
+        const int ry = (int)std::ceil(std::max(0.f, zones_[zi].hysteresis.y) / ch - 1e-3f);
+        if (rx > 0 || ry > 0)
+            dilate(mask, mask, getStructuringElement(MORPH_RECT, Size(2 * rx + 1, 2 * ry + 1)));
+        const uint64_t bit = (uint64_t)1 << zi;
+        for (int r = 0; r < res_; ++r) {
+            const uchar* m = mask.ptr<uchar>(r);
+            uint64_t* h = &hold_[(size_t)r * res_];
+            for (int c = 0; c < res_; ++c) if (m[c]) h[c] |= bit;
+        }
+    }
+    built_ = true;
+}
+
+int ZoneMap::cellOf(float x, float y) const
+{
+    if (!std::isfinite(x) || !std::isfinite(y)) return -1;
+    int c = (int)std::floor((x - bounds_.x) * (res_ / bounds_.width));
+    int r = (int)std::floor((y - bounds_.y) * (res_ / bounds_.height));
+    c = std::clamp(c, 0, res_ - 1);
+    r = std::clamp(r, 0, res_ - 1);
+    return r * res_ + c;
+}
+
+int ZoneMap::indexAt(float x, float y) const
+{
+    const int cell = cellOf(x, y);
+    return cell < 0 ? -1 : index_.ptr<short>()[cell];
+}
+
+bool ZoneMap::holds(int index, float x, float y) const
+{
+    CV_DbgAssert(built_);
+    const int cell = cellOf(x, y);
+    return cell >= 0 && index >= 0 && ((hold_[cell] >> index) & 1);
+}
+
+bool ZoneMap::load(const std::string& path)
+{
+    try {
+        FileStorage fs(path, FileStorage::READ);
+        if (!fs.isOpened()) {
+            std::cerr << "Zone config open failed: " << path << "\n";
+            return false;
+        }
+        Rect2f bounds = bounds_;
+        int res = res_;
+        if (!fs["bounds"].empty()) {
+            std::vector<float> b; fs["bounds"] >> b;
+            if (b.size() == 4) bounds = Rect2f(b[0], b[1], b[2], b[3]);
+        }
+        if (!fs["resolution"].empty()) res = (int)fs["resolution"];
+        if (bounds.width <= 0 || bounds.height <= 0) {
+            std::cerr << "Zone config invalid bounds: " << path << "\n";
+            return false;
+        }
+        ZoneMap m(bounds, res);
+
+        // 영역 정의 먼저, 격자는 바탕, 다각형은 위에
+        struct Poly { int32_t id; std::vector<Point2f> pts; };
+        std::vector<Poly> polys;
+        FileNode list = fs["zones"];
+        for (FileNodeIterator it = list.begin(); it != list.end(); ++it) {
+            FileNode n = *it;
+            ZoneDef z;
+            z.id = (int)n["id"];
+            z.name = (std::string)n["name"];
+            FileNode h = n["hysteresis"];
+            if (h.isSeq() && h.size() == 2) z.hysteresis = Point2f((float)h[0], (float)h[1]);
+            else if (!h.empty()) z.hysteresis = Point2f((float)h, (float)h);
+            if (!n["dwell"].empty()) z.dwell = std::chrono::milliseconds((int)n["dwell"]);
+            if (m.addZone(z) < 0) {
+                std::cerr << "Zone config: skipping zone " << z.id << " (duplicate id or more than " << kMaxZones << " zones)\n";
+                continue;
+            }
+            if (!n["polygon"].empty()) {
+                std::vector<float> v; n["polygon"] >> v;
+                Poly p{ z.id, {} };
+                for (size_t i = 0; i + 1 < v.size(); i += 2) p.pts.push_back(Point2f(v[i], v[i + 1]));
+                polys.push_back(p);
+            }
+        }
+        FileNode g = fs["grid"];
+        if (!g.empty()) {
+            std::vector<float> xs, ys;
+            std::vector<int> cells;
+            g["x"] >> xs; g["y"] >> ys; g["cells"] >> cells;
+            if (!m.fillGrid(xs, ys, std::vector<int32_t>(cells.begin(), cells.end()))) {
+                std::cerr << "Zone config: grid needs sorted edges and (x+1)*(y+1) cells: " << path << "\n";
+                return false;
+            }
+        }
+        for (const Poly& p : polys) {
+            if (!m.fillPolygon(p.id, p.pts))
+                std::cerr << "Zone config: zone " << p.id << " polygon needs at least 3 points\n";
+        }
+        if (m.size() == 0) {
+            std::cerr << "Zone config has no zones: " << path << "\n";
+            return false;
+        }
+        m.build();
+        *this = std::move(m);
+    }
+    catch (const cv::Exception& e) {
+        std::cerr << "Zone config parse failed: " << path << " (" << e.what() << ")\n";
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<ZoneMap> ZoneMap::directions(float th, float hy, bool diagonal)
+{
+    // 기존 축별 규칙 (|v| >= th+hy 이면 옆으로, |v| < th 이면 중앙, 그 사이는 유지)
+    // = 경계 th+hy/2 + 양쪽 여유 hy/2
+    const float e = th + hy * 0.5f;
+    const Point2f h(hy * 0.5f, hy * 0.5f);
+    static const char* names[] = { "CENTER", "LEFT", "RIGHT", "UP", "DOWN",
+        "LEFT-UP", "LEFT-DOWN", "RIGHT-UP", "RIGHT-DOWN" };
+
+    std::shared_ptr<ZoneMap> m = std::make_shared<ZoneMap>();
+    const int32_t count = diagonal ? GAZE_DIR_RIGHT_DOWN + 1 : GAZE_DIR_DOWN + 1;
+    for (int32_t id = GAZE_DIR_CENTER; id < count; ++id) {
+        ZoneDef z;
+        z.id = id; z.name = names[id]; z.hysteresis = h;
+        m->addZone(z);
+    }
+    // 5방향이면 모서리는 상하 우선 (기존 판정 순서)
+    const std::vector<int32_t> cells = diagonal
+        ? std::vector<int32_t>{ GAZE_DIR_LEFT_UP, GAZE_DIR_UP, GAZE_DIR_RIGHT_UP,
+                                GAZE_DIR_LEFT, GAZE_DIR_CENTER, GAZE_DIR_RIGHT,
+                                GAZE_DIR_LEFT_DOWN, GAZE_DIR_DOWN, GAZE_DIR_RIGHT_DOWN }
+        : std::vector<int32_t>{ GAZE_DIR_UP, GAZE_DIR_UP, GAZE_DIR_UP,
+                                GAZE_DIR_LEFT, GAZE_DIR_CENTER, GAZE_DIR_RIGHT,
+                                GAZE_DIR_DOWN, GAZE_DIR_DOWN, GAZE_DIR_DOWN };
+    m->fillGrid({ -e, e }, { -e, e }, cells);
+    m->build();
+    return m;
+}
+
+ZoneClassifier::ZoneClassifier(std::shared_ptr<const ZoneMap> map)
+    : map_(std::move(map))
+{
+    CV_Assert(map_);
+}
+
+int ZoneClassifier::update(float x, float y, Clock::time_point t, ZoneEvent events[2])
+{
+    int cand = map_->indexAt(x, y);
+    if (cur_ >= 0 && map_->holds(cur_, x, y)) cand = cur_;
+    if (cand == cur_) { pending_ = kNoPending; return 0; }
+
+    // 후보가 바뀌면 체류 시간을 처음부터
+    if (cand != pending_) { pending_ = cand; pendingSince_ = t; }
+    if (cand >= 0 && t - pendingSince_ < map_->zone(cand).dwell) return 0;
+
+    int n = 0;
+    if (cur_ >= 0) events[n++] = ZoneEvent{ ZoneEventType::Exit, map_->zone(cur_).id, t };
+    if (cand >= 0) events[n++] = ZoneEvent{ ZoneEventType::Enter, map_->zone(cand).id, t };
+    cur_ = cand;
+    pending_ = kNoPending;
+    return n;
+}
+
+int32_t ZoneClassifier::current() const
+{
+    return cur_ < 0 ? kNone : map_->zone(cur_).id;
+}
+
+void ZoneClassifier::reset()
+{
+    cur_ = -1;
+    pending_ = kNoPending;
+}
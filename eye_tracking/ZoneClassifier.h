@@ -0,0 +1,113 @@
+// ZoneClassifier.h
+// 필터링된 시선 (x, y)를 격자/다각형 영역(zone)으로 분류 + 영역별 히스테리시스·체류 시간 + 진입/이탈 이벤트
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 영역 하나. id는 호출 측이 정하는 값 (방향 분류면 gaze_direction)
+struct ZoneDef {
+    int32_t id = 0;
+    std::string name;
+    cv::Point2f hysteresis;            // 축별 여유: 현재 영역이면 경계 밖으로 이만큼까지는 유지
+    std::chrono::milliseconds dwell{ 0 };   // 새 영역으로 바뀌려면 이 시간 이상 연속으로 머물러야 함
+};
+
+/**
+ * @class ZoneMap
+ * @brief 시선 평면의 영역 배치. 격자/다각형을 해상도 resolution의 격자 래스터로 미리 그려 두고,
+ * 영역별 히스테리시스 여유만큼 팽창한 "유지" 비트마스크를 셀마다 저장합니다.
+ * 그래서 샘플 하나의 분류는 영역 수·모양과 무관하게 셀 조회 두 번입니다.
+ * build() 이후에는 읽기 전용이라 여러 ZoneClassifier(얼굴마다 하나)가 같이 써도 됩니다.
+ */
+class ZoneMap {
+public:
+    static constexpr int kMaxZones = 64;   // 유지 마스크 = uint64_t 비트
+
+    // bounds 밖의 샘플은 가장자리 셀로 처리
+    explicit ZoneMap(cv::Rect2f bounds = cv::Rect2f(-1.5f, -1.5f, 3.f, 3.f), int resolution = 256);
+
+    // 영역 추가 -> 인덱스. id 중복이거나 kMaxZones 초과면 -1
+    int addZone(const ZoneDef& z);
+
+    // N×M 격자: xEdges/yEdges = 안쪽 경계(오름차순), cellIds = 행 우선 (yEdges.size()+1) × (xEdges.size()+1) 개의 영역 id
+    // 여러 셀이 같은 id를 가져도 됨 (예: 5방향의 모서리 셀 = UP/DOWN). 없는 id(-1 등)인 셀은 영역 없음
+    bool fillGrid(const std::vector<float>& xEdges, const std::vector<float>& yEdges, const std::vector<int32_t>& cellIds);
+
+    // 다각형 (시선 좌표). 나중에 그린 것이 위에 덮임
+    bool fillPolygon(int32_t id, const std::vector<cv::Point2f>& pts);
+
+    // 유지 마스크 계산. 영역/모양을 바꾼 뒤 분류 전에 한 번
+    void build();
+
+    // cv::FileStorage 설정 (zones 목록 + grid/polygon). 실패 시 false + stderr
+    bool load(const std::string& path);
+
+    // main_LRUD 기존 동작: 축별 임계값 th, 히스테리시스 hy. diagonal이면 9방향, 아니면 5방향(상하 우선)
+    static std::shared_ptr<ZoneMap> directions(float th, float hy, bool diagonal);
+
+    // 셀 조회 (상수 시간)
+    int indexAt(float x, float y) const;                // 영역 인덱스, 없으면 -1
+    bool holds(int index, float x, float y) const;      // index 영역의 유지 범위 안인지
+
+    int size() const { return (int)zones_.size(); }
+    const ZoneDef& zone(int index) const { return zones_[index]; }
+    int indexOf(int32_t id) const;
+    const cv::Rect2f& bounds() const { return bounds_; }
+
+private:
+    int cellOf(float x, float y) const;   // 래스터 셀 번호, NaN이면 -1
+
+    cv::Rect2f bounds_;
+    int res_;
+    std::vector<ZoneDef> zones_;
+    cv::Mat index_;                   // CV_16S, 셀 -> 영역 인덱스 (-1 = 없음)
+    std::vector<uint64_t> hold_;      // 셀 -> 유지 비트마스크
+    bool built_ = false;
+};
+
+enum class ZoneEventType : uint8_t { Enter, Exit };
+
+struct ZoneEvent {
+    ZoneEventType type;
+    int32_t id;                                   // 영역 id
+    std::chrono::steady_clock::time_point t;      // 바뀐 샘플의 캡처 시각
+};
+
+/**
+ * @class ZoneClassifier
+ * @brief ZoneMap 위에서 시선 샘플 하나씩 받아 현재 영역을 정합니다.
+ * 현재 영역의 유지 범위 안이면 그대로, 밖이면 새 영역이 그 영역의 체류 시간 이상 이어질 때 바뀝니다.
+ * 상태는 인스턴스마다 따로라 얼굴(사용자)마다 하나씩 만들면 됩니다. 샘플당 상수 시간, 할당 없음.
+ */
+class ZoneClassifier {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int32_t kNone = -1;   // 어느 영역도 아님
+
+    explicit ZoneClassifier(std::shared_ptr<const ZoneMap> map);
+
+    /**
+     * @brief 샘플 하나를 반영합니다.
+     * @param events 영역이 바뀌면 [이전 영역 Exit, 새 영역 Enter] 순으로 채웁니다 (최대 2개).
+     * @return 채운 이벤트 수
+     */
+    int update(float x, float y, Clock::time_point t, ZoneEvent events[2]);
+
+    int32_t current() const;    // 현재 영역 id, 없으면 kNone
+    const ZoneDef* currentZone() const { return cur_ < 0 ? nullptr : &map_->zone(cur_); }
+
+    // 영역 없음 상태로 (이벤트 없이)
+    void reset();
+
+private:
+    static constexpr int kNoPending = -2;
+
+    std::shared_ptr<const ZoneMap> map_;
+    int cur_ = -1;                      // 현재 영역 인덱스
+    int pending_ = kNoPending;          // 바뀔 후보 영역 인덱스 (-1 = 영역 없음으로 바뀌는 중)
+    Clock::time_point pendingSince_;    // 후보가 처음 나온 캡처 시각
+};
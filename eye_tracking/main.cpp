@@ -1,6 +1,13 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <string>
 #include "BlinkDetector.h"
+#include "DetectorProfile.h"
+#include "FacePreprocessor.h"
+#include "PipelineClock.h"
+#include "PupilFinder.h"
 using namespace cv;
 using std::cout; using std::endl;
 
@@ -8,47 +15,13 @@ static Point2f emaPoint(const Point2f& prev, const Point2f& cur, float alpha = 0
     return prev * (1.0f - alpha) + cur * alpha;
 }
 
-static bool findPupil(const Mat& eyeGray, Point& pupil, float& radius)
+// 사용법: main [--profile 검출프로파일.yml]
+int main(int argc, char** argv)
 {
-    // 1) ��ó��
-    Mat blurImg; GaussianBlur(eyeGray, blurImg, Size(7, 7), 0);
-    // ����Ǯ/���̶���Ʈ ���Ÿ� ���� ���� �� ����
-    Mat eq; equalizeHist(blurImg, eq);
-    // 2) ������ ��ο�: Otsu + ����
-    Mat bin;
-    threshold(eq, bin, 0, 255, THRESH_BINARY_INV | THRESH_OTSU);
-
-    // 3) ���� �������� ��Ƽ ����
-    morphologyEx(bin, bin, MORPH_OPEN, getStructuringElement(MORPH_ELLIPSE, Size(3, 3)));
-
-    // 4) ū ������ �߽��� �ĺ���
-    std::vector<std::vector<Point>> contours;
-    findContours(bin, contours, RETR_EXTERNAL, CHAIN_APPROX_SIMPLE);
-    if (contours.empty()) {
-        // �����ϸ� ������ �õ�
-        std::vector<Vec3f> circles;
-        HoughCircles(blurImg, circles, HOUGH_GRADIENT, 1, eyeGray.rows / 8, 200, 15, eyeGray.rows / 16, eyeGray.rows / 3);
-        if (circles.empty()) return false;
-        Vec3f c = circles[0];
-        pupil = Point(cvRound(c[0]), cvRound(c[1]));
-        radius = c[2];
-        return true;
-    }
-    // ���� ū ������ ����
-    size_t idxMax = 0; double maxA = 0;
-    for (size_t i = 0; i < contours.size(); ++i) {
-        double a = contourArea(contours[i]);
-        if (a > maxA) { maxA = a; idxMax = i; }
-    }
-    Point2f c; float r;
-    minEnclosingCircle(contours[idxMax], c, r);
-    pupil = Point(cvRound(c.x), cvRound(c.y));
-    radius = r;
-    return true;
-}
+    DetectorProfile profile;
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--profile" && i + 1 < argc && !profile.load(argv[++i])) return -1;
 
-int main()
-{
     // 0) �з��� �ε� (OpenCV ��ġ ����� haarcascade ���� ��θ� �����ּ���)
     // ��: Linux: /usr/share/opencv4/haarcascades/..., Windows: <opencv>/build/etc/haarcascades/...
     std::string face_cascade_path = "haarcascade_frontalface_default.xml";
@@ -69,12 +42,19 @@ int main()
     cap.set(CAP_PROP_FRAME_HEIGHT, 720);
 
     // ���� ���� ������ ���� ��ü ����, �Ķ���ʹ� ������ ��
-    BlinkDetector left_eye_detector(5);
-    BlinkDetector right_eye_detector(5);
+    // 5프레임@30fps 와 같은 시간 (프레임 수가 아니라 캡처 시각 기준)
+    BlinkDetector left_eye_detector(std::chrono::milliseconds(167));
+    BlinkDetector right_eye_detector(std::chrono::milliseconds(167));
 
     Point2f emaLeft(-1, -1), emaRight(-1, -1); // EMA �ʱ�ȭ
+    const float EMA_TAU_S = tauFromAlpha(0.2f, 30.f);   // 30fps에서 α=0.2와 같은 시정수
+    BlinkDetector::Clock::time_point tLeft, tRight; // 눈별 마지막 EMA 갱신 캡처 시각
+    FacePreprocessor facePre;   // 위쪽 얼굴 equalizeHist + 평활은 프레임당 한 번
     while (true) {
-        Mat frame; cap >> frame;
+        // grab 직후 시각을 이 프레임의 캡처 시각으로 사용
+        if (!cap.grab()) break;
+        const auto t = BlinkDetector::Clock::now();
+        Mat frame; cap.retrieve(frame);
         if (frame.empty()) break;
 
         // === �¿� ����(�ſ� ���) ===
@@ -84,17 +64,18 @@ int main()
 
         // 1) �� ����
         std::vector<Rect> faces;
-        faceCasc.detectMultiScale(gray, faces, 1.1, 3, 0, Size(120, 120));
+        profile.face.detect(faceCasc, gray, faces);
         for (const Rect& f : faces) {
             rectangle(frame, f, Scalar(0, 255, 0), 2);
 
             // 2) �� ROI���� �� ���� (��ݺ� �켱)
-            Rect upperFace = Rect(f.x, f.y, f.width, (int)std::round(f.height * 0.6));
+            Rect upperFace = Rect(f.x, f.y, f.width, (int)std::round(f.height * kUpperFaceRatio));
             upperFace &= Rect(0, 0, frame.cols, frame.rows);
-            Mat faceROI = gray(upperFace);
+            facePre.compute(gray, upperFace);
+            Mat faceROI = facePre.norm();
 
             std::vector<Rect> eyes;
-            eyeCasc.detectMultiScale(faceROI, eyes, 1.1, 2, 0, Size(30, 30));
+            profile.eye.detect(eyeCasc, faceROI, eyes);
 
             // �� �߾� x (������ ��ǥ��)
             const float faceCenterX = f.x + f.width * 0.5f;
@@ -111,11 +92,13 @@ int main()
                 Rect eyeRect(eInFace.x + upperFace.x, eInFace.y + upperFace.y, eInFace.width, eInFace.height);
                 rectangle(frame, eyeRect, Scalar(255, 200, 0), 2);
 
-                Mat eyeGray = gray(eyeRect).clone();
+                eyeRect = facePre.clip(eyeRect);
+                Mat eyeSmooth = facePre.smooth(eyeRect);
+                if (eyeSmooth.empty()) continue;
 
                 // 3) ���� ã��
                 Point pupil; float r = 0;
-                bool ok = findPupil(eyeGray, pupil, r);
+                bool ok = findPupilCoarse(eyeSmooth, true, pupil, r);
 
                 // �� �߽� x
                 float eyeCenterX = eyeRect.x + eyeRect.width * 0.5f;
@@ -148,20 +131,24 @@ int main()
             // 4) ��鸲 ����(EMA) + �� ���� ���
             if (foundL) {
                 if (emaLeft.x < -0.5f) emaLeft = normL;
-                else                   emaLeft = emaPoint(emaLeft, normL, 0.2f);
+                else                   emaLeft = emaPoint(emaLeft, normL,
+                    emaAlpha(std::chrono::duration<float>(t - tLeft).count(), EMA_TAU_S));
+                tLeft = t;
                 putText(frame, cv::format("L(%.2f, %.2f)", emaLeft.x, emaLeft.y),
                     Point(eyeRectL.x, eyeRectL.y - 8), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(0, 255, 255), 1);
             }
             if (foundR) {
                 if (emaRight.x < -0.5f) emaRight = normR;
-                else                    emaRight = emaPoint(emaRight, normR, 0.2f);
+                else                    emaRight = emaPoint(emaRight, normR,
+                    emaAlpha(std::chrono::duration<float>(t - tRight).count(), EMA_TAU_S));
+                tRight = t;
                 putText(frame, cv::format("R(%.2f, %.2f)", emaRight.x, emaRight.y),
                     Point(eyeRectR.x, eyeRectR.y - 8), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(0, 255, 255), 1);
             }
             
             if (eyes.size() == 1) {
                 if (!isLeftSide) { // ���� �� ����� ó��
-                    left_eye_detector.checkBlink(false); // 'ok' ����(true/false)�� ���� ����
+                    left_eye_detector.checkBlink(false, t); // 'ok' ����(true/false)�� ���� ����
                     if (left_eye_detector.isBlinking()) {
                         std::cout << "LEFT CLICK!" << std::endl;
                         putText(frame, "LEFT CLICK!", Point(50, 80), FONT_HERSHEY_SIMPLEX, 1, Scalar(0, 255, 0), 2);
@@ -169,7 +156,7 @@ int main()
                     }
                 }
                 else { // ������ �� ����� ó��
-                    right_eye_detector.checkBlink(false); // 'ok' ����(true/false)�� ���� ����
+                    right_eye_detector.checkBlink(false, t); // 'ok' ����(true/false)�� ���� ����
                     if (right_eye_detector.isBlinking()) {
                         std::cout << "RIGHT CLICK!" << std::endl;
                         putText(frame, "RIGHT CLICK!", Point(50, 120), FONT_HERSHEY_SIMPLEX, 1, Scalar(0, 0, 255), 2);
@@ -178,8 +165,8 @@ int main()
                 }
             }
             else {
-                left_eye_detector.checkBlink(true);
-                right_eye_detector.checkBlink(true);
+                left_eye_detector.checkBlink(true, t);
+                right_eye_detector.checkBlink(true, t);
             }
         }
 
@@ -1,39 +1,29 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "GazePublisher.h"
+#include "BinocularFusion.h"
+#include "Calib.h"
+#include "DetectorProfile.h"
+#include "DetectorRegistry.h"
+#include "FacePreprocessor.h"
+#include "PipelineClock.h"
+#include "ZoneClassifier.h"
 using namespace cv;
 using std::cout; using std::endl;
 
-struct Calib1D {
-    bool hasC = false, hasN = false, hasP = false; // C=Center, N=Negative(L/Up), P=Positive(R/Down)
-    float C = 0.f, N = 0.f, P = 0.f;
-    float map(float x) const {
-        if (!(hasC && hasN && hasP)) return x;
-        if (x <= C) {
-            float d = std::max(1e-4f, C - N);
-            return std::clamp((x - C) / d, -1.5f, 0.f);
-        }
-        else {
-            float d = std::max(1e-4f, P - C);
-            return std::clamp((x - C) / d, 0.f, 1.5f);
-        }
-    }
-    bool ready() const { return hasC && hasN && hasP && N < C && C < P; }
-};
-
-struct Calib2D {
-    Calib1D X, Y; // X: Left(-)/Right(+), Y: Up(-)/Down(+)
-    bool ready() const { return X.ready() && Y.ready(); }
-};
-
 static float ema1(float prev, float cur, float a) { return prev * (1.f - a) + cur * a; }
 
 // 어두운 질량 중심으로 동공 중심 (cx, cy) 추정 → (nx, ny) 정규화 반환
+// eyeGray: 얼굴 단위로 평활 + equalizeHist 된 눈 ROI (FacePreprocessor::smooth)
 static bool darkCentroidNorm(const Mat& eyeGray, float& nx, float& ny) {
     CV_Assert(eyeGray.type() == CV_8UC1);
-    Mat blur; GaussianBlur(eyeGray, blur, Size(7, 7), 0);
-    Mat eq; equalizeHist(blur, eq);
-    Mat inv; bitwise_not(eq, inv);
+    Mat inv; bitwise_not(eyeGray, inv);
     Scalar m, s; meanStdDev(inv, m, s);
     double t = m[0] + 0.6 * s[0];
     Mat w; threshold(inv, w, t, 255, THRESH_TOZERO);
@@ -55,13 +45,77 @@ static bool darkCentroidNorm(const Mat& eyeGray, float& nx, float& ny) {
     return true;
 }
 
-int main() {
-    std::string faceXml = "haarcascade_frontalface_default.xml";
-    std::string eyeXml = "haarcascade_eye_tree_eyeglasses.xml";
-    CascadeClassifier faceC, eyeC;
-    if (!faceC.load(faceXml) || !eyeC.load(eyeXml)) {
-        std::cerr << "Load cascade failed. Check paths.\n"; return -1;
+// 방향 코드 -> 화면 표시 이름 (영역 이름, 검출 실패 상태)
+static const char* directionName(const ZoneMap& zones, int32_t code) {
+    if (code == GAZE_DIR_SEARCHING) return "SEARCHING";
+    if (code == GAZE_DIR_NO_FACE) return "NO FACE";
+    if (code == GAZE_DIR_NONE) return "NONE";
+    int i = zones.indexOf(code);
+    return i < 0 ? "-" : zones.zone(i).name.c_str();
+}
+
+static Scalar directionColor(int32_t code) {
+    switch (code) {
+    case GAZE_DIR_LEFT: return Scalar(0, 200, 255);
+    case GAZE_DIR_RIGHT: return Scalar(0, 255, 0);
+    case GAZE_DIR_UP: return Scalar(255, 200, 0);
+    case GAZE_DIR_DOWN: return Scalar(200, 0, 255);
+    default: return Scalar(255, 255, 255);
     }
+}
+
+// --zones 모드 HUD: 영역 래스터를 size x size 지도로 (영역마다 다른 색, 영역 없음은 어둡게, 이름은 영역 무게중심에)
+// 영역 배치는 실행 중 안 바뀌므로 시작할 때 한 번만 그림
+static Mat renderZoneMap(const ZoneMap& zones, int size) {
+    const Rect2f& b = zones.bounds();
+    Mat hsv(size, size, CV_8UC3);
+    std::vector<Point2d> sum(zones.size());
+    std::vector<int> count(zones.size(), 0);
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x) {
+            const int i = zones.indexAt(b.x + (x + 0.5f) * b.width / size, b.y + (y + 0.5f) * b.height / size);
+            hsv.at<Vec3b>(y, x) = i < 0 ? Vec3b(0, 0, 40) : Vec3b((uchar)(i * 47 % 180), 150, 150);
+            if (i >= 0) { sum[i] += Point2d(x, y); ++count[i]; }
+        }
+    Mat map; cvtColor(hsv, map, COLOR_HSV2BGR);
+    for (int i = 0; i < zones.size(); ++i) {
+        if (!count[i]) continue;
+        const Point c(cvRound(sum[i].x / count[i]) - 12, cvRound(sum[i].y / count[i]) + 4);
+        putText(map, zones.zone(i).name, c, FONT_HERSHEY_SIMPLEX, 0.35, Scalar(255, 255, 255), 1);
+    }
+    return map;
+}
+
+// 사용법: main_LRUD [--stream [소켓경로]] [--profile 검출프로파일.yml] [--detectors 검출기설정.yml] [--zones 영역설정.yml]
+int main(int argc, char** argv) {
+    bool streamOn = false;
+    std::string streamPath = GAZE_STREAM_DEFAULT_PATH;
+    DetectorProfile profile;
+    DetectorRegistry registry;
+    std::string zonesPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--stream") {
+            streamOn = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') streamPath = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--profile" && i + 1 < argc) {
+            if (!profile.load(argv[++i])) return -1;
+        }
+        else if (std::string(argv[i]) == "--detectors" && i + 1 < argc) {
+            if (!registry.load(argv[++i])) return -1;
+        }
+        else if (std::string(argv[i]) == "--zones" && i + 1 < argc) {
+            zonesPath = argv[++i];
+        }
+    }
+    GazePublisher publisher(streamPath);
+    if (streamOn && !publisher.start()) return -1;
+    int32_t lastDir = INT32_MIN;   // 아직 방향 이벤트를 안 보냄
+
+    // 검출기 (F 키로 얼굴 검출기 순환)
+    std::shared_ptr<ObjectDetector> faceDet = registry.create(registry.faceName(), profile);
+    std::shared_ptr<ObjectDetector> eyeDet = registry.create(registry.eyeName(), profile);
+    if (!faceDet || !eyeDet) return -1;
 
     VideoCapture cap(0);
     if (!cap.isOpened()) { std::cerr << "Camera open failed\n"; return -1; }
@@ -75,54 +129,72 @@ int main() {
 
     // EMA
     float emaX = 0.f, emaY = 0.f;
-    const float EMA_A = 0.25f;
-
-    // 임계값 & 히스테리시스 (축별)
+    const float EMA_TAU_S = tauFromAlpha(0.25f, 30.f);  // 30fps에서 α=0.25와 같은 시정수
+    std::chrono::steady_clock::time_point emaT;  // 마지막 EMA 갱신 캡처 시각
+    bool emaInit = false;
+    BinocularFusion fusion;
+    FacePreprocessor facePre;   // 위쪽 얼굴 정규화는 프레임당 한 번, 눈 검출/동공 추정은 뷰로
+    std::chrono::steady_clock::time_point fusionT;
+
+    // 임계값 & 히스테리시스 (축별). 영역 설정 파일이 없으면 이 값으로 5/9방향 격자
     float thX = 0.35f, thY = 0.35f;
-    float hyX = 0.06f, hyY = 0.06f;
+    const float HY = 0.06f;
+
+    std::shared_ptr<ZoneMap> zones = ZoneMap::directions(thX, HY, USE_DIAGONAL);
+    if (!zonesPath.empty()) {
+        zones = std::make_shared<ZoneMap>();
+        if (!zones->load(zonesPath)) return -1;
+    }
+    ZoneClassifier classifier(zones);
+    ZoneEvent events[2];
+    // 설정 파일 영역이면 축별 임계값 바 대신 영역 지도 HUD
+    const int ZONE_HUD = 180;
+    const Mat zoneHud = zonesPath.empty() ? Mat() : renderZoneMap(*zones, ZONE_HUD);
 
-    std::string label = "CENTER";
+    int32_t dir = GAZE_DIR_CENTER;
 
     while (true) {
-        Mat frame; cap >> frame; if (frame.empty()) break;
+        // grab 직후 시각을 이 프레임의 캡처 시각으로 사용
+        if (!cap.grab()) break;
+        const auto t = std::chrono::steady_clock::now();
+        Mat frame; cap.retrieve(frame); if (frame.empty()) break;
         flip(frame, frame, 1);
         Mat gray; cvtColor(frame, gray, COLOR_BGR2GRAY);
 
         bool got = false;
-        float nxMean = 0.f, nyMean = 0.f;
-        int used = 0;
+        // 눈별 관측 (얼굴 중심 기준 왼쪽/오른쪽)
+        bool lOk = false, rOk = false;
+        Point2f lEye, rEye;
 
         // 얼굴
         std::vector<Rect> faces;
-        faceC.detectMultiScale(gray, faces, 1.1, 3, 0, Size(120, 120));
+        faceDet->detect(gray, faces);
         if (!faces.empty()) {
             Rect f = *std::max_element(faces.begin(), faces.end(),
                 [](const Rect& a, const Rect& b) {return a.area() < b.area(); });
             rectangle(frame, f, Scalar(0, 255, 0), 2);
 
-            Rect top(f.x, f.y, f.width, (int)(f.height * 0.6));
+            Rect top = upperFaceRect(f);
             top &= Rect(0, 0, frame.cols, frame.rows);
-            Mat faceROI = gray(top);
+            facePre.compute(gray, top);
+            Mat faceROI = facePre.norm();
 
             std::vector<Rect> eyes;
-            eyeC.detectMultiScale(faceROI, eyes, 1.1, 2, 0, Size(28, 28), Size(220, 220));
+            eyeDet->detect(faceROI, eyes);
             std::sort(eyes.begin(), eyes.end(), [](const Rect& a, const Rect& b) {return a.x < b.x; });
 
             for (size_t i = 0; i < eyes.size() && i < 2; i++) {
-                Rect e = eyes[i];
                 // ROI 강축소(상하도 중요하므로 위쪽을 좀 더 자름)
-                int sx = (int)(e.width * 0.14);
-                int sy = (int)(e.height * 0.38);
-                Rect et(e.x + sx, e.y + sy, e.width - 2 * sx, e.height - 2 * sy);
+                Rect et = eyeCropRect(eyes[i]);
                 et &= Rect(0, 0, faceROI.cols, faceROI.rows);
                 if (et.width < 12 || et.height < 12) continue;
 
                 Rect er(et.x + top.x, et.y + top.y, et.width, et.height);
                 rectangle(frame, er, Scalar(255, 200, 0), 1);
 
-                Mat eyeGray = gray(er);
+                Mat eyeGray = facePre.smooth(er);
                 float nx, ny;
-                if (!darkCentroidNorm(eyeGray, nx, ny)) continue;
+                if (eyeGray.rows < 5 || eyeGray.cols < 5 || !darkCentroidNorm(eyeGray, nx, ny)) continue;
 
                 // 시각화: x, y 위치
                 int cx = er.x + er.width / 2 + (int)(nx * (er.width * 0.5f));
@@ -130,67 +202,56 @@ int main() {
                 line(frame, Point(cx, er.y), Point(cx, er.y + er.height), Scalar(0, 0, 255), 2);
                 line(frame, Point(er.x, cy), Point(er.x + er.width, cy), Scalar(0, 255, 0), 2);
 
-                nxMean += nx; nyMean += ny; used++;
+                if (er.x + er.width * 0.5f < f.x + f.width * 0.5f) { lOk = true; lEye = Point2f(nx, ny); }
+                else { rOk = true; rEye = Point2f(nx, ny); }
                 if (showDbg) {
                     putText(frame, cv::format("nx=%.2f ny=%.2f", nx, ny),
                         Point(er.x, er.y - 6), FONT_HERSHEY_SIMPLEX, 0.5, Scalar(0, 255, 255), 1);
                 }
             }
 
-            if (used > 0) {
-                nxMean /= used; nyMean /= used;
+            // 양눈 융합 (한쪽 눈만 보여도 눈 사이 오프셋을 보정해서 값이 튀지 않음)
+            Point2f mid;
+            const float fdt = fusion.ready() ? std::chrono::duration<float>(t - fusionT).count() : 0.f;
+            if (fusion.fuse(lOk, lEye, 1.f, rOk, rEye, 1.f, fdt, mid)) {
+                fusionT = t;
+                const float nxMean = mid.x, nyMean = mid.y;
 
                 // 캘리브레이션 맵 적용
                 float ax = calib.X.map(nxMean);
                 float ay = calib.Y.map(nyMean);
 
                 // EMA
-                emaX = ema1(emaX, ax, EMA_A);
-                emaY = ema1(emaY, ay, EMA_A);
-
-                // 분류 (히스테리시스)
-                auto decideAxis = [](float v, float th, float hy) {
-                    // 음수: N(Left/Up), 양수: P(Right/Down), 중앙: C
-                    float N = -(th + hy);
-                    float P = (th + hy);
-                    if (v <= N) return -1;        // Negative side
-                    if (v >= P) return +1;        // Positive side
-                    if (std::abs(v) < th) return 0; // 확실한 중앙
-                    return 2; // 그 외 구간은 이전 상태 유지용
-                    };
-
-                static int lastX = 0, lastY = 0; // -1,0,+1
-                int cxState = decideAxis(emaX, thX, hyX);
-                int cyState = decideAxis(emaY, thY, hyY);
-
-                if (cxState != 2) lastX = cxState;
-                if (cyState != 2) lastY = cyState;
-
-                // 레이블 결정(기본: 대각선 OFF)
-                if (!USE_DIAGONAL) {
-                    if (lastY == -1)      label = "UP";
-                    else if (lastY == +1) label = "DOWN";
-                    else if (lastX == -1) label = "LEFT";
-                    else if (lastX == +1) label = "RIGHT";
-                    else                  label = "CENTER";
-                }
-                else {
-                    // 대각선 포함
-                    if (lastX == 0 && lastY == 0) label = "CENTER";
-                    else if (lastX == -1 && lastY == 0) label = "LEFT";
-                    else if (lastX == +1 && lastY == 0) label = "RIGHT";
-                    else if (lastX == 0 && lastY == -1) label = "UP";
-                    else if (lastX == 0 && lastY == +1) label = "DOWN";
-                    else if (lastX == -1 && lastY == -1) label = "LEFT-UP";
-                    else if (lastX == -1 && lastY == +1) label = "LEFT-DOWN";
-                    else if (lastX == +1 && lastY == -1) label = "RIGHT-UP";
-                    else if (lastX == +1 && lastY == +1) label = "RIGHT-DOWN";
+                float dt = emaInit ? std::chrono::duration<float>(t - emaT).count() : 1.f / 30.f;
+                float a = emaAlpha(dt, EMA_TAU_S);
+                emaX = ema1(emaX, ax, a);
+                emaY = ema1(emaY, ay, a);
+                emaT = t; emaInit = true;
+
+                // 분류 (영역별 히스테리시스/체류 시간). 이벤트는 [Exit, Enter] 순이라 Exit만 오면 영역 없음
+                // (--zones 설정에 영역이 없는 셀로 나감 -> 직전 방향을 계속 보여주지 않고 NONE 표시/발행)
+                int n = classifier.update(emaX, emaY, t, events);
+                for (int e = 0; e < n; ++e)
+                    dir = events[e].type == ZoneEventType::Enter ? events[e].id : GAZE_DIR_NONE;
+                if (dir == GAZE_DIR_SEARCHING || dir == GAZE_DIR_NO_FACE) {
+                    dir = classifier.current() == ZoneClassifier::kNone ? GAZE_DIR_NONE : classifier.current();
                 }
 
                 got = true;
 
-                // 디버그 HUD 바 2개
-                if (showDbg) {
+                // 디버그 HUD: 영역 지도 + 현재 시선 점 (--zones)
+                if (showDbg && !zoneHud.empty() && frame.cols > ZONE_HUD + 40 && frame.rows > ZONE_HUD + 40) {
+                    const Rect hud(20, frame.rows - ZONE_HUD - 20, ZONE_HUD, ZONE_HUD);
+                    zoneHud.copyTo(frame(hud));
+                    rectangle(frame, hud, Scalar(200, 200, 200), 1);
+                    const Rect2f& zb = zones->bounds();
+                    Point p(hud.x + (int)((emaX - zb.x) / zb.width * ZONE_HUD), hud.y + (int)((emaY - zb.y) / zb.height * ZONE_HUD));
+                    p.x = std::clamp(p.x, hud.x, hud.x + ZONE_HUD - 1);
+                    p.y = std::clamp(p.y, hud.y, hud.y + ZONE_HUD - 1);
+                    circle(frame, p, 5, Scalar(0, 255, 0), FILLED);
+                }
+                // 디버그 HUD 바 2개 (기본 5/9방향: 축별 임계값)
+                else if (showDbg && zoneHud.empty()) {
                     // X bar
                     int barW = std::min(800, frame.cols - 40);
                     int x0 = 20, y0 = frame.rows - 50;
@@ -220,19 +281,32 @@ int main() {
                 }
             }
             else {
-                label = "SEARCHING";
+                dir = GAZE_DIR_SEARCHING;
             }
         }
         else {
-            label = "NO FACE";
+            dir = GAZE_DIR_NO_FACE;
+        }
+
+        // 스트림: 프레임별 샘플 + 라벨이 바뀔 때 방향 이벤트
+        if (streamOn) {
+            gaze_record r = makeGazeRecord(GAZE_REC_SAMPLE, t);
+            r.flags = got ? GAZE_FLAG_VALID : 0;
+            r.x = emaX; r.y = emaY;
+            r.code = dir;
+            publisher.publish(r);
+            if (r.code != lastDir) {
+                gaze_record d = makeGazeRecord(GAZE_REC_DIRECTION, t);
+                d.x = emaX; d.y = emaY;
+                d.code = r.code;
+                publisher.publish(d);
+                lastDir = r.code;
+            }
         }
 
         // 라벨 출력
-        putText(frame, label, Point(30, 100), FONT_HERSHEY_SIMPLEX, 2.0,
-            label == "LEFT" ? Scalar(0, 200, 255) :
-            label == "RIGHT" ? Scalar(0, 255, 0) :
-            label == "UP" ? Scalar(255, 200, 0) :
-            label == "DOWN" ? Scalar(200, 0, 255) : Scalar(255, 255, 255), 6, LINE_AA);
+        putText(frame, directionName(*zones, dir), Point(30, 100), FONT_HERSHEY_SIMPLEX, 2.0,
+            directionColor(dir), 6, LINE_AA);
 
         // 안내
         putText(frame, "1:CENTER  2:LEFT  3:RIGHT  4:UP  5:DOWN  V:debug  Q:quit",
@@ -249,6 +323,13 @@ int main() {
         int k = waitKey(1);
         if (k == 'q' || k == 27) break;
         if (k == 'v' || k == 'V') showDbg = !showDbg;
+        if (k == 'f' || k == 'F') {
+            std::string next = registry.next(faceDet->name());
+            if (next != faceDet->name()) {
+                std::shared_ptr<ObjectDetector> d = registry.create(next, profile);
+                if (d) { faceDet = d; cout << "[Detector] face=" << next << endl; }
+            }
+        }
 
         // === 5점 캘리브레이션 ===
         if (k == '1') { calib.X.C = emaX; calib.Y.C = emaY; calib.X.hasC = true; calib.Y.hasC = true; }
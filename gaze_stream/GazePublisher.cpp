@@ -0,0 +1,174 @@
+// GazePublisher.cpp
+#include "GazePublisher.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "ws2_32.lib")
+#define GZ_POLL WSAPoll
+typedef WSAPOLLFD gz_pollfd;
+static void closeSock(intptr_t fd) { closesocket((SOCKET)fd); }
+static bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+static void setNonBlocking(intptr_t fd) { u_long on = 1; ioctlsocket((SOCKET)fd, FIONBIO, &on); }
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define GZ_POLL poll
+typedef struct pollfd gz_pollfd;
+static void closeSock(intptr_t fd) { close((int)fd); }
+static bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+static void setNonBlocking(intptr_t fd) { fcntl((int)fd, F_SETFL, fcntl((int)fd, F_GETFL, 0) | O_NONBLOCK); }
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+GazePublisher::GazePublisher(std::string path, std::chrono::milliseconds batchInterval, size_t maxPendingBytes)
+    : path_(std::move(path)), batchInterval_(batchInterval), maxPendingBytes_(maxPendingBytes),
+    ring_(kQueueCap)
+{
+}
+
+GazePublisher::~GazePublisher()
+{
+    stop();
+}
+
+bool GazePublisher::start()
+{
+    if (running_.load()) return true;
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) { std::cerr << "[GazePublisher] WSAStartup failed\n"; return false; }
+#endif
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path_.size() >= sizeof(addr.sun_path)) { std::cerr << "[GazePublisher] socket path too long\n"; return false; }
+    std::memcpy(addr.sun_path, path_.c_str(), path_.size() + 1);
+    std::remove(path_.c_str());   // 이전 실행이 남긴 소켓 파일 정리
+
+    intptr_t fd = (intptr_t)socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) { std::cerr << "[GazePublisher] socket() failed\n"; return false; }
+    if (bind(fd, (const sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 8) != 0) {
+        std::cerr << "[GazePublisher] bind/listen failed: " << path_ << "\n";
+        closeSock(fd);
+        return false;
+    }
+    setNonBlocking(fd);
+    listenFd_ = fd;
+
+    running_.store(true);
+    worker_ = std::thread(&GazePublisher::run, this);
+    return true;
+}
+
+void GazePublisher::stop()
+{
+    if (!running_.exchange(false)) return;
+    if (worker_.joinable()) worker_.join();
+    for (Subscriber& s : subs_) closeSock(s.fd);
+    subs_.clear();
+    nSubs_.store(0);
+    if (listenFd_ >= 0) { closeSock(listenFd_); listenFd_ = -1; }
+    std::remove(path_.c_str());
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+bool GazePublisher::publish(gaze_record r)
+{
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= kQueueCap) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    r.magic = GAZE_STREAM_MAGIC;
+    r.seq = seq_++;
+    r.t_publish_ns = toNs(std::chrono::steady_clock::now());
+    ring_[head & (kQueueCap - 1)] = r;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void GazePublisher::acceptAll()
+{
+    while (true) {
+        intptr_t c = (intptr_t)accept(listenFd_, nullptr, nullptr);
+        if (c < 0) break;
+        setNonBlocking(c);
+        subs_.push_back({ c, {}, false });
+    }
+    nSubs_.store(subs_.size(), std::memory_order_relaxed);
+}
+
+// 밀린 바이트 먼저 보내고, 그 뒤 이번 배치. 다 못 보낸 나머지는 pending에 보관
+void GazePublisher::flushTo(Subscriber& s, const char* data, size_t len)
+{
+    auto sendSome = [&](const char* p, size_t n) -> long {
+        long w = (long)send(s.fd, p, (int)n, MSG_NOSIGNAL);
+        if (w < 0) return wouldBlock() ? 0 : -1;
+        return w;
+    };
+
+    if (!s.pending.empty()) {
+        long w = sendSome(s.pending.data(), s.pending.size());
+        if (w < 0) { s.dead = true; return; }
+        s.pending.erase(s.pending.begin(), s.pending.begin() + w);
+        if (!s.pending.empty()) {
+            s.pending.insert(s.pending.end(), data, data + len);
+            if (s.pending.size() > maxPendingBytes_) s.dead = true;   // 느린 구독자 끊기
+            return;
+        }
+    }
+    if (len == 0) return;
+    long w = sendSome(data, len);
+    if (w < 0) { s.dead = true; return; }
+    if ((size_t)w < len) s.pending.assign(data + w, data + len);
+}
+
+void GazePublisher::run()
+{
+    std::vector<char> batch;
+    batch.reserve(kQueueCap * sizeof(gaze_record));
+
+    while (running_.load()) {
+        // 새 구독자 대기 겸 배치 주기
+        gz_pollfd pfd = {};
+        pfd.fd = (decltype(pfd.fd))listenFd_;
+        pfd.events = POLLIN;
+        if (GZ_POLL(&pfd, 1, (int)batchInterval_.count()) > 0) acceptAll();
+
+        // 큐에 쌓인 레코드를 한 배치로
+        batch.clear();
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            const char* p = (const char*)&ring_[tail & (kQueueCap - 1)];
+            batch.insert(batch.end(), p, p + sizeof(gaze_record));
+        }
+        tail_.store(tail, std::memory_order_release);
+
+        if (subs_.empty()) continue;
+        for (Subscriber& s : subs_) flushTo(s, batch.data(), batch.size());
+
+        // 끊긴 구독자 정리
+        for (size_t i = 0; i < subs_.size();) {
+            if (subs_[i].dead) {
+                closeSock(subs_[i].fd);
+                subs_[i] = std::move(subs_.back());
+                subs_.pop_back();
+            }
+            else ++i;
+        }
+        nSubs_.store(subs_.size(), std::memory_order_relaxed);
+    }
+}
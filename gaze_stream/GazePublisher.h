@@ -0,0 +1,77 @@
+// GazePublisher.h
+// 시선 레코드를 로컬 유닉스 도메인 소켓으로 여러 구독자에게 스트리밍
+#pragma once
+#include "gaze_protocol.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class GazePublisher
+ * @brief 검출 스레드는 publish()로 고정 크기 레코드를 락 없는 큐에 넣기만 하고,
+ * 전송 스레드가 batchInterval마다 큐를 비워 구독자별로 한 번에 send 합니다.
+ * 구독자 소켓은 논블로킹이며, 밀린 데이터가 maxPendingBytes를 넘는 느린 구독자는 끊습니다.
+ * publish()는 단일 생산자 전용입니다 (검출/메인 스레드 하나에서만 호출).
+ */
+class GazePublisher {
+public:
+    explicit GazePublisher(std::string path = GAZE_STREAM_DEFAULT_PATH,
+        std::chrono::milliseconds batchInterval = std::chrono::milliseconds(2),
+        size_t maxPendingBytes = 64 * 1024);
+    ~GazePublisher();
+
+    // 소켓 bind/listen + 전송 스레드 시작 (실패 시 false, 에러는 stderr)
+    bool start();
+    void stop();
+
+    // 절대 블록하지 않음. magic/seq/t_publish_ns는 여기서 채움. 큐가 가득 차면 버리고 false
+    bool publish(gaze_record r);
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    size_t subscribers() const { return nSubs_.load(std::memory_order_relaxed); }
+
+    // steady_clock 시각 -> 프로토콜 ns
+    static uint64_t toNs(std::chrono::steady_clock::time_point t) {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+private:
+    struct Subscriber {
+        intptr_t fd;
+        std::vector<char> pending;   // 아직 못 보낸 바이트 (레코드 경계 유지)
+        bool dead;                   // 오류/지연으로 끊을 구독자
+    };
+
+    void run();
+    void acceptAll();
+    void flushTo(Subscriber& s, const char* data, size_t len);
+
+    std::string path_;
+    std::chrono::milliseconds batchInterval_;
+    size_t maxPendingBytes_;
+
+    // SPSC 링 (용량은 2의 거듭제곱)
+    static constexpr size_t kQueueCap = 4096;
+    std::vector<gaze_record> ring_;
+    std::atomic<size_t> head_{ 0 };   // 생산자 쓰기 위치
+    std::atomic<size_t> tail_{ 0 };   // 소비자 읽기 위치
+    uint32_t seq_ = 0;
+
+    intptr_t listenFd_ = -1;
+    std::vector<Subscriber> subs_;
+    std::atomic<size_t> nSubs_{ 0 };
+    std::atomic<uint64_t> dropped_{ 0 };
+    std::atomic<bool> running_{ false };
+    std::thread worker_;
+};
+
+// 레코드 기본값 채우기 (종류 + 캡처 시각)
+inline gaze_record makeGazeRecord(uint8_t type, std::chrono::steady_clock::time_point captureTime) {
+    gaze_record r = {};
+    r.type = type;
+    r.t_capture_ns = GazePublisher::toNs(captureTime);
+    return r;
+}
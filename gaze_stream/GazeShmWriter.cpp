@@ -0,0 +1,87 @@
+// GazeShmWriter.cpp
+#include "GazeShmWriter.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+GazeShmWriter::GazeShmWriter(std::string name)
+    : name_(std::move(name))
+{
+}
+
+GazeShmWriter::~GazeShmWriter()
+{
+    close();
+}
+
+bool GazeShmWriter::open()
+{
+    if (region_) return true;
+    const size_t size = sizeof(gaze_shm_region);
+#ifdef _WIN32
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, (DWORD)size, name_.c_str());
+    if (!h) { std::cerr << "[GazeShmWriter] CreateFileMapping failed: " << name_ << "\n"; return false; }
+    void* p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!p) { CloseHandle(h); std::cerr << "[GazeShmWriter] MapViewOfFile failed\n"; return false; }
+    mapping_ = h;
+#else
+    int fd = shm_open(name_.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) { std::cerr << "[GazeShmWriter] shm_open failed: " << name_ << "\n"; return false; }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        ::close(fd); std::cerr << "[GazeShmWriter] ftruncate failed\n"; return false;
+    }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) { std::cerr << "[GazeShmWriter] mmap failed\n"; return false; }
+#endif
+    region_ = static_cast<gaze_shm_region*>(p);
+
+    // magic 은 마지막에: reader는 magic이 맞아야 영역을 신뢰
+    std::memset(region_, 0, size);
+    region_->version = GAZE_SHM_VERSION;
+    region_->slots = GAZE_SHM_SLOTS;
+    region_->slot_size = sizeof(gaze_shm_slot);
+    GZ_RELEASE_FENCE();
+    region_->magic = GAZE_SHM_MAGIC;
+    head_ = 0;
+    return true;
+}
+
+void GazeShmWriter::close()
+{
+    if (!region_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(region_);
+    CloseHandle((HANDLE)mapping_);
+    mapping_ = nullptr;
+#else
+    munmap(region_, sizeof(gaze_shm_region));
+    shm_unlink(name_.c_str());
+#endif
+    region_ = nullptr;
+}
+
+void GazeShmWriter::write(const gaze_shm_sample& s)
+{
+    if (!region_) return;
+    gaze_shm_slot& slot = region_->ring[head_ & (GAZE_SHM_SLOTS - 1)];
+    const uint32_t seq = GZ_LOAD32(&slot.seq);
+
+    GZ_STORE32(&slot.seq, seq + 1);     // 홀수: 기록 시작
+    GZ_RELEASE_FENCE();
+    GZ_STORE32(&slot.index, (uint32_t)head_);
+    std::memcpy(&slot.s, &s, sizeof(s));
+    GZ_RELEASE_FENCE();
+    GZ_STORE32(&slot.seq, seq + 2);     // 짝수: 기록 완료
+
+    ++head_;
+    GZ_RELEASE_FENCE();
+    GZ_STORE64(&region_->head, head_);
+}
@@ -0,0 +1,31 @@
+// GazeShmWriter.h
+// 프레임별 시선 샘플을 공유 메모리 seqlock 링에 기록 (단일 writer)
+#pragma once
+#include "gaze_shm.h"
+#include <string>
+
+/**
+ * @class GazeShmWriter
+ * @brief 같은 머신의 소비자(UI 오버레이 등)가 소켓 없이 폴링으로 읽도록
+ * gaze_shm_region 을 만들어 두고 write()마다 다음 슬롯에 기록합니다.
+ * write()는 시스템 콜/락 없이 메모리 복사와 펜스만 수행합니다.
+ */
+class GazeShmWriter {
+public:
+    explicit GazeShmWriter(std::string name = GAZE_SHM_DEFAULT_NAME);
+    ~GazeShmWriter();
+
+    bool open();    // 영역 생성 + 매핑 (실패 시 false, 에러는 stderr)
+    void close();   // 매핑 해제 + 이름 제거
+    bool isOpen() const { return region_ != nullptr; }
+
+    void write(const gaze_shm_sample& s);
+
+private:
+    std::string name_;
+    gaze_shm_region* region_ = nullptr;
+    uint64_t head_ = 0;
+#ifdef _WIN32
+    void* mapping_ = nullptr;
+#endif
+};
@@ -0,0 +1,137 @@
+/* gaze_client.c */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L   /* clock_gettime, CLOCK_MONOTONIC */
+#endif
+#include "gaze_client.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef SOCKET gz_sock;
+#define GZ_BAD_SOCK INVALID_SOCKET
+#define gz_close closesocket
+#define gz_poll WSAPoll
+typedef WSAPOLLFD gz_pollfd;
+#else
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+typedef int gz_sock;
+#define GZ_BAD_SOCK (-1)
+#define gz_close close
+#define gz_poll poll
+typedef struct pollfd gz_pollfd;
+#endif
+
+#define GZ_BUF_RECORDS 256
+
+struct gaze_client {
+    gz_sock fd;
+    unsigned char buf[GZ_BUF_RECORDS * sizeof(gaze_record)];
+    size_t len;             /* buf에 쌓인 바이트 (레코드 경계 미완성 포함) */
+    int have_seq;
+    uint32_t next_seq;
+    uint64_t missed;
+};
+
+uint64_t gaze_now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    /* steady_clock(MSVC)과 같은 변환: 초 단위 + 나머지 */
+    return (uint64_t)(c.QuadPart / freq.QuadPart) * 1000000000ull
+        + (uint64_t)(c.QuadPart % freq.QuadPart) * 1000000000ull / (uint64_t)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+gaze_client* gaze_client_connect(const char* path)
+{
+    struct sockaddr_un addr;
+    gaze_client* c;
+    gz_sock fd;
+
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return NULL;
+#endif
+    if (!path || strlen(path) >= sizeof(addr.sun_path)) return NULL;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == GZ_BAD_SOCK) return NULL;
+    if (connect(fd, (const struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        gz_close(fd);
+        return NULL;
+    }
+
+    c = (gaze_client*)calloc(1, sizeof(gaze_client));
+    if (!c) { gz_close(fd); return NULL; }
+    c->fd = fd;
+    return c;
+}
+
+int gaze_client_read(gaze_client* c, gaze_record* out, int max, int timeout_ms)
+{
+    const size_t rec = sizeof(gaze_record);
+    int n = 0;
+
+    if (!c || !out || max <= 0) return -1;
+
+    /* 버퍼에 완성 레코드가 없을 때만 소켓을 기다림 */
+    if (c->len < rec) {
+        gz_pollfd pfd;
+        long r;
+        memset(&pfd, 0, sizeof(pfd));
+        pfd.fd = c->fd;
+        pfd.events = POLLIN;
+        if (gz_poll(&pfd, 1, timeout_ms) <= 0) return 0;
+        r = (long)recv(c->fd, (char*)c->buf + c->len, (int)(sizeof(c->buf) - c->len), 0);
+        if (r <= 0) return -1;
+        c->len += (size_t)r;
+    }
+
+    while (n < max && c->len >= rec) {
+        gaze_record* dst = &out[n];
+        memcpy(dst, c->buf + (size_t)n * rec, rec);
+        if (dst->magic != GAZE_STREAM_MAGIC) return -1;   /* 스트림 어긋남 */
+        if (c->have_seq && dst->seq != c->next_seq)
+            c->missed += (uint32_t)(dst->seq - c->next_seq);
+        c->next_seq = dst->seq + 1;
+        c->have_seq = 1;
+        ++n;
+        c->len -= rec;
+    }
+    /* 남은(미완성/미소비) 바이트를 앞으로 */
+    if (n > 0 && c->len > 0)
+        memmove(c->buf, c->buf + (size_t)n * rec, c->len);
+    return n;
+}
+
+uint64_t gaze_client_missed(const gaze_client* c)
+{
+    return c ? c->missed : 0;
+}
+
+void gaze_client_close(gaze_client* c)
+{
+    if (!c) return;
+    gz_close(c->fd);
+    free(c);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
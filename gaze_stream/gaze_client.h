@@ -0,0 +1,41 @@
+/* gaze_client.h
+ * 시선 스트림 구독용 최소 C 클라이언트
+ *
+ *   gaze_client* c = gaze_client_connect(GAZE_STREAM_DEFAULT_PATH);
+ *   gaze_record recs[64];
+ *   int n = gaze_client_read(c, recs, 64, 100);   // 최대 100ms 대기
+ *   ...
+ *   gaze_client_close(c);
+ */
+#ifndef GAZE_CLIENT_H
+#define GAZE_CLIENT_H
+
+#include "gaze_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gaze_client gaze_client;
+
+/* 발행자 소켓에 연결. 실패 시 NULL */
+gaze_client* gaze_client_connect(const char* path);
+
+/* 완성된 레코드를 최대 max개 out에 복사.
+ * 반환: 읽은 개수(0 = timeout_ms 동안 없음), -1 = 연결 끊김/오류
+ * timeout_ms < 0 이면 무한 대기 */
+int gaze_client_read(gaze_client* c, gaze_record* out, int max, int timeout_ms);
+
+/* 구독 중 seq 불연속으로 놓친 레코드 수 (느린 구독자 감지용) */
+uint64_t gaze_client_missed(const gaze_client* c);
+
+void gaze_client_close(gaze_client* c);
+
+/* 발행자와 같은 기준의 단조 시계 (ns) */
+uint64_t gaze_now_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GAZE_CLIENT_H */
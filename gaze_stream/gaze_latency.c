@@ -0,0 +1,65 @@
+/* gaze_latency.c
+ * 시선 스트림 지연 측정 도구
+ *   gaze_latency [소켓경로] [샘플수]
+ * 레코드마다 (수신 시각 - 캡처 시각), (수신 시각 - 발행 시각)을 재서 분포를 출력.
+ * 캡처->수신은 검출+발행+전송 전체, 발행->수신은 배치/소켓 구간만.
+ */
+#include "gaze_client.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static int cmp_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* name, uint64_t* v, int n)
+{
+    qsort(v, (size_t)n, sizeof(uint64_t), cmp_u64);
+    printf("%-18s min %8.3f  p50 %8.3f  p95 %8.3f  p99 %8.3f  max %8.3f ms\n", name,
+        v[0] / 1e6, v[n / 2] / 1e6, v[(int)(n * 0.95)] / 1e6, v[(int)(n * 0.99)] / 1e6, v[n - 1] / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = argc > 1 ? argv[1] : GAZE_STREAM_DEFAULT_PATH;
+    int want = argc > 2 ? atoi(argv[2]) : 1000;
+    gaze_client* c;
+    uint64_t* capLat;
+    uint64_t* pubLat;
+    gaze_record recs[64];
+    int got = 0, events = 0;
+
+    if (want <= 0) want = 1000;
+    c = gaze_client_connect(path);
+    if (!c) { fprintf(stderr, "connect failed: %s\n", path); return 1; }
+
+    capLat = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)want);
+    pubLat = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)want);
+    if (!capLat || !pubLat) { gaze_client_close(c); return 1; }
+
+    while (got < want) {
+        int i, n = gaze_client_read(c, recs, 64, 2000);
+        uint64_t now = gaze_now_ns();
+        if (n < 0) { fprintf(stderr, "stream closed\n"); break; }
+        if (n == 0) { fprintf(stderr, "no data for 2s\n"); continue; }
+        for (i = 0; i < n && got < want; ++i) {
+            if (recs[i].type != GAZE_REC_SAMPLE) { ++events; continue; }
+            capLat[got] = now - recs[i].t_capture_ns;
+            pubLat[got] = now - recs[i].t_publish_ns;
+            ++got;
+        }
+    }
+
+    if (got > 0) {
+        printf("samples %d, events %d, missed %llu\n", got, events,
+            (unsigned long long)gaze_client_missed(c));
+        report("capture->receive", capLat, got);
+        report("publish->receive", pubLat, got);
+    }
+    free(capLat);
+    free(pubLat);
+    gaze_client_close(c);
+    return got > 0 ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+/* gaze_protocol.h
+ * 시선 스트림 바이너리 프로토콜 (C/C++ 공용)
+ * - 로컬 소켓(유닉스 도메인)으로 고정 크기 gaze_record 를 연속 전송
+ * - 리틀엔디언, 패딩 없는 48바이트 레코드, 헤더/길이 필드 없음
+ * - 시각은 단조 시계(ns): Linux CLOCK_MONOTONIC, Windows QueryPerformanceCounter
+ *   (C++ std::chrono::steady_clock 과 같은 기준이라 프로세스 간 비교 가능)
+ */
+#ifndef GAZE_PROTOCOL_H
+#define GAZE_PROTOCOL_H
+
+#include <stdint.h>
+
+#define GAZE_STREAM_MAGIC   0x475Au   /* 'G''Z' */
+#define GAZE_STREAM_VERSION 1
+
+#ifdef _WIN32
+#define GAZE_STREAM_DEFAULT_PATH "gaze_stream.sock"
+#else
+#define GAZE_STREAM_DEFAULT_PATH "/tmp/gaze_stream.sock"
+#endif
+
+/* 레코드 종류 */
+enum gaze_record_type {
+    GAZE_REC_SAMPLE = 1,          /* 프레임별 시선 샘플 */
+    GAZE_REC_FIXATION_START = 2,  /* 응시 시작 (x,y = 응시 중심) */
+    GAZE_REC_FIXATION_END = 3,    /* 응시 끝 (code = 지속 시간 ms) */
+    GAZE_REC_BLINK = 4,           /* 깜빡임 클릭 (code = gaze_eye) */
+    GAZE_REC_DIRECTION = 5        /* 방향 라벨 변경 (code = gaze_direction) */
+};
+
+/* flags 비트 */
+enum gaze_record_flags {
+    GAZE_FLAG_LEFT_SEEN = 1 << 0,
+    GAZE_FLAG_RIGHT_SEEN = 1 << 1,
+    GAZE_FLAG_MAPPED = 1 << 2,    /* sx, sy 유효 (캘리브 완료) */
+    GAZE_FLAG_VALID = 1 << 3      /* x, y 유효 (이번 프레임 시선 검출) */
+};
+
+enum gaze_eye { GAZE_EYE_LEFT = 0, GAZE_EYE_RIGHT = 1 };
+
+/* 5/9방향 라벨 (main_LRUD). --zones 설정이면 영역 id, 어느 영역도 아니면 GAZE_DIR_NONE */
+enum gaze_direction {
+    GAZE_DIR_NONE = -1,
+    GAZE_DIR_CENTER = 0,
+    GAZE_DIR_LEFT, GAZE_DIR_RIGHT, GAZE_DIR_UP, GAZE_DIR_DOWN,
+    GAZE_DIR_LEFT_UP, GAZE_DIR_LEFT_DOWN, GAZE_DIR_RIGHT_UP, GAZE_DIR_RIGHT_DOWN,
+    GAZE_DIR_SEARCHING, GAZE_DIR_NO_FACE
+};
+
+#pragma pack(push, 1)
+typedef struct gaze_record {
+    uint16_t magic;         /* GAZE_STREAM_MAGIC */
+    uint8_t  type;          /* gaze_record_type */
+    uint8_t  flags;         /* gaze_record_flags */
+    uint32_t seq;           /* 발행 순번 (구독자가 누락 감지) */
+    uint64_t t_capture_ns;  /* 프레임 캡처 시각 */
+    uint64_t t_publish_ns;  /* 발행 큐에 넣은 시각 */
+    float    x, y;          /* 정규화 시선 (emaX, emaY) */
+    float    sx, sy;        /* 화면 좌표 px (GAZE_FLAG_MAPPED일 때) */
+    int32_t  code;          /* 종류별 부가 값 */
+    uint32_t reserved;
+} gaze_record;
+#pragma pack(pop)
+
+#ifdef __cplusplus
+static_assert(sizeof(gaze_record) == 48, "gaze_record must be 48 bytes");
+#else
+_Static_assert(sizeof(gaze_record) == 48, "gaze_record must be 48 bytes");
+#endif
+
+#endif /* GAZE_PROTOCOL_H */
@@ -0,0 +1,106 @@
+/* gaze_shm.h
+ * 공유 메모리 시선 링 (C/C++ 공용, 단일 writer / 다수 reader)
+ * - POSIX shm_open (Windows는 이름 있는 파일 매핑)
+ * - 슬롯마다 seqlock: writer가 seq를 홀수로 -> 데이터 기록 -> 짝수로.
+ *   reader는 seq가 짝수이고 복사 전후 같을 때만 채택 (락 없음, writer를 절대 막지 않음)
+ * - 슬롯에 샘플 번호(하위 32비트)도 같이 기록: reader가 기대한 번호와 다르면 그 사이 writer가 링을 한 바퀴 돈 것
+ * - head = 지금까지 기록한 샘플 수, 최신 샘플은 ring[(head-1) % GAZE_SHM_SLOTS]
+ */
+#ifndef GAZE_SHM_H
+#define GAZE_SHM_H
+
+#include <stdint.h>
+#include "gaze_protocol.h"
+
+#define GAZE_SHM_MAGIC   0x475A534Du   /* 'GZSM' */
+#define GAZE_SHM_VERSION 2
+#define GAZE_SHM_SLOTS   256           /* 2의 거듭제곱 */
+
+#ifdef _WIN32
+#define GAZE_SHM_DEFAULT_NAME "Local\\gaze_shm"
+#else
+#define GAZE_SHM_DEFAULT_NAME "/gaze_shm"
+#endif
+
+/* blink 비트 */
+enum gaze_shm_blink {
+    GAZE_BLINK_LEFT_CLOSED = 1 << 0,   /* 왼쪽 눈만 안 보이는 중 */
+    GAZE_BLINK_RIGHT_CLOSED = 1 << 1,
+    GAZE_BLINK_LEFT_CLICK = 1 << 2,    /* 이번 프레임 좌클릭 발생 */
+    GAZE_BLINK_RIGHT_CLICK = 1 << 3
+};
+
+typedef struct gaze_shm_sample {
+    uint64_t t_capture_ns;          /* 캡처 시각 (gaze_protocol.h 와 같은 단조 시계) */
+    float left_nx, left_ny;         /* 왼쪽 눈 원시 시선 */
+    float right_nx, right_ny;       /* 오른쪽 눈 원시 시선 */
+    float ema_x, ema_y;             /* 필터된 시선 (emaX, emaY) */
+    float screen_x, screen_y;       /* 매핑된 화면 좌표 (emaSX, emaSY) */
+    uint32_t flags;                 /* GAZE_FLAG_* */
+    uint32_t blink;                 /* gaze_shm_blink */
+} gaze_shm_sample;
+
+typedef struct gaze_shm_slot {
+    uint32_t seq;                   /* 홀수 = 기록 중 */
+    uint32_t index;                 /* 이 슬롯에 든 샘플 번호 (head 기준, 하위 32비트) */
+    gaze_shm_sample s;
+} gaze_shm_slot;
+
+typedef struct gaze_shm_region {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slots;
+    uint32_t slot_size;
+    uint64_t head;                  /* 기록된 샘플 총수 */
+    uint8_t  pad[40];               /* head 를 슬롯들과 다른 캐시 라인에 */
+    gaze_shm_slot ring[GAZE_SHM_SLOTS];
+} gaze_shm_region;
+
+/* --- seqlock 원자 연산 (writer/reader 공용) --- */
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#if defined(_M_ARM64) || defined(_M_ARM)
+#define GZ_ACQUIRE_FENCE() __dmb(0xB)
+#define GZ_RELEASE_FENCE() __dmb(0xB)
+#else
+#define GZ_ACQUIRE_FENCE() _ReadWriteBarrier()   /* x86: 하드웨어가 load/store 순서 보장 */
+#define GZ_RELEASE_FENCE() _ReadWriteBarrier()
+#endif
+#define GZ_LOAD32(p)  (*(volatile const uint32_t*)(p))
+#define GZ_STORE32(p, v) (*(volatile uint32_t*)(p) = (v))
+#define GZ_LOAD64(p)  ((uint64_t)__iso_volatile_load64((const volatile __int64*)(p)))
+#define GZ_STORE64(p, v) __iso_volatile_store64((volatile __int64*)(p), (__int64)(v))
+#else
+#define GZ_ACQUIRE_FENCE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define GZ_RELEASE_FENCE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define GZ_LOAD32(p)  __atomic_load_n((p), __ATOMIC_RELAXED)
+#define GZ_STORE32(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define GZ_LOAD64(p)  __atomic_load_n((p), __ATOMIC_RELAXED)
+#define GZ_STORE64(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#endif
+
+/* --- reader API (gaze_shm_reader.c) --- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gaze_shm_reader gaze_shm_reader;
+
+/* 읽기 전용으로 매핑. writer가 아직 없으면 NULL */
+gaze_shm_reader* gaze_shm_open(const char* name);
+
+/* 최신 샘플 복사. 반환: 1 = 새 샘플, 0 = 지난 호출 이후 새 것 없음(또는 기록 중 충돌), -1 = 오류 */
+int gaze_shm_read_latest(gaze_shm_reader* r, gaze_shm_sample* out);
+
+/* *cursor 이후 샘플을 순서대로 최대 max개. 반환: 개수.
+ * 링이 한 바퀴 넘게 앞서가면(읽는 도중 포함) 놓친 만큼 *cursor를 당기고 overrun에 더함.
+ * head < *cursor(writer 재시작)면 *cursor를 새 링 기준으로 다시 맞춤 (overrun에는 안 더함) */
+int gaze_shm_read_since(gaze_shm_reader* r, uint64_t* cursor, gaze_shm_sample* out, int max, uint64_t* overrun);
+
+void gaze_shm_close(gaze_shm_reader* r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GAZE_SHM_H */
@@ -0,0 +1,141 @@
+/* gaze_shm_reader.c */
+#include "gaze_shm.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+struct gaze_shm_reader {
+    const gaze_shm_region* region;
+    uint64_t last_head;     /* read_latest 가 마지막으로 돌려준 head */
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+};
+
+gaze_shm_reader* gaze_shm_open(const char* name)
+{
+    gaze_shm_reader* r;
+    const gaze_shm_region* region;
+#ifdef _WIN32
+    HANDLE h = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+    if (!h) return NULL;
+    region = (const gaze_shm_region*)MapViewOfFile(h, FILE_MAP_READ, 0, 0, sizeof(gaze_shm_region));
+    if (!region) { CloseHandle(h); return NULL; }
+#else
+    void* p;
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+    p = mmap(NULL, sizeof(gaze_shm_region), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return NULL;
+    region = (const gaze_shm_region*)p;
+#endif
+
+    if (region->magic != GAZE_SHM_MAGIC || region->version != GAZE_SHM_VERSION
+        || region->slots != GAZE_SHM_SLOTS || region->slot_size != sizeof(gaze_shm_slot)) {
+#ifdef _WIN32
+        UnmapViewOfFile(region); CloseHandle(h);
+#else
+        munmap((void*)region, sizeof(gaze_shm_region));
+#endif
+        return NULL;
+    }
+
+    r = (gaze_shm_reader*)calloc(1, sizeof(gaze_shm_reader));
+    if (!r) return NULL;
+    r->region = region;
+#ifdef _WIN32
+    r->mapping = h;
+#endif
+    return r;
+}
+
+/* 슬롯 하나를 seqlock 규칙으로 복사. 슬롯이 샘플 index를 담고 있을 때만 성공(1) */
+static int read_slot(const gaze_shm_slot* slot, uint64_t index, gaze_shm_sample* out)
+{
+    int tries;
+    for (tries = 0; tries < 4; ++tries) {
+        uint32_t s1 = GZ_LOAD32(&slot->seq), idx;
+        if (s1 & 1u) continue;              /* 기록 중 */
+        GZ_ACQUIRE_FENCE();
+        idx = GZ_LOAD32(&slot->index);
+        memcpy(out, &slot->s, sizeof(*out));
+        GZ_ACQUIRE_FENCE();
+        if (GZ_LOAD32(&slot->seq) != s1) continue;
+        return idx == (uint32_t)index;      /* 다르면 이미 다음 바퀴 샘플로 덮임 */
+    }
+    return 0;
+}
+
+int gaze_shm_read_latest(gaze_shm_reader* r, gaze_shm_sample* out)
+{
+    uint64_t head;
+    if (!r || !out) return -1;
+    head = GZ_LOAD64(&r->region->head);
+    GZ_ACQUIRE_FENCE();
+    if (head < r->last_head) r->last_head = 0;   /* writer 재시작 */
+    if (head == 0 || head == r->last_head) return 0;
+    if (!read_slot(&r->region->ring[(head - 1) & (GAZE_SHM_SLOTS - 1)], head - 1, out)) return 0;
+    r->last_head = head;
+    return 1;
+}
+
+/* 링 한 바퀴(한 슬롯 여유) 이상 밀렸으면 가장 오래된 유효 샘플로 이동 */
+static void skip_overrun(uint64_t head, uint64_t* cursor, uint64_t* overrun)
+{
+    if (head - *cursor > GAZE_SHM_SLOTS - 1) {
+        uint64_t skip = head - (GAZE_SHM_SLOTS - 1) - *cursor;
+        if (overrun) *overrun += skip;
+        *cursor += skip;
+    }
+}
+
+int gaze_shm_read_since(gaze_shm_reader* r, uint64_t* cursor, gaze_shm_sample* out, int max, uint64_t* overrun)
+{
+    uint64_t head;
+    int n = 0;
+    if (!r || !cursor || !out || max <= 0) return -1;
+    head = GZ_LOAD64(&r->region->head);
+    GZ_ACQUIRE_FENCE();
+
+    /* writer가 재시작해 head가 0부터 다시 셈: 새 링의 처음부터 (새 writer의 샘플은 놓친 게 아님) */
+    if (head < *cursor) *cursor = 0;
+    skip_overrun(head, cursor, overrun);
+    while (*cursor < head && n < max) {
+        if (read_slot(&r->region->ring[*cursor & (GAZE_SHM_SLOTS - 1)], *cursor, &out[n])) {
+            ++n;
+            ++*cursor;
+            continue;
+        }
+        /* 읽는 사이 writer가 이 슬롯을 덮어씀(또는 덮는 중) -> head를 다시 읽고 남은 가장 오래된 샘플로 */
+        head = GZ_LOAD64(&r->region->head);
+        GZ_ACQUIRE_FENCE();
+        if (head < *cursor) *cursor = 0;
+        else if (head - *cursor > GAZE_SHM_SLOTS - 1) skip_overrun(head, cursor, overrun);
+        else {
+            /* 재시도까지 실패했지만 아직 밀리진 않음: 이 샘플 하나만 놓친 것으로 */
+            if (overrun) *overrun += 1;
+            ++*cursor;
+        }
+    }
+    return n;
+}
+
+void gaze_shm_close(gaze_shm_reader* r)
+{
+    if (!r) return;
+#ifdef _WIN32
+    UnmapViewOfFile(r->region);
+    CloseHandle(r->mapping);
+#else
+    munmap((void*)r->region, sizeof(gaze_shm_region));
+#endif
+    free(r);
+}